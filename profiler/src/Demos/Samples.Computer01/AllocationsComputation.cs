@@ -0,0 +1,128 @@
+// <copyright file="AllocationsComputation.cs" company="Datadog">
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+// </copyright>
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace Samples.Computer01
+{
+    // Allocation heavy workload used to measure the overhead of the allocation profiler:
+    // compare the reported throughput with DD_PROFILING_ALLOCATION_ENABLED set to 0 and 1
+    public class AllocationsComputation
+    {
+        private const int AllocationsPerIteration = 10_000_000;
+
+        private readonly int _nbThreads;
+        private ManualResetEvent _stopEvent;
+        private List<Task> _activeTasks;
+
+        public AllocationsComputation(int nbThreads)
+        {
+            _nbThreads = nbThreads;
+        }
+
+        public void Start()
+        {
+            if (_stopEvent != null)
+            {
+                throw new InvalidOperationException("Already running...");
+            }
+
+            _stopEvent = new ManualResetEvent(false);
+            _activeTasks = CreateThreads();
+        }
+
+        public void Run()
+        {
+            _stopEvent = new ManualResetEvent(false);
+
+            DoAllocations();
+
+            _stopEvent.Dispose();
+            _stopEvent = null;
+        }
+
+        public void Stop()
+        {
+            if (_stopEvent == null)
+            {
+                throw new InvalidOperationException("Not running...");
+            }
+
+            _stopEvent.Set();
+
+            Task.WhenAll(_activeTasks).Wait();
+
+            _stopEvent.Dispose();
+            _stopEvent = null;
+            _activeTasks = null;
+        }
+
+        public long DoAllocations()
+        {
+            Console.WriteLine($"Starting {nameof(DoAllocations)}.");
+
+            var sw = Stopwatch.StartNew();
+            long totalSize = 0;
+            int count = 0;
+            for (; count < AllocationsPerIteration; count++)
+            {
+                if ((count % 100_000 == 0) && IsEventSet())
+                {
+                    break;
+                }
+
+                totalSize += AllocateArray(count).Length;
+                totalSize += AllocateString(count).Length;
+            }
+
+            sw.Stop();
+            Console.WriteLine($"  Allocations: {count * 2} objects ({totalSize} elements) in {sw.Elapsed} = {count * 2 / sw.Elapsed.TotalSeconds:0} allocations/s");
+            Console.WriteLine($"Exiting {nameof(DoAllocations)}.");
+            Console.WriteLine();
+
+            return totalSize;
+        }
+
+        private static byte[] AllocateArray(int count)
+        {
+            return new byte[16 + (count % 1024)];
+        }
+
+        private static string AllocateString(int count)
+        {
+            return count.ToString();
+        }
+
+        private List<Task> CreateThreads()
+        {
+            var result = new List<Task>(_nbThreads);
+
+            for (var i = 0; i < _nbThreads; i++)
+            {
+                result.Add(
+                    Task.Factory.StartNew(
+                        () =>
+                        {
+                            while (!IsEventSet())
+                            {
+                                DoAllocations();
+                            }
+                        },
+                        TaskCreationOptions.LongRunning));
+            }
+
+            return result;
+        }
+
+        private bool IsEventSet()
+        {
+            return _stopEvent.WaitOne(0);
+        }
+    }
+}
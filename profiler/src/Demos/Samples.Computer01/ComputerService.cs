@@ -26,6 +26,9 @@ namespace Samples.Computer01
         private SleepManager _sleepManager;
         private AsyncComputation _asyncComputation;
         private IteratorComputation _iteratorComputation;
+        private AllocationsComputation _allocationsComputation;
+        private LockContention _lockContention;
+        private ThreadStates _threadStates;
 
         public void StartService(Scenario scenario, int nbThreads)
         {
@@ -77,6 +80,18 @@ namespace Samples.Computer01
                     StartIteratorComputation(nbThreads);
                     break;
 
+                case Scenario.Allocations:
+                    StartAllocationsComputation(nbThreads);
+                    break;
+
+                case Scenario.LockContention:
+                    StartLockContention(nbThreads);
+                    break;
+
+                case Scenario.ThreadStates:
+                    StartThreadStates();
+                    break;
+
                 default:
                     throw new ArgumentOutOfRangeException(nameof(scenario), $"Unsupported scenario #{_scenario}");
             }
@@ -126,6 +141,18 @@ namespace Samples.Computer01
                 case Scenario.Iterator:
                     StopIteratorComputation();
                     break;
+
+                case Scenario.Allocations:
+                    StopAllocationsComputation();
+                    break;
+
+                case Scenario.LockContention:
+                    StopLockContention();
+                    break;
+
+                case Scenario.ThreadStates:
+                    StopThreadStates();
+                    break;
             }
         }
 
@@ -179,6 +206,18 @@ namespace Samples.Computer01
                         RunIteratorComputation(nbThreads);
                         break;
 
+                    case Scenario.Allocations:
+                        RunAllocationsComputation(nbThreads);
+                        break;
+
+                    case Scenario.LockContention:
+                        RunLockContention(nbThreads);
+                        break;
+
+                    case Scenario.ThreadStates:
+                        RunThreadStates();
+                        break;
+
                     default:
                         throw new ArgumentOutOfRangeException(nameof(scenario), $"Unsupported scenario #{_scenario}");
                 }
@@ -243,6 +282,24 @@ namespace Samples.Computer01
             _iteratorComputation.Start();
         }
 
+        private void StartAllocationsComputation(int nbThreads)
+        {
+            _allocationsComputation = new AllocationsComputation(nbThreads);
+            _allocationsComputation.Start();
+        }
+
+        private void StartLockContention(int nbThreads)
+        {
+            _lockContention = new LockContention(nbThreads);
+            _lockContention.Start();
+        }
+
+        private void StartThreadStates()
+        {
+            _threadStates = new ThreadStates();
+            _threadStates.Start();
+        }
+
         private void StopComputer()
         {
             using (_computer)
@@ -297,6 +354,21 @@ namespace Samples.Computer01
             _iteratorComputation.Stop();
         }
 
+        private void StopAllocationsComputation()
+        {
+            _allocationsComputation.Stop();
+        }
+
+        private void StopLockContention()
+        {
+            _lockContention.Stop();
+        }
+
+        private void StopThreadStates()
+        {
+            _threadStates.Stop();
+        }
+
         private void RunComputer()
         {
             using (var computer = new Computer<byte, KeyValuePair<char, KeyValuePair<int, KeyValuePair<float, object>>>>())
@@ -347,6 +419,24 @@ namespace Samples.Computer01
             computation.Run();
         }
 
+        private void RunAllocationsComputation(int nbThreads)
+        {
+            var computation = new AllocationsComputation(nbThreads);
+            computation.Run();
+        }
+
+        private void RunLockContention(int nbThreads)
+        {
+            var lockContention = new LockContention(nbThreads);
+            lockContention.Run();
+        }
+
+        private void RunThreadStates()
+        {
+            var threadStates = new ThreadStates();
+            threadStates.Run();
+        }
+
         public class MySpecialClassA
         {
         }
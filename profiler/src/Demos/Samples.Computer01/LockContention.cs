@@ -0,0 +1,128 @@
+// <copyright file="LockContention.cs" company="Datadog">
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+// </copyright>
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace Samples.Computer01
+{
+    // n threads competing for the same lock: each one holds it for a short duration
+    // so that most Monitor.Enter calls end up waiting (i.e. ContentionStart/ContentionStop events)
+    public class LockContention
+    {
+        private const int AcquisitionsPerIteration = 10_000;
+
+        private readonly object _lock = new object();
+        private readonly int _nbThreads;
+        private ManualResetEvent _stopEvent;
+        private List<Task> _activeTasks;
+        private long _counter;
+
+        public LockContention(int nbThreads)
+        {
+            _nbThreads = Math.Max(nbThreads, 2);
+        }
+
+        public void Start()
+        {
+            if (_stopEvent != null)
+            {
+                throw new InvalidOperationException("Already running...");
+            }
+
+            _stopEvent = new ManualResetEvent(false);
+            _activeTasks = CreateThreads();
+        }
+
+        public void Run()
+        {
+            _stopEvent = new ManualResetEvent(false);
+
+            var tasks = CreateThreads(runOnce: true);
+            Task.WhenAll(tasks).Wait();
+
+            _stopEvent.Dispose();
+            _stopEvent = null;
+        }
+
+        public void Stop()
+        {
+            if (_stopEvent == null)
+            {
+                throw new InvalidOperationException("Not running...");
+            }
+
+            _stopEvent.Set();
+
+            Task.WhenAll(_activeTasks).Wait();
+
+            _stopEvent.Dispose();
+            _stopEvent = null;
+            _activeTasks = null;
+        }
+
+        private void DoContention()
+        {
+            var sw = Stopwatch.StartNew();
+            int count = 0;
+            for (; count < AcquisitionsPerIteration; count++)
+            {
+                if ((count % 100 == 0) && IsEventSet())
+                {
+                    break;
+                }
+
+                AcquireLock();
+            }
+
+            sw.Stop();
+            Console.WriteLine($"  LockContention: {count} acquisitions in {sw.Elapsed} = {count / sw.Elapsed.TotalSeconds:0} acquisitions/s on thread #{Thread.CurrentThread.ManagedThreadId}");
+        }
+
+        private void AcquireLock()
+        {
+            lock (_lock)
+            {
+                _counter++;
+
+                // keep the lock long enough for the other threads to wait
+                var sw = Stopwatch.StartNew();
+                while (sw.ElapsedTicks < Stopwatch.Frequency / 20_000)
+                {
+                }
+            }
+        }
+
+        private List<Task> CreateThreads(bool runOnce = false)
+        {
+            var result = new List<Task>(_nbThreads);
+
+            for (var i = 0; i < _nbThreads; i++)
+            {
+                result.Add(
+                    Task.Factory.StartNew(
+                        () =>
+                        {
+                            do
+                            {
+                                DoContention();
+                            }
+                            while (!runOnce && !IsEventSet());
+                        },
+                        TaskCreationOptions.LongRunning));
+            }
+
+            return result;
+        }
+
+        private bool IsEventSet()
+        {
+            return _stopEvent.WaitOne(0);
+        }
+    }
+}
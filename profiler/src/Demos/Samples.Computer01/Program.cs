@@ -21,7 +21,10 @@ namespace Samples.Computer01
         FibonacciComputation,
         Sleep,
         Async,
-        Iterator
+        Iterator,
+        Allocations,
+        LockContention,
+        ThreadStates
     }
 
     public class Program
@@ -40,6 +43,9 @@ namespace Samples.Computer01
             // 6: start n threads sleeping
             // 7: start n threads doing async calls with CPU consumption along the way
             // 8: start n threads doing iterator calls in constructors
+            // 9: start n threads allocating arrays and strings
+            // 10: start n threads competing for the same lock
+            // 11: start threads named after the scheduler state they spend most of their time in
             Console.WriteLine($"{Environment.NewLine}Usage:{Environment.NewLine} > {Process.GetCurrentProcess().ProcessName} [--service] [--iterations <number of iterations to execute>] [--scenario <0=all 1=computer 2=generics 3=wall time 4=pi computation>] [--timeout <duration in seconds> | --run-infinitely]");
             Console.WriteLine();
 
@@ -0,0 +1,172 @@
+// <copyright file="ThreadStates.cs" company="Datadog">
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+// </copyright>
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Threading;
+
+namespace Samples.Computer01
+{
+    // one named thread per scheduler state so that the "thread state" label of the wall time samples
+    // can be checked per thread name:
+    //  - Running:  spins on the CPU
+    //  - Runnable: more spinning threads than cores so that some of them are waiting for a CPU (Windows only)
+    //  - IoWait:   synchronous writes flushed to disk
+    //  - Sleeping: Thread.Sleep
+    //  - LockWait: blocked on a lock held by another thread
+    public class ThreadStates
+    {
+        private const int IterationDurationMs = 5000;
+
+        private readonly object _lock = new object();
+        private ManualResetEvent _stopEvent;
+        private List<Thread> _activeThreads;
+
+        public void Start()
+        {
+            if (_stopEvent != null)
+            {
+                throw new InvalidOperationException("Already running...");
+            }
+
+            _stopEvent = new ManualResetEvent(false);
+            _activeThreads = CreateThreads(runOnce: false);
+        }
+
+        public void Run()
+        {
+            _stopEvent = new ManualResetEvent(false);
+
+            var threads = CreateThreads(runOnce: true);
+            foreach (var thread in threads)
+            {
+                thread.Join();
+            }
+
+            _stopEvent.Dispose();
+            _stopEvent = null;
+        }
+
+        public void Stop()
+        {
+            if (_stopEvent == null)
+            {
+                throw new InvalidOperationException("Not running...");
+            }
+
+            _stopEvent.Set();
+
+            foreach (var thread in _activeThreads)
+            {
+                thread.Join();
+            }
+
+            _stopEvent.Dispose();
+            _stopEvent = null;
+            _activeThreads = null;
+        }
+
+        private List<Thread> CreateThreads(bool runOnce)
+        {
+            var result = new List<Thread>();
+
+            result.Add(StartThread("Running", runOnce, Spin));
+            for (var i = 0; i < Environment.ProcessorCount * 2; i++)
+            {
+                result.Add(StartThread($"Runnable #{i}", runOnce, Spin));
+            }
+
+            result.Add(StartThread("IoWait", runOnce, WriteToDisk));
+            result.Add(StartThread("Sleeping", runOnce, Sleep));
+
+            // the lock owner sleeps while holding the lock
+            result.Add(StartThread("LockOwner", runOnce, HoldLock));
+            result.Add(StartThread("LockWait", runOnce, WaitForLock));
+
+            return result;
+        }
+
+        private Thread StartThread(string name, bool runOnce, Action<Stopwatch> action)
+        {
+            var thread = new Thread(() =>
+            {
+                do
+                {
+                    var sw = Stopwatch.StartNew();
+                    while (sw.ElapsedMilliseconds < IterationDurationMs && !IsEventSet())
+                    {
+                        action(sw);
+                    }
+                }
+                while (!runOnce && !IsEventSet());
+            });
+
+            thread.Name = name;
+            thread.IsBackground = true;
+            thread.Start();
+            return thread;
+        }
+
+        private void Spin(Stopwatch sw)
+        {
+            var end = sw.ElapsedMilliseconds + 100;
+            while (sw.ElapsedMilliseconds < end)
+            {
+            }
+        }
+
+        private void WriteToDisk(Stopwatch sw)
+        {
+            var path = Path.Combine(Path.GetTempPath(), $"ThreadStates-{Process.GetCurrentProcess().Id}.tmp");
+            var buffer = new byte[1024 * 1024];
+
+            try
+            {
+                using (var file = new FileStream(path, FileMode.Create, FileAccess.Write, FileShare.None, 4096, FileOptions.WriteThrough))
+                {
+                    for (int i = 0; i < 16; i++)
+                    {
+                        file.Write(buffer, 0, buffer.Length);
+                        file.Flush(flushToDisk: true);
+                    }
+                }
+            }
+            finally
+            {
+                File.Delete(path);
+            }
+        }
+
+        private void Sleep(Stopwatch sw)
+        {
+            Thread.Sleep(100);
+        }
+
+        private void HoldLock(Stopwatch sw)
+        {
+            lock (_lock)
+            {
+                Thread.Sleep(500);
+            }
+
+            // give the waiting thread a chance to acquire the lock
+            Thread.Sleep(1);
+        }
+
+        private void WaitForLock(Stopwatch sw)
+        {
+            lock (_lock)
+            {
+            }
+        }
+
+        private bool IsEventSet()
+        {
+            return _stopEvent.WaitOne(0);
+        }
+    }
+}
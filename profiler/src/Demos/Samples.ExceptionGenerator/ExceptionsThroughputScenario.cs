@@ -0,0 +1,88 @@
+// <copyright file="ExceptionsThroughputScenario.cs" company="Datadog">
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+// </copyright>
+
+using System;
+using System.Diagnostics;
+using System.Runtime.CompilerServices;
+using System.Threading;
+
+namespace Samples.ExceptionGenerator
+{
+    // Benchmark of the cost of exceptions when the exceptions profiler is enabled:
+    // compare the reported throughput and time per exception with and without DD_PROFILING_EXCEPTION_ENABLED
+    // (the debug log of the profiler also lists the stack frames collectors that had to be created).
+    // Most exceptions are not sampled so this mainly measures the cost of the sampling decision under contention.
+    internal class ExceptionsThroughputScenario
+    {
+        private const int NumberOfThreads = 32;
+        private const int ExceptionsPerThread = 50_000;
+        private const int StackDepth = 20;
+
+        public void Run()
+        {
+            // warm up to exclude JIT compilation from the measure
+            ThrowExceptions(1_000);
+
+            var barrier = new Barrier(NumberOfThreads + 1);
+            var threads = new Thread[NumberOfThreads];
+
+            using (ExecutionContext.SuppressFlow())
+            {
+                for (int i = 0; i < threads.Length; i++)
+                {
+                    threads[i] = new Thread(() =>
+                    {
+                        barrier.SignalAndWait();
+                        ThrowExceptions(ExceptionsPerThread);
+                    });
+                    threads[i].Start();
+                }
+            }
+
+            barrier.SignalAndWait();
+            var stopwatch = Stopwatch.StartNew();
+
+            foreach (var thread in threads)
+            {
+                thread.Join();
+            }
+
+            stopwatch.Stop();
+
+            var totalExceptions = NumberOfThreads * ExceptionsPerThread;
+            var nsPerException = stopwatch.Elapsed.TotalMilliseconds * 1_000_000 / totalExceptions;
+            var exceptionsPerSecond = totalExceptions / stopwatch.Elapsed.TotalSeconds;
+            Console.WriteLine($" ########### {totalExceptions} exceptions thrown by {NumberOfThreads} threads in {stopwatch.ElapsedMilliseconds} ms");
+            Console.WriteLine($" ########### {exceptionsPerSecond:F0} exceptions/s ({nsPerException:F0} ns per exception)");
+        }
+
+        private static void ThrowExceptions(int count)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                try
+                {
+                    // alternate exception types to avoid measuring only the fast "already seen" path of the sampler
+                    Recurse(StackDepth, (i & 1) == 0 ? new InvalidOperationException("IOE") : new ArgumentException("AE"));
+                }
+                catch
+                {
+                    // ignored
+                }
+            }
+        }
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        private static void Recurse(int depth, Exception ex)
+        {
+            if (depth == 0)
+            {
+                throw ex;
+            }
+
+            Recurse(depth - 1, ex);
+        }
+    }
+}
@@ -14,7 +14,8 @@ namespace Samples.ExceptionGenerator
     {
         ExceptionsProfilerTest = 1,
         ParallelExceptions = 2,
-        Sampling = 3
+        Sampling = 3,
+        Throughput = 4
     }
 
     public class Program
@@ -65,6 +66,10 @@ namespace Samples.ExceptionGenerator
                             Thread.Sleep(20_000);
                             break;
 
+                        case Scenario.Throughput:
+                            new ExceptionsThroughputScenario().Run();
+                            break;
+
                         default:
                             Console.WriteLine($" ########### Unknown scenario: {scenario}.");
                             break;
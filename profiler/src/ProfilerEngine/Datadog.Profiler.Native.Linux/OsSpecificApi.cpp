@@ -3,7 +3,11 @@
 
 // OsSpecificApi for LINUX
 
+#include <dirent.h>
+#include <signal.h>
 #include <sys/syscall.h>
+#include <fstream>
+#include <string>
 #include "OsSpecificApi.h"
 
 #include "LinuxStackFramesCollector.h"
@@ -98,4 +102,135 @@ bool IsRunning(ManagedThreadInfo* pThreadInfo, uint64_t& cpuTime)
     return isRunning;
 }
 
+// The state is the character following the command name (that could contain spaces) in the stat file.
+// Linux does not tell apart a thread running on a core from a runnable one: both are reported as Running.
+// For a sleeping thread, the kernel function where it is waiting (wchan) gives the cause of the wait
+// (i.e. futex for the locks and most of the synchronization primitives).
+ThreadState GetThreadState(ManagedThreadInfo* pThreadInfo)
+{
+    auto tid = static_cast<pid_t>(pThreadInfo->GetOsThreadId());
+
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/self/task/%d/stat", tid);
+    std::ifstream statFile(path);
+
+    std::string stat;
+    if (!std::getline(statFile, stat))
+    {
+        return ThreadState::Unknown;
+    }
+
+    auto commEnd = stat.rfind(')');
+    if ((commEnd == std::string::npos) || (commEnd + 2 >= stat.size()))
+    {
+        return ThreadState::Unknown;
+    }
+
+    switch (stat[commEnd + 2])
+    {
+        case 'R':
+            return ThreadState::Running;
+
+        case 'D':
+            return ThreadState::IoWait;
+
+        case 'S':
+            break;
+
+        default:
+            return ThreadState::Unknown;
+    }
+
+    snprintf(path, sizeof(path), "/proc/self/task/%d/wchan", tid);
+    std::ifstream wchanFile(path);
+
+    std::string wchan;
+    std::getline(wchanFile, wchan);
+
+    if (wchan.find("futex") != std::string::npos)
+    {
+        return ThreadState::LockWait;
+    }
+
+    if ((wchan.find("poll") != std::string::npos) ||
+        (wchan.find("select") != std::string::npos) ||
+        (wchan.find("sk_wait") != std::string::npos) ||
+        (wchan.find("pipe") != std::string::npos) ||
+        (wchan.find("wait_woken") != std::string::npos))
+    {
+        return ThreadState::IoWait;
+    }
+
+    // i.e. nanosleep or wchan not available ("0")
+    return ThreadState::Sleeping;
+}
+
+// The stack of a thread is walked in the handler of SIGUSR1 (or SIGUSR2 if SIGUSR1 is already used):
+// a thread that blocks these signals would never answer and is skipped.
+//   SigBlk: 0000000000000000  (hexadecimal mask where signal N is bit N-1)
+bool IsStackWalkSignalBlocked(pid_t tid)
+{
+    char statusPath[64];
+    snprintf(statusPath, sizeof(statusPath), "/proc/self/task/%d/status", tid);
+    std::ifstream file(statusPath);
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.rfind("SigBlk:", 0) != 0)
+        {
+            continue;
+        }
+
+        auto blockedSignals = std::stoull(line.substr(7), nullptr, 16);
+        auto stackWalkSignals = (1ull << (SIGUSR1 - 1)) | (1ull << (SIGUSR2 - 1));
+        return (blockedSignals & stackWalkSignals) != 0;
+    }
+
+    // the thread is gone
+    return true;
+}
+
+std::vector<std::pair<DWORD, shared::WSTRING>> GetProcessThreads()
+{
+    std::vector<std::pair<DWORD, shared::WSTRING>> threads;
+
+    DIR* tasks = opendir("/proc/self/task");
+    if (tasks == nullptr)
+    {
+        return threads;
+    }
+
+    struct dirent* entry;
+    while ((entry = readdir(tasks)) != nullptr)
+    {
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9')
+        {
+            continue; // . and ..
+        }
+
+        auto tid = static_cast<pid_t>(std::strtol(entry->d_name, nullptr, 10));
+        if (IsStackWalkSignalBlocked(tid))
+        {
+            continue;
+        }
+
+        // the name given by the kernel (at most 15 characters)
+        char commPath[64];
+        snprintf(commPath, sizeof(commPath), "/proc/self/task/%d/comm", tid);
+        std::ifstream file(commPath);
+
+        std::string name;
+        if (!std::getline(file, name))
+        {
+            continue;
+        }
+
+        threads.emplace_back(static_cast<DWORD>(tid), shared::ToWSTRING(name));
+    }
+
+    closedir(tasks);
+    return threads;
+}
+
 } // namespace OsSpecificApi
\ No newline at end of file
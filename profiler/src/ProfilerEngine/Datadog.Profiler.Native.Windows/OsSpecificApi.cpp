@@ -163,5 +163,98 @@ bool IsRunning(ManagedThreadInfo* pThreadInfo, uint64_t& cpuTime)
     return IsRunning(sti.ThreadState);
 }
 
+// see KWAIT_REASON in wdm.h
+typedef enum
+{
+    FreePage = 1,
+    PageIn = 2,
+    DelayExecution = 4,
+    WrFreePage = 8,
+    WrPageIn = 9,
+    WrDelayExecution = 11,
+    WrVirtualMemory = 18,
+    WrPageOut = 19,
+    WrKeyedEvent = 21,
+    WrResource = 27,
+    WrPushLock = 28,
+    WrMutex = 29,
+    WrFastMutex = 34,
+    WrGuardedMutex = 35,
+    WrAlertByThreadId = 37
+} WAIT_REASON;
+
+ThreadState GetThreadState(ULONG threadState, ULONG waitReason)
+{
+    switch (threadState)
+    {
+        case THREAD_STATE::Running:
+            return ThreadState::Running;
+
+        case THREAD_STATE::Ready:
+        case THREAD_STATE::Standby:
+        case THREAD_STATE::DeferredReady:
+            return ThreadState::Runnable;
+
+        case THREAD_STATE::Waiting:
+            break;
+
+        default:
+            return ThreadState::Unknown;
+    }
+
+    switch (waitReason)
+    {
+        case WAIT_REASON::FreePage:
+        case WAIT_REASON::PageIn:
+        case WAIT_REASON::WrFreePage:
+        case WAIT_REASON::WrPageIn:
+        case WAIT_REASON::WrVirtualMemory:
+        case WAIT_REASON::WrPageOut:
+            return ThreadState::IoWait;
+
+        // critical sections and SRW locks are waiting for WrAlertByThreadId since Windows 8
+        case WAIT_REASON::WrKeyedEvent:
+        case WAIT_REASON::WrResource:
+        case WAIT_REASON::WrPushLock:
+        case WAIT_REASON::WrMutex:
+        case WAIT_REASON::WrFastMutex:
+        case WAIT_REASON::WrGuardedMutex:
+        case WAIT_REASON::WrAlertByThreadId:
+            return ThreadState::LockWait;
+
+        // i.e. UserRequest for WaitForSingleObject: the kind of the waited object is not known
+        default:
+            return ThreadState::Sleeping;
+    }
+}
+
+ThreadState GetThreadState(ManagedThreadInfo* pThreadInfo)
+{
+    if (NtQueryInformationThread == nullptr)
+    {
+        if (!InitializeCallback())
+        {
+            return ThreadState::Unknown;
+        }
+    }
+
+    SYSTEM_THREAD_INFORMATION sti = {0};
+    auto size = sizeof(SYSTEM_THREAD_INFORMATION);
+    ULONG buflen = 0;
+    NTSTATUS lResult = NtQueryInformationThread(pThreadInfo->GetOsThreadHandle(), SYSTEMTHREADINFORMATION, &sti, size, &buflen);
+    if (lResult != 0)
+    {
+        // This always happens in 32 bit
+        return ThreadState::Unknown;
+    }
+
+    return GetThreadState(sti.ThreadState, sti.ThreadWaitReason);
+}
+
+std::vector<std::pair<DWORD, shared::WSTRING>> GetProcessThreads()
+{
+    // never called: the native threads profiling is only supported on Linux (see Configuration)
+    return {};
+}
 
 } // namespace OsSpecificApi
\ No newline at end of file
@@ -78,11 +78,6 @@ AdaptiveSampler::AdaptiveSampler(
 
     _countsRef = &_countsSlots[0];
 
-    // Initialize RNG
-    std::random_device rd;
-    _rng = std::mt19937(rd());
-    _distribution = std::uniform_real_distribution<>(0.0, 1.0);
-
     if (windowDuration != std::chrono::milliseconds::zero())
     {
         _timer.Start();
@@ -102,6 +97,11 @@ bool AdaptiveSampler::Sample()
     return false;
 }
 
+double AdaptiveSampler::GetProbability() const
+{
+    return _probability;
+}
+
 bool AdaptiveSampler::Keep()
 {
     auto* counts = _countsRef.load();
@@ -119,8 +119,26 @@ bool AdaptiveSampler::Drop()
 
 double AdaptiveSampler::NextDouble()
 {
-    std::lock_guard lock(_rngMutex);
-    return _distribution(_rng);
+    // xorshift64* generator: one state per thread so that sampling threads never contend on a lock.
+    // The statistical quality is more than enough for sampling decisions.
+    thread_local std::uint64_t state = CreateSeed();
+
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    auto value = state * 0x2545F4914F6CDD1DULL;
+
+    // keep the 53 high bits to get a uniformly distributed double in [0, 1)
+    return static_cast<double>(value >> 11) * (1.0 / 9007199254740992.0);
+}
+
+std::uint64_t AdaptiveSampler::CreateSeed()
+{
+    std::random_device rd;
+    auto seed = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+
+    // xorshift state must never be 0
+    return (seed != 0) ? seed : 0x9E3779B97F4A7C15ULL;
 }
 
 double AdaptiveSampler::ComputeIntervalAlpha(int32_t lookback)
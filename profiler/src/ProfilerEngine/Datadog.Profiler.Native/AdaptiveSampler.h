@@ -37,6 +37,7 @@ public:
 
     bool Sample();
     bool Keep();
+    double GetProbability() const;
     bool Drop();
 
     void RollWindow();
@@ -65,12 +66,9 @@ private:
     Timer _timer;
     std::function<void()> _rollWindowCallback;
 
-    std::mutex _rngMutex;
-    std::uniform_real_distribution<> _distribution;
-    std::mt19937 _rng;
-
     static double ComputeIntervalAlpha(int32_t lookback);
 
-    double NextDouble();
+    static double NextDouble();
+    static std::uint64_t CreateSeed();
     int64_t CalculateBudgetEma(int64_t sampledCount);
 };
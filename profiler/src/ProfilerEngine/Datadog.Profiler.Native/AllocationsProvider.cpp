@@ -0,0 +1,108 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "AllocationsProvider.h"
+
+#include "HResultConverter.h"
+#include "Log.h"
+#include "OpSysTools.h"
+#include "shared/src/native-src/string.h"
+
+
+AllocationsProvider::AllocationsProvider(
+    ICorProfilerInfo4* pCorProfilerInfo,
+    IManagedThreadList* pManagedThreadList,
+    IFrameStore* pFrameStore,
+    IConfiguration* pConfiguration,
+    IThreadsCpuManager* pThreadsCpuManager,
+    IAppDomainStore* pAppDomainStore,
+    IRuntimeIdStore* pRuntimeIdStore,
+    LiveObjectsProvider* pLiveObjectsProvider)
+    :
+    CollectorBase<RawAllocationSample>("AllocationsProvider", pThreadsCpuManager, pFrameStore, pAppDomainStore, pRuntimeIdStore),
+    _pCorProfilerInfo(pCorProfilerInfo),
+    _pManagedThreadList(pManagedThreadList),
+    _pLiveObjectsProvider(pLiveObjectsProvider),
+    _sampler(SamplingWindow, SamplesPerWindow(pConfiguration), SamplingWindowsPerRecording(pConfiguration), 16, nullptr),
+    _stackFramesCollectors(pCorProfilerInfo)
+{
+}
+
+void AllocationsProvider::OnAllocation(
+    std::uint32_t allocationKind,
+    ClassID classId,
+    const WCHAR* typeName,
+    std::size_t typeNameLength,
+    std::uint64_t allocationAmount,
+    ObjectID objectId)
+{
+    // nothing is converted nor collected for the ticks that are not sampled
+    auto samplingProbability = _sampler.GetProbability();
+    if (!_sampler.Sample())
+    {
+        return;
+    }
+
+    ManagedThreadInfo* threadInfo;
+    HRESULT hr = _pManagedThreadList->TryGetCurrentThreadInfo(&threadInfo);
+    if (FAILED(hr))
+    {
+        Log::Debug("Failed to get the current thread info for an allocation: ", HResultConverter::ToStringWithCode(hr));
+        return;
+    }
+
+    uint32_t hrCollectStack = E_FAIL;
+
+    // the collector (and the snapshot buffer pointed to by result) goes back to the pool when leaving the scope
+    const auto pStackFramesCollector = _stackFramesCollectors.Acquire();
+
+    pStackFramesCollector->PrepareForNextCollection();
+    const auto result = pStackFramesCollector->CollectStackSample(threadInfo, &hrCollectStack);
+
+    if (result->GetFramesCount() == 0)
+    {
+        Log::Debug("Failed to walk stack for sampled allocation: ", HResultConverter::ToStringWithCode(hrCollectStack));
+        return;
+    }
+
+    result->DetermineAppDomain(threadInfo->GetClrThreadId(), _pCorProfilerInfo);
+
+    RawAllocationSample rawSample;
+
+    rawSample.Timestamp = OpSysTools::GetUnixTimeMilliseconds();
+    rawSample.LocalRootSpanId = result->GetLocalRootSpanId();
+    rawSample.SpanId = result->GetSpanId();
+    rawSample.AppDomainId = result->GetAppDomainId();
+    result->CopyInstructionPointers(rawSample.Stack);
+    rawSample.ThreadInfo = threadInfo;
+    threadInfo->AddRef();
+    rawSample.AllocationClass = shared::ToString(typeName, typeNameLength);
+    rawSample.AllocationSize = allocationAmount;
+    rawSample.SamplingProbability = samplingProbability;
+
+    // the same sampled allocations are followed until they are collected to build the live heap profile
+    if ((_pLiveObjectsProvider != nullptr) && (objectId != 0))
+    {
+        _pLiveObjectsProvider->OnAllocation(objectId, rawSample);
+    }
+
+    Add(std::move(rawSample));
+}
+
+void AllocationsProvider::OnTransformRawSample(const RawAllocationSample& rawSample, Sample& sample)
+{
+    sample.AddValue(1, SampleValue::AllocationCount);
+    sample.AddValue(rawSample.GetUpscaledAllocationSize(), SampleValue::AllocationSize);
+    sample.AddLabel(Label(Sample::AllocationClassLabel, rawSample.AllocationClass));
+}
+
+int AllocationsProvider::SamplingWindowsPerRecording(const IConfiguration* pConfiguration)
+{
+    const auto uploadIntervalMs = std::chrono::duration_cast<std::chrono::milliseconds>(pConfiguration->GetUploadInterval());
+    return static_cast<int32_t>(std::max<long long>(std::min<long long>(uploadIntervalMs / SamplingWindow, INT32_MAX), 1));
+}
+
+int AllocationsProvider::SamplesPerWindow(const IConfiguration* pConfiguration)
+{
+    return std::max(pConfiguration->AllocationSampleLimit() / SamplingWindowsPerRecording(pConfiguration), 1);
+}
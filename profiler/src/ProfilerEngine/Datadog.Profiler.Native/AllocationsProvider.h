@@ -0,0 +1,61 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include "cor.h"
+#include "corprof.h"
+
+#include "AdaptiveSampler.h"
+#include "CollectorBase.h"
+#include "IAllocationsListener.h"
+#include "IConfiguration.h"
+#include "IFrameStore.h"
+#include "IManagedThreadList.h"
+#include "LiveObjectsProvider.h"
+#include "RawAllocationSample.h"
+#include "StackFramesCollectorPool.h"
+
+// Allocations are not intercepted one by one (COR_PRF_ENABLE_OBJECT_ALLOCATED disables the allocation fast path):
+// the CLR already emits an AllocationTick event every ~100 KB allocated, with the type of the object that crossed
+// the threshold. The callstack is collected only for the ticks kept by the sampler so that the number of
+// stack walks is bounded, whatever the allocation rate.
+class AllocationsProvider
+    : public CollectorBase<RawAllocationSample>,
+      public IAllocationsListener
+{
+public:
+    AllocationsProvider(
+        ICorProfilerInfo4* pCorProfilerInfo,
+        IManagedThreadList* pManagedThreadList,
+        IFrameStore* pFrameStore,
+        IConfiguration* pConfiguration,
+        IThreadsCpuManager* pThreadsCpuManager,
+        IAppDomainStore* pAppDomainStore,
+        IRuntimeIdStore* pRuntimeIdStore,
+        LiveObjectsProvider* pLiveObjectsProvider);
+
+    void OnAllocation(
+        std::uint32_t allocationKind,
+        ClassID classId,
+        const WCHAR* typeName,
+        std::size_t typeNameLength,
+        std::uint64_t allocationAmount,
+        ObjectID objectId) override;
+
+protected:
+    void OnTransformRawSample(const RawAllocationSample& rawSample, Sample& sample) override;
+
+private:
+    static int SamplingWindowsPerRecording(const IConfiguration* pConfiguration);
+    static int SamplesPerWindow(const IConfiguration* pConfiguration);
+
+private:
+    static constexpr inline std::chrono::milliseconds SamplingWindow = std::chrono::milliseconds(500);
+
+    ICorProfilerInfo4* _pCorProfilerInfo;
+    IManagedThreadList* _pManagedThreadList;
+    LiveObjectsProvider* _pLiveObjectsProvider;
+    AdaptiveSampler _sampler;
+    StackFramesCollectorPool _stackFramesCollectors;
+};
@@ -0,0 +1,203 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "ClrEventsParser.h"
+
+#include <cstring>
+
+#include "OpSysTools.h"
+#include "shared/src/native-src/string.h"
+
+const WCHAR* const ClrEventsParser::RuntimeProviderName = WStr("Microsoft-Windows-DotNETRuntime");
+
+thread_local std::int64_t ClrEventsParser::_contentionStartTimestamp = 0;
+
+ClrEventsParser::ClrEventsParser(IAllocationsListener* pAllocationListener, IContentionListener* pContentionListener, IGarbageCollectionsListener* pGarbageCollectionsListener) :
+    _pAllocationListener{pAllocationListener},
+    _pContentionListener{pContentionListener},
+    _pGarbageCollectionsListener{pGarbageCollectionsListener}
+{
+}
+
+void ClrEventsParser::ParseEvent(std::uint32_t eventId, std::uint32_t eventVersion, std::uint32_t cbEventData, const std::uint8_t* pEventData)
+{
+    if (eventId == EVENT_GC_START)
+    {
+        if (_pGarbageCollectionsListener != nullptr)
+        {
+            ParseGarbageCollectionStart(eventVersion, cbEventData, pEventData);
+        }
+    }
+    else if (eventId == EVENT_ALLOCATION_TICK)
+    {
+        if (_pAllocationListener != nullptr)
+        {
+            ParseAllocationTick(eventVersion, cbEventData, pEventData);
+        }
+    }
+    else if (eventId == EVENT_CONTENTION_START)
+    {
+        if (_pContentionListener != nullptr)
+        {
+            OnContentionStart();
+        }
+    }
+    else if (eventId == EVENT_CONTENTION_STOP)
+    {
+        if (_pContentionListener != nullptr)
+        {
+            OnContentionStop(eventVersion, cbEventData, pEventData);
+        }
+    }
+}
+
+void ClrEventsParser::ParseGarbageCollectionStart(std::uint32_t eventVersion, std::uint32_t cbEventData, const std::uint8_t* pEventData)
+{
+    // <template tid="GCStart_V2">
+    //     <data name="Count" inType="win:UInt32" />
+    //     <data name="Depth" inType="win:UInt32" />
+    //     <data name="Reason" inType="win:UInt32" />
+    //     <data name="Type" inType="win:UInt32" />             (V1+)
+    //     <data name="ClrInstanceID" inType="win:UInt16" />    (V1+)
+    //     <data name="ClientSequenceNumber" inType="win:UInt64" />
+    std::uint32_t offset = 0;
+    std::uint32_t count;
+    std::uint32_t depth;
+    std::uint32_t reason;
+    if (!Read(count, pEventData, cbEventData, offset) ||
+        !Read(depth, pEventData, cbEventData, offset) ||
+        !Read(reason, pEventData, cbEventData, offset))
+    {
+        return;
+    }
+
+    // the type (blocking, background or foreground) is only available since V1
+    std::uint32_t type;
+    if ((eventVersion < 1) || !Read(type, pEventData, cbEventData, offset))
+    {
+        type = 0;
+    }
+
+    _pGarbageCollectionsListener->OnGarbageCollectionStart(count, depth, reason, type);
+}
+
+void ClrEventsParser::ParseAllocationTick(std::uint32_t eventVersion, std::uint32_t cbEventData, const std::uint8_t* pEventData)
+{
+    // <template tid="GCAllocationTick_V3">  (V4 adds ObjectSize at the end)
+    //     <data name="AllocationAmount" inType="win:UInt32" />
+    //     <data name="AllocationKind" inType="win:UInt32" />
+    //     <data name="ClrInstanceID" inType="win:UInt16" />
+    //     <data name="AllocationAmount64" inType="win:UInt64" />
+    //     <data name="TypeId" inType="win:Pointer" />
+    //     <data name="TypeName" inType="win:UnicodeString" />
+    //     <data name="HeapIndex" inType="win:UInt32" />
+    //     <data name="Address" inType="win:Pointer" />   (V3+)
+    // The fields are not aligned.
+    if (eventVersion < 2)
+    {
+        // no type information before V2
+        return;
+    }
+
+    std::uint32_t offset = 0;
+    std::uint32_t allocationAmount;
+    std::uint32_t allocationKind;
+    std::uint16_t clrInstanceId;
+    std::uint64_t allocationAmount64;
+    std::uintptr_t typeId;
+    const WCHAR* typeName;
+    std::size_t typeNameLength;
+
+    if (!Read(allocationAmount, pEventData, cbEventData, offset) ||
+        !Read(allocationKind, pEventData, cbEventData, offset) ||
+        !Read(clrInstanceId, pEventData, cbEventData, offset) ||
+        !Read(allocationAmount64, pEventData, cbEventData, offset) ||
+        !Read(typeId, pEventData, cbEventData, offset) ||
+        !ReadWString(typeName, typeNameLength, pEventData, cbEventData, offset))
+    {
+        return;
+    }
+
+    // the address of the object that crossed the threshold is only available since V3 (.NET 5)
+    std::uint32_t heapIndex;
+    std::uintptr_t address = 0;
+    if ((eventVersion < 3) ||
+        !Read(heapIndex, pEventData, cbEventData, offset) ||
+        !Read(address, pEventData, cbEventData, offset))
+    {
+        address = 0;
+    }
+
+    _pAllocationListener->OnAllocation(allocationKind, static_cast<ClassID>(typeId), typeName, typeNameLength, allocationAmount64, static_cast<ObjectID>(address));
+}
+
+void ClrEventsParser::OnContentionStart()
+{
+    // the payload (flags, lock and owner thread) is not needed
+    _contentionStartTimestamp = OpSysTools::GetHighPrecisionNanoseconds();
+}
+
+void ClrEventsParser::OnContentionStop(std::uint32_t eventVersion, std::uint32_t cbEventData, const std::uint8_t* pEventData)
+{
+    // <template tid="ContentionStop_V1">
+    //     <data name="ContentionFlags" inType="win:UInt8" />
+    //     <data name="ClrInstanceID" inType="win:UInt16" />
+    //     <data name="DurationNs" inType="win:Double" />
+    auto startTimestamp = _contentionStartTimestamp;
+    _contentionStartTimestamp = 0;
+
+    double durationNs;
+
+    std::uint32_t offset = 0;
+    std::uint8_t contentionFlags;
+    std::uint16_t clrInstanceId;
+    if ((eventVersion >= 1) &&
+        Read(contentionFlags, pEventData, cbEventData, offset) &&
+        Read(clrInstanceId, pEventData, cbEventData, offset) &&
+        Read(durationNs, pEventData, cbEventData, offset))
+    {
+        _pContentionListener->OnContention(durationNs);
+        return;
+    }
+
+    if (startTimestamp == 0)
+    {
+        // the ContentionStart event was missed (i.e. the session started during the wait)
+        return;
+    }
+
+    durationNs = static_cast<double>(OpSysTools::GetHighPrecisionNanoseconds() - startTimestamp);
+    _pContentionListener->OnContention(durationNs);
+}
+
+template <typename T>
+bool ClrEventsParser::Read(T& value, const std::uint8_t* pBlob, std::uint32_t blobSize, std::uint32_t& offset)
+{
+    if ((pBlob == nullptr) || (blobSize < offset) || (blobSize - offset < sizeof(T)))
+    {
+        return false;
+    }
+
+    std::memcpy(&value, pBlob + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+bool ClrEventsParser::ReadWString(const WCHAR*& pString, std::size_t& length, const std::uint8_t* pBlob, std::uint32_t blobSize, std::uint32_t& offset)
+{
+    // the string is null terminated: look for the terminator without going past the end of the payload
+    std::uint32_t current = offset;
+    WCHAR character;
+    do
+    {
+        if (!Read(character, pBlob, blobSize, current))
+        {
+            return false;
+        }
+    } while (character != 0);
+
+    pString = reinterpret_cast<const WCHAR*>(pBlob + offset);
+    length = (current - offset) / sizeof(WCHAR) - 1;
+    offset = current;
+    return true;
+}
@@ -0,0 +1,56 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include <cstdint>
+
+#include "cor.h"
+#include "corprof.h"
+
+#include "IAllocationsListener.h"
+#include "IContentionListener.h"
+#include "IGarbageCollectionsListener.h"
+
+// Decodes the payload of the CLR events received from the in-process EventPipe session
+// (see CorProfilerCallback::EventPipeEventDelivered) and dispatches them to the listeners.
+// Event layouts are described in ClrEtwAll.man in the dotnet/runtime repository.
+class ClrEventsParser
+{
+public:
+    static const WCHAR* const RuntimeProviderName;
+
+    // keywords and level of the Microsoft-Windows-DotNETRuntime provider
+    static constexpr std::uint64_t KEYWORD_GC = 0x1;
+    static constexpr std::uint64_t KEYWORD_CONTENTION = 0x4000;
+    static constexpr std::uint32_t LEVEL_INFORMATIONAL = 4;
+    static constexpr std::uint32_t LEVEL_VERBOSE = 5;
+
+    static constexpr std::uint32_t EVENT_GC_START = 1;
+    static constexpr std::uint32_t EVENT_ALLOCATION_TICK = 10;
+    static constexpr std::uint32_t EVENT_CONTENTION_START = 81;
+    static constexpr std::uint32_t EVENT_CONTENTION_STOP = 91;
+
+public:
+    ClrEventsParser(IAllocationsListener* pAllocationListener, IContentionListener* pContentionListener, IGarbageCollectionsListener* pGarbageCollectionsListener);
+
+    void ParseEvent(std::uint32_t eventId, std::uint32_t eventVersion, std::uint32_t cbEventData, const std::uint8_t* pEventData);
+
+private:
+    void ParseGarbageCollectionStart(std::uint32_t eventVersion, std::uint32_t cbEventData, const std::uint8_t* pEventData);
+    void ParseAllocationTick(std::uint32_t eventVersion, std::uint32_t cbEventData, const std::uint8_t* pEventData);
+    void OnContentionStart();
+    void OnContentionStop(std::uint32_t eventVersion, std::uint32_t cbEventData, const std::uint8_t* pEventData);
+
+    template <typename T>
+    static bool Read(T& value, const std::uint8_t* pBlob, std::uint32_t blobSize, std::uint32_t& offset);
+    static bool ReadWString(const WCHAR*& pString, std::size_t& length, const std::uint8_t* pBlob, std::uint32_t blobSize, std::uint32_t& offset);
+
+private:
+    IAllocationsListener* _pAllocationListener;
+    IContentionListener* _pContentionListener;
+    IGarbageCollectionsListener* _pGarbageCollectionsListener;
+
+    // ContentionStop does not provide the duration before .NET 8: the start time is kept per waiting thread
+    static thread_local std::int64_t _contentionStartTimestamp;
+};
@@ -15,6 +15,7 @@
 #include "IFrameStore.h"
 #include "IAppDomainStore.h"
 #include "IRuntimeIdStore.h"
+#include "IThreadLabelsStore.h"
 #include "IThreadsCpuManager.h"
 #include "ProviderBase.h"
 #include "RawSample.h"
@@ -147,11 +148,13 @@ private:
     {
         for (auto const& rawSample : input)
         {
-            TransformRawSample(rawSample);
+            Store(TransformRawSample(rawSample));
         }
     }
 
-    void TransformRawSample(const TRawSample& rawSample)
+protected:
+    // Note: the reference on rawSample.ThreadInfo is released
+    Sample TransformRawSample(const TRawSample& rawSample)
     {
         Sample sample(rawSample.Timestamp, _pRuntimeIdStore->GetId(rawSample.AppDomainId));
         if (rawSample.LocalRootSpanId != 0 && rawSample.SpanId != 0)
@@ -170,10 +173,30 @@ private:
         // allow inherited classes to add values and specific labels
         OnTransformRawSample(rawSample, sample);
 
-        // save it in the output list
-        Store(std::move(sample));
+        return sample;
+    }
+
+    // the custom labels set by the application on the sampled thread are interned: the texts are only resolved here
+    static void SetThreadLabels(IThreadLabelsStore* pThreadLabelsStore, const TRawSample& rawSample, Sample& sample)
+    {
+        if (pThreadLabelsStore == nullptr)
+        {
+            return;
+        }
+
+        for (auto const& threadLabel : rawSample.ThreadLabels)
+        {
+            std::string key;
+            std::string value;
+            if (pThreadLabelsStore->GetText(threadLabel.KeyId, key) && pThreadLabelsStore->GetText(threadLabel.ValueId, value))
+            {
+                sample.AddLabel(Label(std::move(key), std::move(value)));
+            }
+        }
     }
 
+private:
+
     void SetAppDomainDetails(const TRawSample& rawSample, Sample& sample)
     {
         ProcessID pid;
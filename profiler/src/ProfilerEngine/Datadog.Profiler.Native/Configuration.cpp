@@ -26,6 +26,7 @@ int const Configuration::DefaultAgentPort = 8126;
 std::string const Configuration::DefaultEmptyString = "";
 std::chrono::seconds const Configuration::DefaultDevUploadInterval = 20s;
 std::chrono::seconds const Configuration::DefaultProdUploadInterval = 60s;
+std::chrono::milliseconds const Configuration::DefaultBurstSamplingDuration = 500ms;
 
 Configuration::Configuration()
 {
@@ -49,6 +50,25 @@ Configuration::Configuration()
     _serviceName = GetEnvironmentValue(EnvironmentVariables::ServiceName, OpSysTools::GetProcessName());
     _isAgentLess = GetEnvironmentValue(EnvironmentVariables::Agentless, false);
     _exceptionSampleLimit = GetEnvironmentValue(EnvironmentVariables::ExceptionSampleLimit, 100);
+    _isTimelineEnabled = GetEnvironmentValue(EnvironmentVariables::TimelineEnabled, false);
+    _exceptionMessageMaxLength = GetEnvironmentValue(EnvironmentVariables::ExceptionMessageMaxLength, 1024);
+    _isExceptionMessageNormalizationEnabled = GetEnvironmentValue(EnvironmentVariables::ExceptionMessageNormalizationEnabled, false);
+    _isAllocationProfilingEnabled = GetEnvironmentValue(EnvironmentVariables::AllocationProfilingEnabled, false);
+    _allocationSampleLimit = GetEnvironmentValue(EnvironmentVariables::AllocationSampleLimit, 10000);
+    _isContentionProfilingEnabled = GetEnvironmentValue(EnvironmentVariables::ContentionProfilingEnabled, false);
+    _contentionSampleLimit = GetEnvironmentValue(EnvironmentVariables::ContentionSampleLimit, 10000);
+    _isGarbageCollectionProfilingEnabled = GetEnvironmentValue(EnvironmentVariables::GarbageCollectionProfilingEnabled, false);
+    _isHeapProfilingEnabled = GetEnvironmentValue(EnvironmentVariables::HeapProfilingEnabled, false);
+#ifdef _WINDOWS
+    // the native threads are enumerated from /proc/self/task: only supported on Linux
+    _isNativeThreadsProfilingEnabled = false;
+#else
+    _isNativeThreadsProfilingEnabled = GetEnvironmentValue(EnvironmentVariables::NativeThreadsProfilingEnabled, false);
+#endif
+    _isJitProfilingEnabled = GetEnvironmentValue(EnvironmentVariables::JitProfilingEnabled, false);
+    // same variables as the tracer: 0 means burst sampling is disabled
+    _burstSamplingThreshold = ExtractMilliseconds(EnvironmentVariables::BurstSamplingThreshold, 0ms);
+    _burstSamplingDuration = ExtractMilliseconds(EnvironmentVariables::BurstSamplingDuration, DefaultBurstSamplingDuration);
 }
 
 fs::path Configuration::ExtractLogDirectory()
@@ -104,6 +124,71 @@ int Configuration::ExceptionSampleLimit() const
     return _exceptionSampleLimit;
 }
 
+bool Configuration::IsTimelineEnabled() const
+{
+    return _isTimelineEnabled;
+}
+
+int Configuration::ExceptionMessageMaxLength() const
+{
+    return _exceptionMessageMaxLength;
+}
+
+bool Configuration::IsExceptionMessageNormalizationEnabled() const
+{
+    return _isExceptionMessageNormalizationEnabled;
+}
+
+bool Configuration::IsAllocationProfilingEnabled() const
+{
+    return _isAllocationProfilingEnabled;
+}
+
+int Configuration::AllocationSampleLimit() const
+{
+    return _allocationSampleLimit;
+}
+
+bool Configuration::IsContentionProfilingEnabled() const
+{
+    return _isContentionProfilingEnabled;
+}
+
+int Configuration::ContentionSampleLimit() const
+{
+    return _contentionSampleLimit;
+}
+
+bool Configuration::IsGarbageCollectionProfilingEnabled() const
+{
+    return _isGarbageCollectionProfilingEnabled;
+}
+
+bool Configuration::IsHeapProfilingEnabled() const
+{
+    return _isHeapProfilingEnabled;
+}
+
+bool Configuration::IsNativeThreadsProfilingEnabled() const
+{
+    return _isNativeThreadsProfilingEnabled;
+}
+
+bool Configuration::IsJitProfilingEnabled() const
+{
+    return _isJitProfilingEnabled;
+}
+
+std::chrono::milliseconds Configuration::GetBurstSamplingThreshold() const
+{
+    return _burstSamplingThreshold;
+}
+
+std::chrono::milliseconds Configuration::GetBurstSamplingDuration() const
+{
+    return _burstSamplingDuration;
+}
+
 std::chrono::seconds Configuration::GetUploadInterval() const
 {
     return _uploadPeriod;
@@ -269,6 +354,18 @@ std::chrono::seconds Configuration::ExtractUploadInterval()
     return GetDefaultUploadInterval();
 }
 
+std::chrono::milliseconds Configuration::ExtractMilliseconds(shared::WSTRING const& name, std::chrono::milliseconds defaultValue)
+{
+    auto r = shared::GetEnvironmentValue(name);
+    int value;
+    if (TryParse(r, value) && (value > 0))
+    {
+        return std::chrono::milliseconds(value);
+    }
+
+    return defaultValue;
+}
+
 bool Configuration::GetDefaultDebugLogEnabled()
 {
     auto r = shared::GetEnvironmentValue(EnvironmentVariables::DevelopmentConfiguration);
@@ -40,12 +40,26 @@ public:
     bool IsCpuProfilingEnabled() const override;
     bool IsExceptionProfilingEnabled() const override;
     int ExceptionSampleLimit() const override;
+    bool IsTimelineEnabled() const override;
+    int ExceptionMessageMaxLength() const override;
+    bool IsExceptionMessageNormalizationEnabled() const override;
+    bool IsAllocationProfilingEnabled() const override;
+    int AllocationSampleLimit() const override;
+    bool IsContentionProfilingEnabled() const override;
+    int ContentionSampleLimit() const override;
+    bool IsGarbageCollectionProfilingEnabled() const override;
+    bool IsHeapProfilingEnabled() const override;
+    bool IsNativeThreadsProfilingEnabled() const override;
+    bool IsJitProfilingEnabled() const override;
+    std::chrono::milliseconds GetBurstSamplingThreshold() const override;
+    std::chrono::milliseconds GetBurstSamplingDuration() const override;
 
 private:
     static tags ExtractUserTags();
     static std::string GetDefaultSite();
     static std::string ExtractSite();
     static std::chrono::seconds ExtractUploadInterval();
+    static std::chrono::milliseconds ExtractMilliseconds(shared::WSTRING const& name, std::chrono::milliseconds defaultValue);
     static fs::path GetDefaultLogDirectoryPath();
     static fs::path GetApmBaseDirectory();
     static fs::path ExtractLogDirectory();
@@ -65,6 +79,7 @@ private:
     static int const DefaultAgentPort;
     static std::chrono::seconds const DefaultDevUploadInterval;
     static std::chrono::seconds const DefaultProdUploadInterval;
+    static std::chrono::milliseconds const DefaultBurstSamplingDuration;
 
     bool _isProfilingEnabled;
     bool _isCpuProfilingEnabled;
@@ -87,4 +102,17 @@ private:
     bool _isNativeFrameEnabled;
     bool _isAgentLess;
     int _exceptionSampleLimit;
+    bool _isTimelineEnabled;
+    int _exceptionMessageMaxLength;
+    bool _isExceptionMessageNormalizationEnabled;
+    bool _isAllocationProfilingEnabled;
+    int _allocationSampleLimit;
+    bool _isContentionProfilingEnabled;
+    int _contentionSampleLimit;
+    bool _isGarbageCollectionProfilingEnabled;
+    bool _isHeapProfilingEnabled;
+    bool _isNativeThreadsProfilingEnabled;
+    bool _isJitProfilingEnabled;
+    std::chrono::milliseconds _burstSamplingThreshold;
+    std::chrono::milliseconds _burstSamplingDuration;
 };
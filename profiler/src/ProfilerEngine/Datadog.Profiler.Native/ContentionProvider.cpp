@@ -0,0 +1,93 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "ContentionProvider.h"
+
+#include "HResultConverter.h"
+#include "Log.h"
+#include "OpSysTools.h"
+
+#include <cmath>
+
+ContentionProvider::ContentionProvider(
+    ICorProfilerInfo4* pCorProfilerInfo,
+    IManagedThreadList* pManagedThreadList,
+    IFrameStore* pFrameStore,
+    IConfiguration* pConfiguration,
+    IThreadsCpuManager* pThreadsCpuManager,
+    IAppDomainStore* pAppDomainStore,
+    IRuntimeIdStore* pRuntimeIdStore)
+    :
+    CollectorBase<RawContentionSample>("ContentionProvider", pThreadsCpuManager, pFrameStore, pAppDomainStore, pRuntimeIdStore),
+    _pCorProfilerInfo(pCorProfilerInfo),
+    _pManagedThreadList(pManagedThreadList),
+    _sampler(SamplingWindow, SamplesPerWindow(pConfiguration), SamplingWindowsPerRecording(pConfiguration), 16, nullptr),
+    _stackFramesCollectors(pCorProfilerInfo)
+{
+}
+
+void ContentionProvider::OnContention(double contentionDurationNs)
+{
+    auto samplingProbability = _sampler.GetProbability();
+    if (!_sampler.Sample())
+    {
+        return;
+    }
+
+    ManagedThreadInfo* threadInfo;
+    HRESULT hr = _pManagedThreadList->TryGetCurrentThreadInfo(&threadInfo);
+    if (FAILED(hr))
+    {
+        Log::Debug("Failed to get the current thread info for a lock contention: ", HResultConverter::ToStringWithCode(hr));
+        return;
+    }
+
+    uint32_t hrCollectStack = E_FAIL;
+
+    // the collector (and the snapshot buffer pointed to by result) goes back to the pool when leaving the scope
+    const auto pStackFramesCollector = _stackFramesCollectors.Acquire();
+
+    pStackFramesCollector->PrepareForNextCollection();
+    const auto result = pStackFramesCollector->CollectStackSample(threadInfo, &hrCollectStack);
+
+    if (result->GetFramesCount() == 0)
+    {
+        Log::Debug("Failed to walk stack for sampled lock contention: ", HResultConverter::ToStringWithCode(hrCollectStack));
+        return;
+    }
+
+    result->DetermineAppDomain(threadInfo->GetClrThreadId(), _pCorProfilerInfo);
+
+    RawContentionSample rawSample;
+
+    rawSample.Timestamp = OpSysTools::GetUnixTimeMilliseconds();
+    rawSample.LocalRootSpanId = result->GetLocalRootSpanId();
+    rawSample.SpanId = result->GetSpanId();
+    rawSample.AppDomainId = result->GetAppDomainId();
+    result->CopyInstructionPointers(rawSample.Stack);
+    rawSample.ThreadInfo = threadInfo;
+    threadInfo->AddRef();
+    rawSample.ContentionDuration = contentionDurationNs;
+    rawSample.SamplingProbability = samplingProbability;
+
+    Add(std::move(rawSample));
+}
+
+void ContentionProvider::OnTransformRawSample(const RawContentionSample& rawSample, Sample& sample)
+{
+    auto scale = (rawSample.SamplingProbability > 0) ? 1 / rawSample.SamplingProbability : 1;
+
+    sample.AddValue(std::llround(scale), SampleValue::ContentionCount);
+    sample.AddValue(std::llround(rawSample.ContentionDuration * scale), SampleValue::ContentionDuration);
+}
+
+int ContentionProvider::SamplingWindowsPerRecording(const IConfiguration* pConfiguration)
+{
+    const auto uploadIntervalMs = std::chrono::duration_cast<std::chrono::milliseconds>(pConfiguration->GetUploadInterval());
+    return static_cast<int32_t>(std::max<long long>(std::min<long long>(uploadIntervalMs / SamplingWindow, INT32_MAX), 1));
+}
+
+int ContentionProvider::SamplesPerWindow(const IConfiguration* pConfiguration)
+{
+    return std::max(pConfiguration->ContentionSampleLimit() / SamplingWindowsPerRecording(pConfiguration), 1);
+}
@@ -0,0 +1,50 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include "cor.h"
+#include "corprof.h"
+
+#include "AdaptiveSampler.h"
+#include "CollectorBase.h"
+#include "IConfiguration.h"
+#include "IContentionListener.h"
+#include "IFrameStore.h"
+#include "IManagedThreadList.h"
+#include "RawContentionSample.h"
+#include "StackFramesCollectorPool.h"
+
+// Lock contentions are received as ContentionStart/ContentionStop events from the EventPipe session.
+// As for allocations, the callstack is collected only for the contentions kept by the sampler.
+class ContentionProvider
+    : public CollectorBase<RawContentionSample>,
+      public IContentionListener
+{
+public:
+    ContentionProvider(
+        ICorProfilerInfo4* pCorProfilerInfo,
+        IManagedThreadList* pManagedThreadList,
+        IFrameStore* pFrameStore,
+        IConfiguration* pConfiguration,
+        IThreadsCpuManager* pThreadsCpuManager,
+        IAppDomainStore* pAppDomainStore,
+        IRuntimeIdStore* pRuntimeIdStore);
+
+    void OnContention(double contentionDurationNs) override;
+
+protected:
+    void OnTransformRawSample(const RawContentionSample& rawSample, Sample& sample) override;
+
+private:
+    static int SamplingWindowsPerRecording(const IConfiguration* pConfiguration);
+    static int SamplesPerWindow(const IConfiguration* pConfiguration);
+
+private:
+    static constexpr inline std::chrono::milliseconds SamplingWindow = std::chrono::milliseconds(500);
+
+    ICorProfilerInfo4* _pCorProfilerInfo;
+    IManagedThreadList* _pManagedThreadList;
+    AdaptiveSampler _sampler;
+    StackFramesCollectorPool _stackFramesCollectors;
+};
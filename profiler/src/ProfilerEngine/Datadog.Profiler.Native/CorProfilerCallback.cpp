@@ -20,6 +20,7 @@
 #include "ClrLifetime.h"
 #include "Configuration.h"
 #include "CpuTimeProvider.h"
+#include "EndpointStore.h"
 #include "EnvironmentVariables.h"
 #include "FrameStore.h"
 #include "IMetricsSender.h"
@@ -33,6 +34,7 @@
 #include "RuntimeIdStore.h"
 #include "SamplesAggregator.h"
 #include "StackSamplerLoopManager.h"
+#include "ThreadLabelsStore.h"
 #include "ThreadsCpuManager.h"
 #include "WallTimeProvider.h"
 #include "ExceptionsProvider.h"
@@ -116,11 +118,13 @@ bool CorProfilerCallback::InitializeServices()
     _pManagedThreadList = RegisterService<ManagedThreadList>(_pCorProfilerInfo);
 
     auto* pRuntimeIdStore = RegisterService<RuntimeIdStore>();
-    _pWallTimeProvider = RegisterService<WallTimeProvider>(_pThreadsCpuManager, _pFrameStore.get(), _pAppDomainStore.get(), pRuntimeIdStore);
+    _pEndpointStore = RegisterService<EndpointStore>();
+    _pThreadLabelsStore = RegisterService<ThreadLabelsStore>();
+    _pWallTimeProvider = RegisterService<WallTimeProvider>(_pThreadsCpuManager, _pFrameStore.get(), _pAppDomainStore.get(), pRuntimeIdStore, _pEndpointStore, _pThreadLabelsStore);
 
     if (_pConfiguration->IsCpuProfilingEnabled())
     {
-        _pCpuTimeProvider = RegisterService<CpuTimeProvider>(_pThreadsCpuManager, _pFrameStore.get(), _pAppDomainStore.get(), pRuntimeIdStore);
+        _pCpuTimeProvider = RegisterService<CpuTimeProvider>(_pThreadsCpuManager, _pFrameStore.get(), _pAppDomainStore.get(), pRuntimeIdStore, _pEndpointStore, _pThreadLabelsStore);
     }
 
     if (_pConfiguration->IsExceptionProfilingEnabled())
@@ -136,6 +140,72 @@ bool CorProfilerCallback::InitializeServices()
             );
     }
 
+    if (_pConfiguration->IsHeapProfilingEnabled())
+    {
+        // the live objects are the sampled allocations that have not been collected yet
+        if (!_pConfiguration->IsAllocationProfilingEnabled())
+        {
+            Log::Warn("Heap profiling is disabled: it requires allocation profiling to be enabled.");
+        }
+        else if (FAILED(_pCorProfilerInfo->QueryInterface(__uuidof(ICorProfilerInfo13), (void**)&_pCorProfilerInfoLiveHeap)))
+        {
+            Log::Warn("Heap profiling is not supported by this runtime: ICorProfilerInfo13 (.NET 7+) is required.");
+            _pCorProfilerInfoLiveHeap = nullptr;
+        }
+        else
+        {
+            _pLiveObjectsProvider = RegisterService<LiveObjectsProvider>(
+                _pCorProfilerInfoLiveHeap,
+                _pFrameStore.get(),
+                _pThreadsCpuManager,
+                _pAppDomainStore.get(),
+                pRuntimeIdStore
+                );
+        }
+    }
+
+    if (_pConfiguration->IsAllocationProfilingEnabled())
+    {
+        _pAllocationsProvider = RegisterService<AllocationsProvider>(
+            _pCorProfilerInfo,
+            _pManagedThreadList,
+            _pFrameStore.get(),
+            _pConfiguration.get(),
+            _pThreadsCpuManager,
+            _pAppDomainStore.get(),
+            pRuntimeIdStore,
+            _pLiveObjectsProvider
+            );
+    }
+
+    if (_pConfiguration->IsContentionProfilingEnabled())
+    {
+        _pContentionProvider = RegisterService<ContentionProvider>(
+            _pCorProfilerInfo,
+            _pManagedThreadList,
+            _pFrameStore.get(),
+            _pConfiguration.get(),
+            _pThreadsCpuManager,
+            _pAppDomainStore.get(),
+            pRuntimeIdStore
+            );
+    }
+
+    if (_pConfiguration->IsGarbageCollectionProfilingEnabled())
+    {
+        _pGarbageCollectionProvider = RegisterService<GarbageCollectionProvider>(_pCorProfilerInfo, pRuntimeIdStore);
+    }
+
+    if (_pConfiguration->IsJitProfilingEnabled())
+    {
+        _pJitCompilationProvider = RegisterService<JitCompilationProvider>(_pCorProfilerInfo, _pFrameStore.get(), pRuntimeIdStore);
+    }
+
+    if ((_pAllocationsProvider != nullptr) || (_pContentionProvider != nullptr) || (_pGarbageCollectionProvider != nullptr))
+    {
+        _pClrEventsParser = std::make_unique<ClrEventsParser>(_pAllocationsProvider, _pContentionProvider, _pGarbageCollectionProvider);
+    }
+
     _pStackSamplerLoopManager = RegisterService<StackSamplerLoopManager>(
         _pCorProfilerInfo,
         _pConfiguration.get(),
@@ -144,7 +214,8 @@ bool CorProfilerCallback::InitializeServices()
         _pThreadsCpuManager,
         _pManagedThreadList,
         _pWallTimeProvider,
-        _pCpuTimeProvider);
+        _pCpuTimeProvider,
+        _pGarbageCollectionProvider);
 
     _pApplicationStore = RegisterService<ApplicationStore>(_pConfiguration.get());
 
@@ -164,6 +235,31 @@ bool CorProfilerCallback::InitializeServices()
         _pSamplesAggregator->Register(_pExceptionsProvider);
     }
 
+    if (_pConfiguration->IsAllocationProfilingEnabled())
+    {
+        _pSamplesAggregator->Register(_pAllocationsProvider);
+    }
+
+    if (_pConfiguration->IsContentionProfilingEnabled())
+    {
+        _pSamplesAggregator->Register(_pContentionProvider);
+    }
+
+    if (_pConfiguration->IsGarbageCollectionProfilingEnabled())
+    {
+        _pSamplesAggregator->Register(_pGarbageCollectionProvider);
+    }
+
+    if (_pConfiguration->IsJitProfilingEnabled())
+    {
+        _pSamplesAggregator->Register(_pJitCompilationProvider);
+    }
+
+    if (_pLiveObjectsProvider != nullptr)
+    {
+        _pSamplesAggregator->RegisterSnapshotProvider(_pLiveObjectsProvider);
+    }
+
     auto started = StartServices();
     if (!started)
     {
@@ -207,12 +303,23 @@ bool CorProfilerCallback::DisposeServices()
     // keep loader as static singleton for now
     shared::Loader::DeleteSingletonInstance();
 
+    // the parser and the providers are still reachable from the CLR callbacks (i.e. EventPipe events):
+    // reset them before the providers are destroyed
+    _pClrEventsParser = nullptr;
+    _pAllocationsProvider = nullptr;
+    _pContentionProvider = nullptr;
+    _pGarbageCollectionProvider = nullptr;
+    _pLiveObjectsProvider = nullptr;
+    _pJitCompilationProvider = nullptr;
+
     _services.clear();
 
     _pThreadsCpuManager = nullptr;
     _pStackSamplerLoopManager = nullptr;
     _pManagedThreadList = nullptr;
     _pApplicationStore = nullptr;
+    _pEndpointStore = nullptr;
+    _pThreadLabelsStore = nullptr;
 
     return result;
 }
@@ -274,6 +381,20 @@ void CorProfilerCallback::DisposeInternal(void)
             _pCorProfilerInfo = nullptr;
         }
 
+        ICorProfilerInfo12* pCorProfilerInfoEvents = _pCorProfilerInfoEvents;
+        if (pCorProfilerInfoEvents != nullptr)
+        {
+            pCorProfilerInfoEvents->Release();
+            _pCorProfilerInfoEvents = nullptr;
+        }
+
+        ICorProfilerInfo13* pCorProfilerInfoLiveHeap = _pCorProfilerInfoLiveHeap;
+        if (pCorProfilerInfoLiveHeap != nullptr)
+        {
+            pCorProfilerInfoLiveHeap->Release();
+            _pCorProfilerInfoLiveHeap = nullptr;
+        }
+
         // So we are about to turn off the Native Profiler Engine.
         // We signaled that to the anyone who is interested (e.g. the TraceContextTracking library) using ProfilerEngineStatus::WriteIsProfilerEngineActive(..),
         // which included flushing thread buffers. However, it is possible that a reader of ProfilerEngineStatus::GetReadPtrIsProfilerEngineActive()
@@ -629,11 +750,76 @@ HRESULT STDMETHODCALLTYPE CorProfilerCallback::Initialize(IUnknown* corProfilerI
         eventMask |= COR_PRF_MONITOR_EXCEPTIONS;
     }
 
-    hr = _pCorProfilerInfo->SetEventMask(eventMask);
-    if (FAILED(hr))
+    if (_pClrEventsParser != nullptr)
     {
-        Log::Error("SetEventMask(0x", std::hex, eventMask, ") returned an unexpected result: 0x", std::hex, hr, std::dec, ".");
-        return E_FAIL;
+        // AllocationTick, Contention and GCStart events are received through an in-process EventPipe session (.NET 5+ only)
+        hr = corProfilerInfoUnk->QueryInterface(__uuidof(ICorProfilerInfo12), (void**)&_pCorProfilerInfoEvents);
+        if (FAILED(hr))
+        {
+            Log::Warn("Allocation and lock contention profiling (and the detailed garbage collection reasons) are not supported by this runtime: ICorProfilerInfo12 (.NET 5+) is required.");
+            _pCorProfilerInfoEvents = nullptr;
+        }
+    }
+
+    if (_pJitCompilationProvider != nullptr)
+    {
+        eventMask |= COR_PRF_MONITOR_JIT_COMPILATION;
+    }
+
+    DWORD highEventMask = 0;
+
+    if (_pCorProfilerInfoEvents != nullptr)
+    {
+        highEventMask |= COR_PRF_HIGH_MONITOR_EVENT_PIPE;
+    }
+
+    if (_pGarbageCollectionProvider != nullptr)
+    {
+        eventMask |= COR_PRF_MONITOR_SUSPENDS;
+    }
+
+    if ((_pGarbageCollectionProvider != nullptr) || (_pLiveObjectsProvider != nullptr))
+    {
+        // COR_PRF_HIGH_BASIC_GC only provides GarbageCollectionStarted/Finished:
+        // unlike COR_PRF_MONITOR_GC, the GC does not have to report all moved/surviving references
+        highEventMask |= COR_PRF_HIGH_BASIC_GC;
+    }
+
+    ICorProfilerInfo5* pCorProfilerInfo5 = nullptr;
+    if (highEventMask != 0)
+    {
+        hr = _pCorProfilerInfo->QueryInterface(__uuidof(ICorProfilerInfo5), (void**)&pCorProfilerInfo5);
+        if (FAILED(hr))
+        {
+            // the runtime suspensions are still monitored but without the garbage collections details
+            Log::Warn("Garbage collections are not monitored by this runtime: ICorProfilerInfo5 (.NET Framework 4.6+) is required.");
+            pCorProfilerInfo5 = nullptr;
+        }
+    }
+
+    if (pCorProfilerInfo5 != nullptr)
+    {
+        hr = pCorProfilerInfo5->SetEventMask2(eventMask, highEventMask);
+        pCorProfilerInfo5->Release();
+        if (FAILED(hr))
+        {
+            Log::Error("SetEventMask2(0x", std::hex, eventMask, ", 0x", highEventMask, ") returned an unexpected result: 0x", std::hex, hr, std::dec, ".");
+            return E_FAIL;
+        }
+    }
+    else
+    {
+        hr = _pCorProfilerInfo->SetEventMask(eventMask);
+        if (FAILED(hr))
+        {
+            Log::Error("SetEventMask(0x", std::hex, eventMask, ") returned an unexpected result: 0x", std::hex, hr, std::dec, ".");
+            return E_FAIL;
+        }
+    }
+
+    if (_pCorProfilerInfoEvents != nullptr)
+    {
+        StartEventPipeSession();
     }
 
     // Initialization complete:
@@ -643,6 +829,39 @@ HRESULT STDMETHODCALLTYPE CorProfilerCallback::Initialize(IUnknown* corProfilerI
     return S_OK;
 }
 
+bool CorProfilerCallback::StartEventPipeSession()
+{
+    std::uint64_t keywords = 0;
+    if ((_pAllocationsProvider != nullptr) || (_pGarbageCollectionProvider != nullptr))
+    {
+        keywords |= ClrEventsParser::KEYWORD_GC;
+    }
+    if (_pContentionProvider != nullptr)
+    {
+        keywords |= ClrEventsParser::KEYWORD_CONTENTION;
+    }
+
+    // AllocationTick is verbose but GCStart is informational: avoid the cost of the AllocationTick events
+    // when only the garbage collections are monitored (Contention events are informational too)
+    std::uint32_t level = (_pAllocationsProvider != nullptr) ? ClrEventsParser::LEVEL_VERBOSE : ClrEventsParser::LEVEL_INFORMATIONAL;
+
+    COR_PRF_EVENTPIPE_PROVIDER_CONFIG providers[] =
+    {
+        {ClrEventsParser::RuntimeProviderName, keywords, level, nullptr}
+    };
+
+    // no rundown is needed: the events are only used to sample allocations and lock contentions and to get the garbage collection reasons
+    HRESULT hr = _pCorProfilerInfoEvents->EventPipeStartSession(sizeof(providers) / sizeof(providers[0]), providers, false, &_session);
+    if (FAILED(hr))
+    {
+        _session = 0;
+        Log::Error("Failed to start the EventPipe session for allocation, lock contention and garbage collection profiling: 0x", std::hex, hr, std::dec, ".");
+        return false;
+    }
+
+    return true;
+}
+
 HRESULT STDMETHODCALLTYPE CorProfilerCallback::Shutdown(void)
 {
     Log::Info("CorProfilerCallback::Shutdown()");
@@ -662,6 +881,19 @@ HRESULT STDMETHODCALLTYPE CorProfilerCallback::Shutdown(void)
     {
         _pExceptionsProvider->Stop();
     }
+    if (_session != 0)
+    {
+        _pCorProfilerInfoEvents->EventPipeStopSession(_session);
+        _session = 0;
+    }
+    if (_pAllocationsProvider != nullptr)
+    {
+        _pAllocationsProvider->Stop();
+    }
+    if (_pContentionProvider != nullptr)
+    {
+        _pContentionProvider->Stop();
+    }
 
     // It is now time to aggregate the remaining samples and export the last .pprof
     _pSamplesAggregator->Stop();
@@ -780,11 +1012,33 @@ HRESULT STDMETHODCALLTYPE CorProfilerCallback::FunctionUnloadStarted(FunctionID
 
 HRESULT STDMETHODCALLTYPE CorProfilerCallback::JITCompilationStarted(FunctionID functionId, BOOL fIsSafeToBlock)
 {
+    if (false == _isInitialized.load())
+    {
+        // If this CorProfilerCallback has not yet initialized, or if it has already shut down, then this callback is a No-Op.
+        return S_OK;
+    }
+
+    if (_pJitCompilationProvider != nullptr)
+    {
+        _pJitCompilationProvider->OnJitCompilationStarted(functionId);
+    }
+
     return S_OK;
 }
 
 HRESULT STDMETHODCALLTYPE CorProfilerCallback::JITCompilationFinished(FunctionID functionId, HRESULT hrStatus, BOOL fIsSafeToBlock)
 {
+    if (false == _isInitialized.load())
+    {
+        // If this CorProfilerCallback has not yet initialized, or if it has already shut down, then this callback is a No-Op.
+        return S_OK;
+    }
+
+    if (_pJitCompilationProvider != nullptr)
+    {
+        _pJitCompilationProvider->OnJitCompilationFinished(functionId, hrStatus, fIsSafeToBlock, false);
+    }
+
     return S_OK;
 }
 
@@ -955,6 +1209,17 @@ HRESULT STDMETHODCALLTYPE CorProfilerCallback::ManagedToUnmanagedTransition(Func
 
 HRESULT STDMETHODCALLTYPE CorProfilerCallback::RuntimeSuspendStarted(COR_PRF_SUSPEND_REASON suspendReason)
 {
+    if (false == _isInitialized.load())
+    {
+        // If this CorProfilerCallback has not yet initialized, or if it has already shut down, then this callback is a No-Op.
+        return S_OK;
+    }
+
+    if (_pGarbageCollectionProvider != nullptr)
+    {
+        _pGarbageCollectionProvider->OnRuntimeSuspendStarted(suspendReason);
+    }
+
     return S_OK;
 }
 
@@ -965,6 +1230,17 @@ HRESULT STDMETHODCALLTYPE CorProfilerCallback::RuntimeSuspendFinished(void)
 
 HRESULT STDMETHODCALLTYPE CorProfilerCallback::RuntimeSuspendAborted(void)
 {
+    if (false == _isInitialized.load())
+    {
+        // If this CorProfilerCallback has not yet initialized, or if it has already shut down, then this callback is a No-Op.
+        return S_OK;
+    }
+
+    if (_pGarbageCollectionProvider != nullptr)
+    {
+        _pGarbageCollectionProvider->OnRuntimeSuspendAborted();
+    }
+
     return S_OK;
 }
 
@@ -975,6 +1251,17 @@ HRESULT STDMETHODCALLTYPE CorProfilerCallback::RuntimeResumeStarted(void)
 
 HRESULT STDMETHODCALLTYPE CorProfilerCallback::RuntimeResumeFinished(void)
 {
+    if (false == _isInitialized.load())
+    {
+        // If this CorProfilerCallback has not yet initialized, or if it has already shut down, then this callback is a No-Op.
+        return S_OK;
+    }
+
+    if (_pGarbageCollectionProvider != nullptr)
+    {
+        _pGarbageCollectionProvider->OnRuntimeResumeFinished();
+    }
+
     return S_OK;
 }
 
@@ -1116,6 +1403,22 @@ HRESULT STDMETHODCALLTYPE CorProfilerCallback::ExceptionCLRCatcherExecute(void)
 
 HRESULT STDMETHODCALLTYPE CorProfilerCallback::GarbageCollectionStarted(int cGenerations, BOOL generationCollected[], COR_PRF_GC_REASON reason)
 {
+    if (false == _isInitialized.load())
+    {
+        // If this CorProfilerCallback has not yet initialized, or if it has already shut down, then this callback is a No-Op.
+        return S_OK;
+    }
+
+    if (_pGarbageCollectionProvider != nullptr)
+    {
+        _pGarbageCollectionProvider->OnGarbageCollectionStarted(cGenerations, generationCollected, reason);
+    }
+
+    if (_pLiveObjectsProvider != nullptr)
+    {
+        _pLiveObjectsProvider->OnGarbageCollectionStarted();
+    }
+
     return S_OK;
 }
 
@@ -1126,6 +1429,17 @@ HRESULT STDMETHODCALLTYPE CorProfilerCallback::SurvivingReferences(ULONG cSurviv
 
 HRESULT STDMETHODCALLTYPE CorProfilerCallback::GarbageCollectionFinished(void)
 {
+    if (false == _isInitialized.load())
+    {
+        // If this CorProfilerCallback has not yet initialized, or if it has already shut down, then this callback is a No-Op.
+        return S_OK;
+    }
+
+    if (_pGarbageCollectionProvider != nullptr)
+    {
+        _pGarbageCollectionProvider->OnGarbageCollectionFinished();
+    }
+
     return S_OK;
 }
 
@@ -1166,6 +1480,17 @@ HRESULT STDMETHODCALLTYPE CorProfilerCallback::ProfilerDetachSucceeded(void)
 
 HRESULT STDMETHODCALLTYPE CorProfilerCallback::ReJITCompilationStarted(FunctionID functionId, ReJITID rejitId, BOOL fIsSafeToBlock)
 {
+    if (false == _isInitialized.load())
+    {
+        // If this CorProfilerCallback has not yet initialized, or if it has already shut down, then this callback is a No-Op.
+        return S_OK;
+    }
+
+    if (_pJitCompilationProvider != nullptr)
+    {
+        _pJitCompilationProvider->OnJitCompilationStarted(functionId);
+    }
+
     return S_OK;
 }
 
@@ -1176,6 +1501,17 @@ HRESULT STDMETHODCALLTYPE CorProfilerCallback::GetReJITParameters(ModuleID modul
 
 HRESULT STDMETHODCALLTYPE CorProfilerCallback::ReJITCompilationFinished(FunctionID functionId, ReJITID rejitId, HRESULT hrStatus, BOOL fIsSafeToBlock)
 {
+    if (false == _isInitialized.load())
+    {
+        // If this CorProfilerCallback has not yet initialized, or if it has already shut down, then this callback is a No-Op.
+        return S_OK;
+    }
+
+    if (_pJitCompilationProvider != nullptr)
+    {
+        _pJitCompilationProvider->OnJitCompilationFinished(functionId, hrStatus, fIsSafeToBlock, true);
+    }
+
     return S_OK;
 }
 
@@ -1236,6 +1572,17 @@ HRESULT STDMETHODCALLTYPE CorProfilerCallback::EventPipeEventDelivered(EVENTPIPE
                                                                        ULONG numStackFrames,
                                                                        UINT_PTR stackFrames[])
 {
+    if (false == _isInitialized.load())
+    {
+        // If this CorProfilerCallback has not yet initialized, or if it has already shut down, then this callback is a No-Op.
+        return S_OK;
+    }
+
+    if (_pClrEventsParser != nullptr)
+    {
+        _pClrEventsParser->ParseEvent(eventId, eventVersion, cbEventData, eventData);
+    }
+
     return S_OK;
 }
 
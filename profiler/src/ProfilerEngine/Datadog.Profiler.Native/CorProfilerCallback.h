@@ -8,14 +8,22 @@
 #include "corprof.h"
 // end
 
+#include "AllocationsProvider.h"
 #include "ApplicationStore.h"
+#include "ClrEventsParser.h"
+#include "ContentionProvider.h"
+#include "GarbageCollectionProvider.h"
 #include "ExceptionsProvider.h"
 #include "IAppDomainStore.h"
 #include "IClrLifetime.h"
 #include "IConfiguration.h"
+#include "IEndpointStore.h"
 #include "IExporter.h"
+#include "JitCompilationProvider.h"
 #include "IFrameStore.h"
 #include "IMetricsSender.h"
+#include "IThreadLabelsStore.h"
+#include "LiveObjectsProvider.h"
 #include "WallTimeProvider.h"
 #include "CpuTimeProvider.h"
 #include "shared/src/native-src/string.h"
@@ -176,6 +184,8 @@ public:
     IManagedThreadList* GetManagedThreadList() { return _pManagedThreadList; }
     IStackSamplerLoopManager* GetStackSamplerLoopManager() { return _pStackSamplerLoopManager; }
     IApplicationStore* GetApplicationStore() { return _pApplicationStore; }
+    IEndpointStore* GetEndpointStore() { return _pEndpointStore; }
+    IThreadLabelsStore* GetThreadLabelsStore() { return _pThreadLabelsStore; }
 
 private :
     static CorProfilerCallback* _this;
@@ -183,6 +193,9 @@ private :
 
     std::atomic<ULONG> _refCount{0};
     ICorProfilerInfo4* _pCorProfilerInfo = nullptr;
+    ICorProfilerInfo12* _pCorProfilerInfoEvents = nullptr;
+    ICorProfilerInfo13* _pCorProfilerInfoLiveHeap = nullptr;
+    EVENTPIPE_SESSION _session{0};
     inline static bool _isNet46OrGreater = false;
     std::shared_ptr<IMetricsSender> _metricsSender;
     std::atomic<bool> _isInitialized{false}; // pay attention to keeping ProfilerEngineStatus::IsProfilerEngiveActive in sync with this!
@@ -193,9 +206,16 @@ private :
     IStackSamplerLoopManager* _pStackSamplerLoopManager = nullptr;
     IManagedThreadList* _pManagedThreadList = nullptr;
     IApplicationStore* _pApplicationStore = nullptr;
+    IEndpointStore* _pEndpointStore = nullptr;
+    IThreadLabelsStore* _pThreadLabelsStore = nullptr;
     ExceptionsProvider* _pExceptionsProvider = nullptr;
     WallTimeProvider* _pWallTimeProvider = nullptr;
     CpuTimeProvider* _pCpuTimeProvider = nullptr;
+    AllocationsProvider* _pAllocationsProvider = nullptr;
+    ContentionProvider* _pContentionProvider = nullptr;
+    GarbageCollectionProvider* _pGarbageCollectionProvider = nullptr;
+    LiveObjectsProvider* _pLiveObjectsProvider = nullptr;
+    JitCompilationProvider* _pJitCompilationProvider = nullptr;
     SamplesAggregator* _pSamplesAggregator = nullptr;
 
     std::vector<std::unique_ptr<IService>> _services;
@@ -204,6 +224,7 @@ private :
     std::unique_ptr<IConfiguration> _pConfiguration = nullptr;
     std::unique_ptr<IAppDomainStore> _pAppDomainStore = nullptr;
     std::unique_ptr<IFrameStore> _pFrameStore = nullptr;
+    std::unique_ptr<ClrEventsParser> _pClrEventsParser = nullptr;
 
 private:
     static void ConfigureDebugLog();
@@ -217,6 +238,7 @@ private:
     bool DisposeServices();
     bool StartServices();
     bool StopServices();
+    bool StartEventPipeSession();
 
 
     template <class T, typename... ArgTypes>
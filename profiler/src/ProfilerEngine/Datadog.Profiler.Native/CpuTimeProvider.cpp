@@ -5,18 +5,24 @@
 
 #include "IAppDomainStore.h"
 #include "IConfiguration.h"
+#include "IEndpointStore.h"
 #include "IFrameStore.h"
 #include "IRuntimeIdStore.h"
+#include "IThreadLabelsStore.h"
 #include "RawCpuSample.h"
 
 CpuTimeProvider::CpuTimeProvider(
     IThreadsCpuManager* pThreadsCpuManager,
     IFrameStore* pFrameStore,
     IAppDomainStore* pAppDomainStore,
-    IRuntimeIdStore* pRuntimeIdStore
+    IRuntimeIdStore* pRuntimeIdStore,
+    IEndpointStore* pEndpointStore,
+    IThreadLabelsStore* pThreadLabelsStore
     )
     :
-    CollectorBase<RawCpuSample>("CpuTimeProvider", pThreadsCpuManager, pFrameStore, pAppDomainStore, pRuntimeIdStore)
+    CollectorBase<RawCpuSample>("CpuTimeProvider", pThreadsCpuManager, pFrameStore, pAppDomainStore, pRuntimeIdStore),
+    _pEndpointStore{pEndpointStore},
+    _pThreadLabelsStore{pThreadLabelsStore}
 {
 }
 
@@ -24,5 +30,15 @@ CpuTimeProvider::CpuTimeProvider(
 void CpuTimeProvider::OnTransformRawSample(const RawCpuSample& rawSample, Sample& sample)
 {
     // from milliseconds to nanoseconds
-    sample.AddValue(rawSample.Duration * 1000000, SampleValue::CpuTimeDuration);
+    auto duration = rawSample.Duration * 1000000;
+    sample.AddValue(duration, SampleValue::CpuTimeDuration);
+
+    std::string endpoint;
+    if ((_pEndpointStore != nullptr) && _pEndpointStore->GetEndpoint(rawSample.EndpointId, endpoint))
+    {
+        sample.AddLabel(Label(Sample::EndpointLabel, std::move(endpoint)));
+        _pEndpointStore->AddCpuTime(rawSample.EndpointId, duration);
+    }
+
+    SetThreadLabels(_pThreadLabelsStore, rawSample, sample);
 }
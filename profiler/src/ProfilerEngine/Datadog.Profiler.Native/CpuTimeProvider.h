@@ -15,6 +15,8 @@ class IConfiguration;
 class IFrameStore;
 class IAppDomainStore;
 class IRuntimeIdStore;
+class IEndpointStore;
+class IThreadLabelsStore;
 
 
 class CpuTimeProvider
@@ -26,9 +28,15 @@ public:
         IThreadsCpuManager* pThreadsCpuManager,
         IFrameStore* pFrameStore,
         IAppDomainStore* pAssemblyStore,
-        IRuntimeIdStore* pRuntimeIdStore
+        IRuntimeIdStore* pRuntimeIdStore,
+        IEndpointStore* pEndpointStore,
+        IThreadLabelsStore* pThreadLabelsStore
         );
 
 protected:
     virtual void OnTransformRawSample(const RawCpuSample& rawSample, Sample& sample) override;
+
+private:
+    IEndpointStore* _pEndpointStore;
+    IThreadLabelsStore* _pThreadLabelsStore;
 };
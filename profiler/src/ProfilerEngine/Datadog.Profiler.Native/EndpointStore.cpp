@@ -0,0 +1,113 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "EndpointStore.h"
+
+#include "Log.h"
+
+#include <algorithm>
+
+std::uint64_t EndpointStore::Register(const std::string& endpoint)
+{
+    std::lock_guard lock(_endpointsLock);
+
+    auto it = _endpointIds.find(endpoint);
+    if (it != _endpointIds.end())
+    {
+        return it->second;
+    }
+
+    if (_endpoints.size() >= MaxEndpoints)
+    {
+        if (!_isFullLogged)
+        {
+            _isFullLogged = true;
+            Log::Warn("More than ", MaxEndpoints, " endpoints were registered: new endpoints are ignored.");
+        }
+
+        return 0;
+    }
+
+    _endpoints.push_back({endpoint, 0, 0});
+    auto endpointId = static_cast<std::uint64_t>(_endpoints.size());
+    _endpointIds.emplace(endpoint, endpointId);
+
+    return endpointId;
+}
+
+bool EndpointStore::GetEndpoint(std::uint64_t endpointId, std::string& endpoint)
+{
+    std::lock_guard lock(_endpointsLock);
+
+    if ((endpointId == 0) || (endpointId > _endpoints.size()))
+    {
+        return false;
+    }
+
+    endpoint = _endpoints[endpointId - 1].Name;
+    return true;
+}
+
+void EndpointStore::AddWallTime(std::uint64_t endpointId, std::int64_t durationNs)
+{
+    std::lock_guard lock(_endpointsLock);
+
+    if ((endpointId != 0) && (endpointId <= _endpoints.size()))
+    {
+        _endpoints[endpointId - 1].WallTime += durationNs;
+    }
+}
+
+void EndpointStore::AddCpuTime(std::uint64_t endpointId, std::int64_t durationNs)
+{
+    std::lock_guard lock(_endpointsLock);
+
+    if ((endpointId != 0) && (endpointId <= _endpoints.size()))
+    {
+        _endpoints[endpointId - 1].CpuTime += durationNs;
+    }
+}
+
+const char* EndpointStore::GetName()
+{
+    return _serviceName;
+}
+
+bool EndpointStore::Start()
+{
+    // nothing special to start
+    return true;
+}
+
+bool EndpointStore::Stop()
+{
+    LogCosts();
+    return true;
+}
+
+void EndpointStore::LogCosts()
+{
+    static constexpr std::size_t MaxLoggedEndpoints = 10;
+
+    std::vector<EndpointInfo> endpoints;
+    {
+        std::lock_guard lock(_endpointsLock);
+        endpoints = _endpoints;
+    }
+
+    if (endpoints.empty())
+    {
+        return;
+    }
+
+    std::sort(endpoints.begin(), endpoints.end(), [](EndpointInfo const& left, EndpointInfo const& right) {
+        return left.CpuTime > right.CpuTime;
+    });
+
+    Log::Info(endpoints.size(), " endpoints were seen. Most expensive ones (sampled cpu / wall time):");
+    for (std::size_t i = 0; i < std::min(endpoints.size(), MaxLoggedEndpoints); i++)
+    {
+        auto const& endpoint = endpoints[i];
+        Log::Info("   ", endpoint.Name, ": ", endpoint.CpuTime / 1000000, " ms / ", endpoint.WallTime / 1000000, " ms");
+    }
+}
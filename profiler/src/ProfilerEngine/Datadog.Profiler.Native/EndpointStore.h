@@ -0,0 +1,51 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+#include "IEndpointStore.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// Interns the endpoints (i.e. resource names of the local root spans) published by the tracer
+/// so that only a small id is written in the per-thread trace context, and keeps the wall and
+/// cpu time sampled for each endpoint
+/// </summary>
+class EndpointStore : public IEndpointStore
+{
+public:
+    EndpointStore() = default;
+
+    std::uint64_t Register(const std::string& endpoint) override;
+    bool GetEndpoint(std::uint64_t endpointId, std::string& endpoint) override;
+    void AddWallTime(std::uint64_t endpointId, std::int64_t durationNs) override;
+    void AddCpuTime(std::uint64_t endpointId, std::int64_t durationNs) override;
+
+    const char* GetName() override;
+    bool Start() override;
+    bool Stop() override;
+
+public:
+    // the endpoints are low cardinality by design: a runaway resource naming should not grow the store forever
+    static constexpr std::size_t MaxEndpoints = 1024;
+
+private:
+    struct EndpointInfo
+    {
+        std::string Name;
+        std::int64_t WallTime;  // in nanoseconds
+        std::int64_t CpuTime;   // in nanoseconds
+    };
+
+    void LogCosts();
+
+private:
+    const char* _serviceName = "EndpointStore";
+
+    std::mutex _endpointsLock;
+    std::vector<EndpointInfo> _endpoints;  // id = index + 1
+    std::unordered_map<std::string, std::uint64_t> _endpointIds;
+    bool _isFullLogged = false;
+};
@@ -28,9 +28,22 @@ public:
     inline static const shared::WSTRING CpuProfilingEnabled         = WStr("DD_PROFILING_CPU_ENABLED");
     inline static const shared::WSTRING ExceptionProfilingEnabled   = WStr("DD_PROFILING_EXCEPTION_ENABLED");
     inline static const shared::WSTRING ExceptionSampleLimit        = WStr("DD_PROFILING_EXCEPTION_SAMPLE_LIMIT");
+    inline static const shared::WSTRING TimelineEnabled             = WStr("DD_PROFILING_TIMELINE_ENABLED");
     inline static const shared::WSTRING ProfilesOutputDir           = WStr("DD_INTERNAL_PROFILING_OUTPUT_DIR");
     inline static const shared::WSTRING DevelopmentConfiguration    = WStr("DD_INTERNAL_USE_DEVELOPMENT_CONFIGURATION");
     inline static const shared::WSTRING Agentless                   = WStr("DD_PROFILING_AGENTLESS");
+    inline static const shared::WSTRING ExceptionMessageMaxLength   = WStr("DD_PROFILING_EXCEPTION_MESSAGE_MAX_LENGTH");
+    inline static const shared::WSTRING ExceptionMessageNormalizationEnabled = WStr("DD_PROFILING_EXCEPTION_MESSAGE_NORMALIZATION_ENABLED");
+    inline static const shared::WSTRING AllocationProfilingEnabled           = WStr("DD_PROFILING_ALLOCATION_ENABLED");
+    inline static const shared::WSTRING AllocationSampleLimit                = WStr("DD_PROFILING_ALLOCATION_SAMPLE_LIMIT");
+    inline static const shared::WSTRING ContentionProfilingEnabled           = WStr("DD_PROFILING_LOCK_ENABLED");
+    inline static const shared::WSTRING ContentionSampleLimit                = WStr("DD_PROFILING_LOCK_SAMPLE_LIMIT");
+    inline static const shared::WSTRING GarbageCollectionProfilingEnabled    = WStr("DD_PROFILING_GC_ENABLED");
+    inline static const shared::WSTRING HeapProfilingEnabled                 = WStr("DD_PROFILING_HEAP_ENABLED");
+    inline static const shared::WSTRING NativeThreadsProfilingEnabled        = WStr("DD_PROFILING_NATIVE_THREADS_ENABLED");
+    inline static const shared::WSTRING JitProfilingEnabled                  = WStr("DD_PROFILING_JIT_ENABLED");
+    inline static const shared::WSTRING BurstSamplingThreshold               = WStr("DD_PROFILING_BURST_SAMPLING_THRESHOLD");
+    inline static const shared::WSTRING BurstSamplingDuration                = WStr("DD_PROFILING_BURST_SAMPLING_DURATION");
 
     // feature flags
     inline static const shared::WSTRING FF_LibddprofEnabled = WStr("DD_INTERNAL_PROFILING_LIBDDPROF_ENABLED");
@@ -0,0 +1,131 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "ExceptionMessagesCache.h"
+
+#include "shared/src/native-src/string.h"
+
+#include <cctype>
+
+ExceptionMessagesCache::ExceptionMessagesCache(std::size_t maxLength, bool isNormalizationEnabled) :
+    _maxLength{maxLength},
+    _isNormalizationEnabled{isNormalizationEnabled},
+    _stats{}
+{
+}
+
+std::shared_ptr<const std::string> ExceptionMessagesCache::Intern(const WCHAR* message, std::size_t length)
+{
+    // truncate before the UTF-16 --> UTF-8 conversion: kilobytes long messages are not converted
+    auto isTruncated = (_maxLength != 0) && (length > _maxLength);
+    if (isTruncated)
+    {
+        length = _maxLength;
+
+        // don't cut a surrogate pair in the middle
+        if ((message[length - 1] >= 0xD800) && (message[length - 1] <= 0xDBFF))
+        {
+            length--;
+        }
+    }
+
+    auto text = shared::ToString(message, length);
+    if (isTruncated)
+    {
+        text += TruncationSuffix;
+    }
+
+    if (_isNormalizationEnabled)
+    {
+        text = Normalize(text);
+    }
+
+    std::lock_guard<std::mutex> lock(_messagesLock);
+
+    _stats.MessagesCount++;
+    _stats.CapturedBytes += text.size();
+
+    auto it = _messages.find(text);
+    if (it != _messages.end())
+    {
+        return it->second;
+    }
+
+    auto interned = std::make_shared<const std::string>(std::move(text));
+    _messages.emplace(*interned, interned);
+
+    _stats.UniqueMessagesCount++;
+    _stats.StoredBytes += interned->size();
+
+    return interned;
+}
+
+ExceptionMessagesCache::Stats ExceptionMessagesCache::Reset()
+{
+    std::lock_guard<std::mutex> lock(_messagesLock);
+
+    auto stats = _stats;
+    _stats = {};
+    _messages.clear();
+
+    return stats;
+}
+
+std::string ExceptionMessagesCache::Normalize(std::string_view message)
+{
+    std::string normalized;
+    normalized.reserve(message.size());
+
+    std::size_t i = 0;
+    while (i < message.size())
+    {
+        if (IsGuid(message.substr(i)))
+        {
+            normalized += GuidPlaceholder;
+            i += 36;
+            continue;
+        }
+
+        if (std::isdigit(static_cast<unsigned char>(message[i])))
+        {
+            // the whole number is replaced
+            while ((i < message.size()) && std::isdigit(static_cast<unsigned char>(message[i])))
+            {
+                i++;
+            }
+            normalized += NumberPlaceholder;
+            continue;
+        }
+
+        normalized += message[i];
+        i++;
+    }
+
+    return normalized;
+}
+
+bool ExceptionMessagesCache::IsGuid(std::string_view text)
+{
+    // xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx
+    if (text.size() < 36)
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < 36; i++)
+    {
+        if ((i == 8) || (i == 13) || (i == 18) || (i == 23))
+        {
+            if (text[i] != '-')
+            {
+                return false;
+            }
+        }
+        else if (!std::isxdigit(static_cast<unsigned char>(text[i])))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
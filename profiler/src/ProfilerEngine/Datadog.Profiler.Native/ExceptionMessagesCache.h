@@ -0,0 +1,57 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "cor.h"
+
+// Applies the exception message policy and interns the resulting messages:
+//  - messages are truncated to a maximum number of characters before being converted to UTF-8
+//  - numbers and GUIDs can optionally be replaced by placeholders so that messages that only
+//    differ by embedded ids are stored once
+//  - identical messages share the same string
+class ExceptionMessagesCache
+{
+public:
+    struct Stats
+    {
+        std::uint64_t MessagesCount; // number of interned messages
+        std::uint64_t UniqueMessagesCount;
+        std::uint64_t CapturedBytes; // size of the messages without interning
+        std::uint64_t StoredBytes;   // size of the unique messages
+    };
+
+public:
+    ExceptionMessagesCache(std::size_t maxLength, bool isNormalizationEnabled);
+
+    std::shared_ptr<const std::string> Intern(const WCHAR* message, std::size_t length);
+
+    // returns the statistics since the last reset and forget the messages interned so far:
+    // the strings still referenced by samples stay alive until these samples are released.
+    Stats Reset();
+
+    static std::string Normalize(std::string_view message);
+
+public:
+    inline static const std::string TruncationSuffix = "...";
+    inline static const std::string NumberPlaceholder = "#";
+    inline static const std::string GuidPlaceholder = "<guid>";
+
+private:
+    static bool IsGuid(std::string_view text);
+
+private:
+    std::size_t const _maxLength;
+    bool const _isNormalizationEnabled;
+
+    std::mutex _messagesLock;
+    std::unordered_map<std::string_view, std::shared_ptr<const std::string>> _messages;
+    Stats _stats;
+};
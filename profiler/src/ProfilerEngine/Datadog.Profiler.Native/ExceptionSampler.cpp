@@ -1,38 +1,45 @@
 #include "ExceptionSampler.h"
 
 ExceptionSampler::ExceptionSampler(const IConfiguration* configuration) :
-    _sampler(SamplingWindow, SamplesPerWindow(configuration), SamplingWindowsPerRecording(configuration), 16, [this] { RollWindow(); })
+    _sampler(SamplingWindow, SamplesPerWindow(configuration), SamplingWindowsPerRecording(configuration), 16, [this] { RollWindow(); }),
+    _lastSeenWindows(std::make_unique<std::atomic<std::uint64_t>[]>(ExceptionTypesCache::Capacity)),
+    _currentWindow(1)
 {
 }
 
 ExceptionSampler::ExceptionSampler(std::chrono::milliseconds windowDuration, int32_t samplesPerWindow, int32_t lookback) :
-    _sampler(windowDuration, samplesPerWindow, lookback, 16, [this] { RollWindow(); })
+    _sampler(windowDuration, samplesPerWindow, lookback, 16, [this] { RollWindow(); }),
+    _lastSeenWindows(std::make_unique<std::atomic<std::uint64_t>[]>(ExceptionTypesCache::Capacity)),
+    _currentWindow(1)
 {
 }
 
-bool ExceptionSampler::Sample(const std::string exceptionType)
+bool ExceptionSampler::Sample(std::uint32_t exceptionTypeId, double& samplingProbability)
 {
+    if (exceptionTypeId < ExceptionTypesCache::Capacity)
     {
-        std::unique_lock lock(_knownExceptionsMutex);
+        auto currentWindow = _currentWindow.load(std::memory_order_relaxed);
+        auto& lastSeenWindow = _lastSeenWindows[exceptionTypeId];
 
-        if (_knownExceptions.find(exceptionType) == _knownExceptions.end())
+        if ((lastSeenWindow.load(std::memory_order_relaxed) != currentWindow) &&
+            (lastSeenWindow.exchange(currentWindow, std::memory_order_relaxed) != currentWindow))
         {
             // This is the first time we see this exception in this time window,
             // force the sampling decision
-            _knownExceptions.insert(exceptionType);
-
+            samplingProbability = 1.0;
             return _sampler.Keep();
         }
     }
 
     // We've already seen this exception, let the sampler decide
+    samplingProbability = _sampler.GetProbability();
     return _sampler.Sample();
 }
 
 void ExceptionSampler::RollWindow()
 {
-    std::unique_lock lock(_knownExceptionsMutex);
-    _knownExceptions.clear();
+    // all exception types become unknown for the new window
+    _currentWindow.fetch_add(1, std::memory_order_relaxed);
 }
 
 int ExceptionSampler::SamplingWindowsPerRecording(const IConfiguration* configuration)
@@ -1,7 +1,9 @@
 #pragma once
-#include <unordered_set>
+#include <atomic>
+#include <memory>
 
 #include "AdaptiveSampler.h"
+#include "ExceptionTypesCache.h"
 #include "IConfiguration.h"
 
 class ExceptionSampler
@@ -10,14 +12,19 @@ public:
     explicit ExceptionSampler(const IConfiguration* configuration);
     ExceptionSampler(std::chrono::milliseconds windowDuration, int32_t samplesPerWindow, int32_t lookback);
 
-    bool Sample(std::string exceptionType);
+    // exceptionTypeId is the interned id of the exception type (see ExceptionTypesCache)
+    // samplingProbability is set to the probability used for the sampling decision
+    bool Sample(std::uint32_t exceptionTypeId, double& samplingProbability);
 
 private:
     static constexpr inline std::chrono::milliseconds SamplingWindow = std::chrono::milliseconds(500);
 
     AdaptiveSampler _sampler;
-    std::unordered_set<std::string> _knownExceptions;
-    std::mutex _knownExceptionsMutex;
+
+    // For each exception type id, the last window in which the type was seen:
+    // the type is "known" if it is the current window. Rolling the window does not need to clear anything.
+    std::unique_ptr<std::atomic<std::uint64_t>[]> _lastSeenWindows;
+    std::atomic<std::uint64_t> _currentWindow;
 
     void RollWindow();
     int SamplingWindowsPerRecording(const IConfiguration* configuration);
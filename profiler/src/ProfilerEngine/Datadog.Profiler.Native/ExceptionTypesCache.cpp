@@ -0,0 +1,114 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "ExceptionTypesCache.h"
+
+#include "Log.h"
+
+ExceptionTypesCache::ExceptionTypesCache() :
+    _slots{std::make_unique<Slot[]>(Capacity)},
+    _isFullLogged{false}
+{
+    for (std::size_t i = 0; i < Capacity; i++)
+    {
+        _slots[i].Key.store(0, std::memory_order_relaxed);
+        _slots[i].Value.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+ExceptionType const* ExceptionTypesCache::Find(ClassID classId) const
+{
+    auto index = GetSlotIndex(classId);
+
+    // linear probing: stop at the first empty slot
+    for (std::size_t i = 0; i < Capacity; i++)
+    {
+        auto const& slot = _slots[(index + i) & (Capacity - 1)];
+
+        // the value is written before the key (with release semantic) by Add()
+        auto key = slot.Key.load(std::memory_order_acquire);
+        if (key == classId)
+        {
+            return slot.Value.load(std::memory_order_relaxed);
+        }
+
+        if (key == 0)
+        {
+            return nullptr;
+        }
+    }
+
+    return nullptr;
+}
+
+ExceptionType const* ExceptionTypesCache::Add(ClassID classId, std::string const& name)
+{
+    std::lock_guard<std::mutex> lock(_writeLock);
+
+    // another thread might have added the same ClassID in the meantime
+    auto const* type = Find(classId);
+    if (type != nullptr)
+    {
+        return type;
+    }
+
+    auto typeByName = _typesByName.find(name);
+    if (typeByName != _typesByName.end())
+    {
+        type = typeByName->second;
+    }
+    else
+    {
+        _types.push_back(std::make_unique<ExceptionType>(ExceptionType{static_cast<std::uint32_t>(_types.size()), name}));
+        type = _types.back().get();
+        _typesByName[name] = type;
+    }
+
+    auto index = GetSlotIndex(classId);
+    for (std::size_t i = 0; i < Capacity; i++)
+    {
+        auto& slot = _slots[(index + i) & (Capacity - 1)];
+        if (slot.Key.load(std::memory_order_relaxed) == 0)
+        {
+            slot.Value.store(type, std::memory_order_relaxed);
+            slot.Key.store(classId, std::memory_order_release);
+            return type;
+        }
+    }
+
+    // The table is full: the type is still interned but this ClassID will go through the slow path next time
+    if (!_isFullLogged)
+    {
+        _isFullLogged = true;
+        Log::Warn("ExceptionTypesCache: more than ", Capacity, " exception types have been seen. Some of them will not be cached.");
+    }
+
+    return type;
+}
+
+std::size_t ExceptionTypesCache::GetTypesCount()
+{
+    std::lock_guard<std::mutex> lock(_writeLock);
+    return _types.size();
+}
+
+std::vector<ExceptionType const*> ExceptionTypesCache::GetTypes()
+{
+    std::lock_guard<std::mutex> lock(_writeLock);
+
+    std::vector<ExceptionType const*> types;
+    types.reserve(_types.size());
+    for (auto const& type : _types)
+    {
+        types.push_back(type.get());
+    }
+
+    return types;
+}
+
+std::size_t ExceptionTypesCache::GetSlotIndex(ClassID classId)
+{
+    // ClassIDs are (aligned) pointers: mix the bits to spread them over the slots
+    auto hash = static_cast<std::uint64_t>(classId) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<std::size_t>(hash >> 32) & (Capacity - 1);
+}
@@ -0,0 +1,68 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cor.h"
+#include "corprof.h"
+
+// Exception type name with an interned id: the same name always gets the same id,
+// even for different ClassIDs (i.e. same type loaded in several AppDomains)
+struct ExceptionType
+{
+    std::uint32_t Id;
+    std::string Name;
+};
+
+// Maps ClassID to interned exception types.
+// Lookups are lock-free: slots are only written once (under a lock) and never removed
+// so the cost on the exception hot path is a few atomic loads.
+class ExceptionTypesCache
+{
+public:
+    ExceptionTypesCache();
+
+    ExceptionTypesCache(ExceptionTypesCache const&) = delete;
+    ExceptionTypesCache& operator=(ExceptionTypesCache const&) = delete;
+
+    // returns nullptr if the given ClassID was never added
+    ExceptionType const* Find(ClassID classId) const;
+
+    // returns the (possibly already existing) interned type for the given ClassID
+    ExceptionType const* Add(ClassID classId, std::string const& name);
+
+    std::size_t GetTypesCount();
+
+    // returns all interned types, indexed by their id
+    std::vector<ExceptionType const*> GetTypes();
+
+public:
+    // must be a power of 2
+    static constexpr std::size_t Capacity = 4096;
+
+private:
+    struct Slot
+    {
+        std::atomic<ClassID> Key;
+        std::atomic<ExceptionType const*> Value;
+    };
+
+    static std::size_t GetSlotIndex(ClassID classId);
+
+private:
+    std::unique_ptr<Slot[]> _slots;
+
+    // the fields below are only accessed under _writeLock
+    std::mutex _writeLock;
+    std::unordered_map<std::string, ExceptionType const*> _typesByName;
+    std::vector<std::unique_ptr<ExceptionType>> _types;
+    bool _isFullLogged;
+};
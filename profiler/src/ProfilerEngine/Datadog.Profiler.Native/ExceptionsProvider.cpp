@@ -3,10 +3,15 @@
 #include "FrameStore.h"
 #include "HResultConverter.h"
 #include "Log.h"
+#include "OpSysTools.h"
 #include "OsSpecificApi.h"
 #include "shared/src/native-src/com_ptr.h"
 #include "shared/src/native-src/string.h"
 
+#include <cmath>
+
+std::shared_ptr<const std::string> const ExceptionsProvider::EmptyMessage = std::make_shared<const std::string>();
+
 #define INVOKE(x)                                                                                             \
     {                                                                                                         \
         HRESULT hr = x;                                                                                       \
@@ -30,13 +35,20 @@ ExceptionsProvider::ExceptionsProvider(
     _pCorProfilerInfo(pCorProfilerInfo),
     _pManagedThreadList(pManagedThreadList),
     _pFrameStore(pFrameStore),
+    _pRuntimeIdStore(pRuntimeIdStore),
     _messageFieldOffset(),
     _stringLengthOffset(0),
     _stringBufferOffset(0),
     _mscorlibModuleId(0),
     _exceptionClassId(0),
     _loggedMscorlibError(false),
-    _sampler(pConfiguration)
+    _exceptionMessages(std::max(pConfiguration->ExceptionMessageMaxLength(), 0), pConfiguration->IsExceptionMessageNormalizationEnabled()),
+    _messagesStatsPeriod(pConfiguration->GetUploadInterval()),
+    _nextMessagesStatsTime(std::chrono::steady_clock::now() + _messagesStatsPeriod),
+    _thrownCounts(std::make_unique<std::atomic<std::uint64_t>[]>(ExceptionTypesCache::Capacity)),
+    _lastAppDomains(std::make_unique<std::atomic<AppDomainID>[]>(ExceptionTypesCache::Capacity)),
+    _sampler(pConfiguration),
+    _stackFramesCollectors(pCorProfilerInfo)
 {
 }
 
@@ -92,25 +104,41 @@ bool ExceptionsProvider::OnExceptionThrown(ObjectID thrownObjectId)
 
     INVOKE(_pCorProfilerInfo->GetClassFromObject(thrownObjectId, &classId))
 
-    std::string name;
+    ExceptionType const* exceptionType;
 
-    if (!GetExceptionType(classId, name))
+    if (!GetExceptionType(classId, exceptionType))
     {
         return false;
     }
 
-    if (!_sampler.Sample(name))
+    // every exception is counted, sampled or not
+    if (exceptionType->Id < ExceptionTypesCache::Capacity)
+    {
+        // the AppDomain is only looked up the first time the type is counted so the count
+        // is not exported without a runtime id if the type is never sampled
+        if (_lastAppDomains[exceptionType->Id].load(std::memory_order_relaxed) == 0)
+        {
+            _lastAppDomains[exceptionType->Id].store(GetCurrentAppDomain(), std::memory_order_relaxed);
+        }
+
+        _thrownCounts[exceptionType->Id].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // the sampling decision only relies on the interned type id:
+    // nothing is allocated nor converted for exceptions that are not sampled
+    double samplingProbability;
+    if (!_sampler.Sample(exceptionType->Id, samplingProbability))
     {
         return true;
     }
 
     const auto messageAddress = *reinterpret_cast<UINT_PTR*>(thrownObjectId + _messageFieldOffset.ulOffset);
 
-    std::string message;
+    std::shared_ptr<const std::string> message;
 
     if (messageAddress == 0)
     {
-        message = std::string();
+        message = EmptyMessage;
     }
     else
     {
@@ -118,11 +146,12 @@ bool ExceptionsProvider::OnExceptionThrown(ObjectID thrownObjectId)
 
         if (stringLength == 0)
         {
-            message = std::string();
+            message = EmptyMessage;
         }
         else
         {
-            message = shared::ToString(reinterpret_cast<WCHAR*>(messageAddress + _stringBufferOffset), stringLength);
+            // the message policy (length cap, normalization) is applied before the message is stored
+            message = _exceptionMessages.Intern(reinterpret_cast<WCHAR*>(messageAddress + _stringBufferOffset), stringLength);
         }
     }
 
@@ -131,7 +160,9 @@ bool ExceptionsProvider::OnExceptionThrown(ObjectID thrownObjectId)
     INVOKE(_pManagedThreadList->TryGetCurrentThreadInfo(&threadInfo))
 
     uint32_t hrCollectStack = E_FAIL;
-    const auto pStackFramesCollector = OsSpecificApi::CreateNewStackFramesCollectorInstance(_pCorProfilerInfo);
+
+    // the collector (and the snapshot buffer pointed to by result) goes back to the pool when leaving the scope
+    const auto pStackFramesCollector = _stackFramesCollectors.Acquire();
 
     pStackFramesCollector->PrepareForNextCollection();
     const auto result = pStackFramesCollector->CollectStackSample(threadInfo, &hrCollectStack);
@@ -146,7 +177,7 @@ bool ExceptionsProvider::OnExceptionThrown(ObjectID thrownObjectId)
 
     RawExceptionSample rawSample;
 
-    rawSample.Timestamp = result->GetUnixTimeUtc();
+    rawSample.Timestamp = OpSysTools::GetUnixTimeMilliseconds();
     rawSample.LocalRootSpanId = result->GetLocalRootSpanId();
     rawSample.SpanId = result->GetSpanId();
     rawSample.AppDomainId = result->GetAppDomainId();
@@ -154,24 +185,26 @@ bool ExceptionsProvider::OnExceptionThrown(ObjectID thrownObjectId)
     rawSample.ThreadInfo = threadInfo;
     threadInfo->AddRef();
     rawSample.ExceptionMessage = std::move(message);
-    rawSample.ExceptionType = std::move(name);
+    rawSample.ExceptionType = exceptionType->Name;
+    rawSample.SamplingProbability = samplingProbability;
+
+    if (exceptionType->Id < ExceptionTypesCache::Capacity)
+    {
+        // the unsampled counts are attached to the runtime id of the AppDomain where the type was last sampled (or first thrown)
+        _lastAppDomains[exceptionType->Id].store(rawSample.AppDomainId, std::memory_order_relaxed);
+    }
     Add(std::move(rawSample));
 
     return true;
 }
 
-bool ExceptionsProvider::GetExceptionType(ClassID classId, std::string& exceptionType)
+bool ExceptionsProvider::GetExceptionType(ClassID classId, ExceptionType const*& exceptionType)
 {
+    // lock-free fast path
+    exceptionType = _exceptionTypes.Find(classId);
+    if (exceptionType != nullptr)
     {
-        std::lock_guard lock(_exceptionTypesLock);
-
-        const auto type = _exceptionTypes.find(classId);
-
-        if (type != _exceptionTypes.end())
-        {
-            exceptionType = type->second;
-            return true;
-        }
+        return true;
     }
 
     ModuleID moduleId;
@@ -194,23 +227,99 @@ bool ExceptionsProvider::GetExceptionType(ClassID classId, std::string& exceptio
     const auto pBuffer = buffer.get();
 
     // Convert from UTF16 to UTF8
-    exceptionType = shared::ToString(pBuffer, nameCharCount - 1);
-
-    {
-        std::lock_guard lock(_exceptionTypesLock);
-        _exceptionTypes.insert_or_assign(classId, exceptionType);
-    }
+    exceptionType = _exceptionTypes.Add(classId, shared::ToString(pBuffer, nameCharCount - 1));
 
     return true;
 }
 
 void ExceptionsProvider::OnTransformRawSample(const RawExceptionSample& rawSample, Sample& sample)
 {
+    auto upscaledCount = (rawSample.SamplingProbability > 0) ? std::llround(1 / rawSample.SamplingProbability) : 1;
+
     sample.AddValue(1, SampleValue::ExceptionCount);
-    sample.AddLabel(Label(Sample::ExceptionMessageLabel, rawSample.ExceptionMessage));
+    sample.AddValue(upscaledCount, SampleValue::ExceptionUpscaledCount);
+    sample.AddLabel(Label(Sample::ExceptionMessageLabel, *rawSample.ExceptionMessage));
     sample.AddLabel(Label(Sample::ExceptionTypeLabel, rawSample.ExceptionType));
 }
 
+std::list<Sample> ExceptionsProvider::GetSamples()
+{
+    auto samples = CollectorBase<RawExceptionSample>::GetSamples();
+
+    AddThrownExceptionsCounts(samples);
+    LogMessagesStats();
+
+    return samples;
+}
+
+void ExceptionsProvider::LogMessagesStats()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now < _nextMessagesStatsTime)
+    {
+        return;
+    }
+    _nextMessagesStatsTime = now + _messagesStatsPeriod;
+
+    // the interned messages are forgotten once per upload period to bound the memory consumption
+    auto stats = _exceptionMessages.Reset();
+    if (stats.MessagesCount == 0)
+    {
+        return;
+    }
+
+    Log::Debug("Exception messages: ", stats.UniqueMessagesCount, " unique out of ", stats.MessagesCount,
+               " (", stats.StoredBytes, " bytes stored instead of ", stats.CapturedBytes,
+               ": ", stats.CapturedBytes - stats.StoredBytes, " bytes saved)");
+}
+
+void ExceptionsProvider::AddThrownExceptionsCounts(std::list<Sample>& samples)
+{
+    auto timestamp = OpSysTools::GetUnixTimeMilliseconds();
+
+    for (auto const* exceptionType : _exceptionTypes.GetTypes())
+    {
+        if (exceptionType->Id >= ExceptionTypesCache::Capacity)
+        {
+            break;
+        }
+
+        auto count = _thrownCounts[exceptionType->Id].exchange(0, std::memory_order_relaxed);
+        if (count == 0)
+        {
+            continue;
+        }
+
+        auto appDomainId = _lastAppDomains[exceptionType->Id].load(std::memory_order_relaxed);
+        samples.push_back(CreateThrownExceptionsSample(timestamp, _pRuntimeIdStore->GetId(appDomainId), exceptionType->Name, count));
+    }
+}
+
+Sample ExceptionsProvider::CreateThrownExceptionsSample(std::uint64_t timestamp, std::string_view runtimeId, const std::string& exceptionType, std::uint64_t count)
+{
+    // no real callstack: these samples only carry the exact count for each exception type
+    Sample sample(timestamp, runtimeId);
+    sample.AddValue(static_cast<std::int64_t>(count), SampleValue::ExceptionThrownCount);
+    sample.AddLabel(Label(Sample::ExceptionTypeLabel, exceptionType));
+    sample.AddRuntimeFrame("Thrown Exceptions");
+
+    return sample;
+}
+
+AppDomainID ExceptionsProvider::GetCurrentAppDomain()
+{
+    // the exception is thrown on the current thread
+    ThreadID threadId;
+    AppDomainID appDomainId;
+    if (SUCCEEDED(_pCorProfilerInfo->GetCurrentThreadID(&threadId)) &&
+        SUCCEEDED(_pCorProfilerInfo->GetThreadAppDomain(threadId, &appDomainId)))
+    {
+        return appDomainId;
+    }
+
+    return 0;
+}
+
 bool ExceptionsProvider::LoadExceptionMetadata()
 {
     // This is the first observed exception, lazy-load the exception metadata
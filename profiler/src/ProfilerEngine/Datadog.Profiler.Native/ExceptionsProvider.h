@@ -6,8 +6,11 @@
 #include "RawExceptionSample.h"
 #include "cor.h"
 #include "corprof.h"
+#include "ExceptionMessagesCache.h"
 #include "ExceptionSampler.h"
+#include "ExceptionTypesCache.h"
 #include "OsSpecificApi.h"
+#include "StackFramesCollectorPool.h"
 #include "StackSnapshotResultReusableBuffer.h"
 
 class ExceptionsProvider
@@ -26,24 +29,42 @@ public:
     bool OnModuleLoaded(ModuleID moduleId);
     bool OnExceptionThrown(ObjectID exception);
 
+    // also returns the exact number of exceptions thrown per type since the last call
+    std::list<Sample> GetSamples() override;
+
+    static Sample CreateThrownExceptionsSample(std::uint64_t timestamp, std::string_view runtimeId, const std::string& exceptionType, std::uint64_t count);
+
 protected:
     void OnTransformRawSample(const RawExceptionSample& rawSample, Sample& sample) override;
 
 private:
     bool LoadExceptionMetadata();
-    bool GetExceptionType(ClassID classId, std::string& exceptionType);
+    bool GetExceptionType(ClassID classId, ExceptionType const*& exceptionType);
+    void AddThrownExceptionsCounts(std::list<Sample>& samples);
+    void LogMessagesStats();
+    AppDomainID GetCurrentAppDomain();
 
 private:
+    static std::shared_ptr<const std::string> const EmptyMessage;
+
     ICorProfilerInfo4* _pCorProfilerInfo;
     IManagedThreadList* _pManagedThreadList;
     IFrameStore* _pFrameStore;
+    IRuntimeIdStore* _pRuntimeIdStore;
     COR_FIELD_OFFSET _messageFieldOffset;
     ULONG _stringLengthOffset;
     ULONG _stringBufferOffset;
     ModuleID _mscorlibModuleId;
     ClassID _exceptionClassId;
     bool _loggedMscorlibError;
-    std::unordered_map<ClassID, std::string> _exceptionTypes;
-    std::mutex _exceptionTypesLock;
+    ExceptionTypesCache _exceptionTypes;
+    ExceptionMessagesCache _exceptionMessages;
+    std::chrono::seconds _messagesStatsPeriod;
+    std::chrono::steady_clock::time_point _nextMessagesStatsTime;
+
+    // unsampled count of thrown exceptions and last seen AppDomain, indexed by exception type id
+    std::unique_ptr<std::atomic<std::uint64_t>[]> _thrownCounts;
+    std::unique_ptr<std::atomic<AppDomainID>[]> _lastAppDomains;
     ExceptionSampler _sampler;
+    StackFramesCollectorPool _stackFramesCollectors;
 };
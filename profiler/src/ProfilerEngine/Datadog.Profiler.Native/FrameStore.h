@@ -33,6 +33,7 @@ public:
 
 public :
     std::tuple<bool, std::string, std::string> GetFrame(uintptr_t instructionPointer) override;
+    std::pair<std::string, std::string> GetManagedFrame(FunctionID functionId) override;
 
 private:
     bool GetFunctionInfo(
@@ -51,7 +52,6 @@ private:
         ClassID* genericParameters
         );
     bool GetTypeDesc(IMetaDataImport2* pMetadataImport, ClassID classId, ModuleID moduleId, mdTypeDef mdTokenType, TypeDesc& typeDesc);
-    std::pair <std::string, std::string> GetManagedFrame(FunctionID functionId);
     std::pair <std::string, std::string> GetNativeFrame(uintptr_t instructionPointer);
 
 public:   // global helpers
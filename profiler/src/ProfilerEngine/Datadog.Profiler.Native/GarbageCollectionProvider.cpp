@@ -0,0 +1,242 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "GarbageCollectionProvider.h"
+
+#include "Log.h"
+#include "OpSysTools.h"
+#include "Sample.h"
+
+#include <algorithm>
+
+GarbageCollectionProvider::GarbageCollectionProvider(ICorProfilerInfo4* pCorProfilerInfo, IRuntimeIdStore* pRuntimeIdStore) :
+    ProviderBase("GarbageCollectionProvider"),
+    _pCorProfilerInfo{pCorProfilerInfo},
+    _pRuntimeIdStore{pRuntimeIdStore},
+    _currentSuspension{},
+    _currentSuspensionStart{0},
+    _currentGarbageCollectionStart{0},
+    _lastAppDomainId{0},
+    _currentSuspendReasonName{nullptr}
+{
+}
+
+const char* GarbageCollectionProvider::GetName()
+{
+    return _name.c_str();
+}
+
+bool GarbageCollectionProvider::Start()
+{
+    return true;
+}
+
+bool GarbageCollectionProvider::Stop()
+{
+    return true;
+}
+
+void GarbageCollectionProvider::OnRuntimeSuspendStarted(COR_PRF_SUSPEND_REASON suspendReason)
+{
+    _currentSuspensionStart = OpSysTools::GetHighPrecisionNanoseconds();
+
+    _currentSuspension.Timestamp = OpSysTools::GetUnixTimeMilliseconds();
+    _currentSuspension.Duration = 0;
+    _currentSuspension.AppDomainId = GetCurrentAppDomain();
+    _currentSuspension.SuspendReason = suspendReason;
+    _currentSuspension.Generation = -1;
+    _currentSuspension.GcReason = COR_PRF_GC_OTHER;
+    _currentSuspension.ClrGcReason = -1;
+    _currentSuspension.GcDuration = 0;
+
+    _currentSuspendReasonName.store(GetSuspendReasonName(suspendReason), std::memory_order_relaxed);
+}
+
+void GarbageCollectionProvider::OnRuntimeSuspendAborted()
+{
+    _currentSuspensionStart = 0;
+    _currentGarbageCollectionStart = 0;
+    _currentSuspendReasonName.store(nullptr, std::memory_order_relaxed);
+}
+
+void GarbageCollectionProvider::OnGarbageCollectionStarted(int cGenerations, BOOL generationCollected[], COR_PRF_GC_REASON reason)
+{
+    // background garbage collections also start outside of a suspension: only the pauses are recorded
+    if ((_currentSuspensionStart == 0) || (_currentSuspension.Generation != -1))
+    {
+        return;
+    }
+
+    // the generation of a collection is the oldest collected one
+    for (auto generation = std::min(cGenerations, GenerationsCount) - 1; generation >= 0; generation--)
+    {
+        if (generationCollected[generation])
+        {
+            _currentSuspension.Generation = generation;
+            _currentSuspension.GcReason = reason;
+            _currentGarbageCollectionStart = OpSysTools::GetHighPrecisionNanoseconds();
+            break;
+        }
+    }
+}
+
+void GarbageCollectionProvider::OnGarbageCollectionFinished()
+{
+    // only the collection recorded by OnGarbageCollectionStarted is measured
+    if (_currentGarbageCollectionStart == 0)
+    {
+        return;
+    }
+
+    _currentSuspension.GcDuration = OpSysTools::GetHighPrecisionNanoseconds() - _currentGarbageCollectionStart;
+    _currentGarbageCollectionStart = 0;
+}
+
+void GarbageCollectionProvider::OnGarbageCollectionStart(std::uint32_t number, std::uint32_t generation, std::uint32_t reason, std::uint32_t type)
+{
+    // the GCStart event is sent by the thread running the collection, before or after GarbageCollectionStarted
+    // depending on the runtime version: keep the reason of the first collection of the suspension
+    if ((_currentSuspensionStart == 0) || (_currentSuspension.ClrGcReason != -1))
+    {
+        return;
+    }
+
+    _currentSuspension.ClrGcReason = static_cast<std::int32_t>(reason);
+}
+
+void GarbageCollectionProvider::OnRuntimeResumeFinished()
+{
+    if (_currentSuspensionStart == 0)
+    {
+        return;
+    }
+
+    _currentSuspension.Duration = OpSysTools::GetHighPrecisionNanoseconds() - _currentSuspensionStart;
+    _currentSuspensionStart = 0;
+    _currentGarbageCollectionStart = 0;
+    _currentSuspendReasonName.store(nullptr, std::memory_order_relaxed);
+
+    _events.TryPush(_currentSuspension);
+}
+
+const char* GarbageCollectionProvider::GetCurrentSuspensionReason() const
+{
+    return _currentSuspendReasonName.load(std::memory_order_relaxed);
+}
+
+std::list<Sample> GarbageCollectionProvider::GetSamples()
+{
+    std::list<Sample> samples;
+
+    RuntimeSuspensionEvent suspension;
+    while (_events.TryPop(suspension))
+    {
+        Sample sample(suspension.Timestamp, _pRuntimeIdStore->GetId(suspension.AppDomainId));
+        sample.AddValue(suspension.Duration, SampleValue::RuntimeSuspensionDuration);
+        sample.AddLabel(Label(Sample::RuntimeSuspensionLabel, GetSuspendReasonName(suspension.SuspendReason)));
+        sample.AddRuntimeFrame((suspension.Generation != -1) ? "Garbage Collection" : "Runtime Suspension");
+
+        if (suspension.Generation != -1)
+        {
+            sample.AddValue(1, SampleValue::GarbageCollectionCount);
+            sample.AddValue(suspension.GcDuration, SampleValue::GarbageCollectionPauseDuration);
+            sample.AddLabel(Label(Sample::GarbageCollectionGenerationLabel, std::to_string(suspension.Generation)));
+            sample.AddLabel(Label(Sample::GarbageCollectionReasonLabel, GetGcReasonName(suspension)));
+        }
+
+        samples.push_back(std::move(sample));
+    }
+
+    auto droppedCount = _events.ResetDroppedCount();
+    if (droppedCount != 0)
+    {
+        Log::Debug(droppedCount, " runtime suspensions were dropped: more than ", MaxPendingEvents, " suspensions between two collections.");
+    }
+
+    return samples;
+}
+
+AppDomainID GarbageCollectionProvider::GetCurrentAppDomain()
+{
+    // the suspension is attached to the AppDomain of the thread triggering it (i.e. allocating thread)
+    // or to the last known one for native threads (i.e. background GC thread)
+    ThreadID threadId;
+    AppDomainID appDomainId;
+    if ((_pCorProfilerInfo != nullptr) &&
+        SUCCEEDED(_pCorProfilerInfo->GetCurrentThreadID(&threadId)) &&
+        SUCCEEDED(_pCorProfilerInfo->GetThreadAppDomain(threadId, &appDomainId)))
+    {
+        _lastAppDomainId = appDomainId;
+    }
+
+    return _lastAppDomainId;
+}
+
+const char* GarbageCollectionProvider::GetSuspendReasonName(COR_PRF_SUSPEND_REASON suspendReason)
+{
+    switch (suspendReason)
+    {
+        case COR_PRF_SUSPEND_FOR_GC:
+            return "gc";
+        case COR_PRF_SUSPEND_FOR_APPDOMAIN_SHUTDOWN:
+            return "appdomain shutdown";
+        case COR_PRF_SUSPEND_FOR_CODE_PITCHING:
+            return "code pitching";
+        case COR_PRF_SUSPEND_FOR_SHUTDOWN:
+            return "shutdown";
+        case COR_PRF_SUSPEND_FOR_INPROC_DEBUGGER:
+            return "debugger";
+        case COR_PRF_SUSPEND_FOR_GC_PREP:
+            return "gc prep";
+        case COR_PRF_SUSPEND_FOR_REJIT:
+            return "rejit";
+        case COR_PRF_SUSPEND_FOR_PROFILER:
+            return "profiler";
+        default:
+            return "other";
+    }
+}
+
+const char* GarbageCollectionProvider::GetGcReasonName(const RuntimeSuspensionEvent& suspension)
+{
+    // without GCStart event, only the induced collections are known
+    if (suspension.ClrGcReason == -1)
+    {
+        return (suspension.GcReason == COR_PRF_GC_INDUCED) ? "induced" : "other";
+    }
+
+    // gc_reason enum in gcinterface.h
+    switch (suspension.ClrGcReason)
+    {
+        case 0:
+            return "small alloc";
+        case 1:
+            return "induced";
+        case 2:
+            return "low memory";
+        case 3:
+            return "empty";
+        case 4:
+            return "large alloc";
+        case 5:
+            return "out of space soh";
+        case 6:
+            return "out of space loh";
+        case 7:
+            return "induced not forced";
+        case 8:
+            return "internal";
+        case 9:
+            return "induced low memory";
+        case 10:
+            return "induced compacting";
+        case 11:
+            return "low memory host";
+        case 12:
+            return "pm full gc";
+        case 13:
+            return "low memory host blocking";
+        default:
+            return "other";
+    }
+}
@@ -0,0 +1,88 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "cor.h"
+#include "corprof.h"
+
+#include "IGarbageCollectionsListener.h"
+#include "IRuntimeIdStore.h"
+#include "IRuntimeSuspensionState.h"
+#include "IService.h"
+#include "LockFreeRingBuffer.h"
+#include "ProviderBase.h"
+
+// A runtime suspension window (from RuntimeSuspendStarted to RuntimeResumeFinished)
+// with the garbage collection that happened during the window, if any
+struct RuntimeSuspensionEvent
+{
+    std::uint64_t Timestamp;  // start of the suspension (unix time in milliseconds)
+    std::int64_t Duration;    // in nanoseconds
+    AppDomainID AppDomainId;
+    COR_PRF_SUSPEND_REASON SuspendReason;
+    std::int32_t Generation;  // -1 if no garbage collection started during the suspension
+    COR_PRF_GC_REASON GcReason;
+    std::int32_t ClrGcReason; // gc_reason of the GCStart event, -1 if the event was not received
+    std::int64_t GcDuration;  // from GarbageCollectionStarted to GarbageCollectionFinished, in nanoseconds
+};
+
+// Records the garbage collections and runtime suspensions reported by the ICorProfilerCallback
+// GarbageCollectionStarted/Finished/RuntimeSuspendXXX methods: no callstack, one sample per suspension.
+// COR_PRF_GC_REASON only tells induced collections apart: the detailed reason comes from the GCStart
+// event of the EventPipe session, when available (.NET 5+).
+// The callbacks are serialized by the runtime (only one suspension at a time) so the events
+// are written without lock to a ring buffer that is drained when the samples are collected.
+class GarbageCollectionProvider
+    : public IService,
+      public ProviderBase,
+      public IRuntimeSuspensionState,
+      public IGarbageCollectionsListener
+{
+public:
+    GarbageCollectionProvider(ICorProfilerInfo4* pCorProfilerInfo, IRuntimeIdStore* pRuntimeIdStore);
+
+    const char* GetName() override;
+    bool Start() override;
+    bool Stop() override;
+
+    void OnRuntimeSuspendStarted(COR_PRF_SUSPEND_REASON suspendReason);
+    void OnRuntimeSuspendAborted();
+    void OnRuntimeResumeFinished();
+    void OnGarbageCollectionStarted(int cGenerations, BOOL generationCollected[], COR_PRF_GC_REASON reason);
+    void OnGarbageCollectionFinished();
+
+    // IGarbageCollectionsListener
+    void OnGarbageCollectionStart(std::uint32_t number, std::uint32_t generation, std::uint32_t reason, std::uint32_t type) override;
+
+    const char* GetCurrentSuspensionReason() const override;
+
+    std::list<Sample> GetSamples() override;
+
+private:
+    AppDomainID GetCurrentAppDomain();
+    static const char* GetSuspendReasonName(COR_PRF_SUSPEND_REASON suspendReason);
+    static const char* GetGcReasonName(const RuntimeSuspensionEvent& suspension);
+
+private:
+    static constexpr std::size_t MaxPendingEvents = 1024;
+    static constexpr std::int32_t GenerationsCount = 3; // LOH and POH are reported after gen2
+
+    ICorProfilerInfo4* _pCorProfilerInfo;
+    IRuntimeIdStore* _pRuntimeIdStore;
+
+    // current suspension: only accessed while the runtime is suspended
+    // (by the thread suspending the runtime or by the GC thread sending the GCStart event)
+    RuntimeSuspensionEvent _currentSuspension;
+    std::int64_t _currentSuspensionStart;
+    std::int64_t _currentGarbageCollectionStart;
+    AppDomainID _lastAppDomainId;
+
+    // name of the current suspension reason (nullptr when the runtime is not suspended), read by the stack sampler
+    std::atomic<const char*> _currentSuspendReasonName;
+
+    LockFreeRingBuffer<RuntimeSuspensionEvent, MaxPendingEvents> _events;
+};
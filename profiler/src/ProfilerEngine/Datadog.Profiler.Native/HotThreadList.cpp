@@ -0,0 +1,163 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "HotThreadList.h"
+
+#include "Log.h"
+
+#include <algorithm>
+
+HotThreadList::HotThreadList() :
+    _threadsCount{0},
+    _budgetPeriodStartNs{0},
+    _costInPeriodNs{0},
+    _requestsCount{0},
+    _rejectedRequestsCount{0},
+    _burstSamplesCount{0},
+    _exhaustedBudgetPeriodsCount{0},
+    _isBudgetExhausted{false}
+{
+    _threads.reserve(MaxHotThreads);
+}
+
+HotThreadList::~HotThreadList()
+{
+    std::lock_guard lock(_threadsLock);
+
+    for (auto const& entry : _threads)
+    {
+        entry.ThreadInfo->Release();
+    }
+    _threads.clear();
+    _threadsCount = 0;
+}
+
+bool HotThreadList::Add(ManagedThreadInfo* pThreadInfo, std::chrono::milliseconds duration, std::uint64_t spanId, std::int64_t nowNs)
+{
+    if ((pThreadInfo == nullptr) || (duration.count() <= 0))
+    {
+        return false;
+    }
+
+    _requestsCount++;
+
+    auto deadlineNs = nowNs + std::chrono::duration_cast<std::chrono::nanoseconds>((std::min)(duration, MaxBurstDuration)).count();
+
+    std::lock_guard lock(_threadsLock);
+
+    for (auto& entry : _threads)
+    {
+        if (entry.ThreadInfo == pThreadInfo)
+        {
+            entry.DeadlineNs = (std::max)(entry.DeadlineNs, deadlineNs);
+            entry.SpanId = spanId;
+            return true;
+        }
+    }
+
+    if (_threads.size() >= MaxHotThreads)
+    {
+        _rejectedRequestsCount++;
+        return false;
+    }
+
+    // keep the thread alive while it is in the list
+    pThreadInfo->AddRef();
+    _threads.push_back({pThreadInfo, spanId, deadlineNs});
+    _threadsCount = _threads.size();
+
+    return true;
+}
+
+bool HotThreadList::AddIfSlow(ManagedThreadInfo* pThreadInfo, std::chrono::milliseconds threshold, std::chrono::milliseconds duration, std::int64_t nowNs)
+{
+    if ((threshold.count() <= 0) || !pThreadInfo->CanReadTraceContext())
+    {
+        return false;
+    }
+
+    auto localRootSpanId = pThreadInfo->GetLocalRootSpanId();
+    auto spanId = pThreadInfo->GetSpanId();
+
+    // also called without local root span to restart the measure with the next one
+    auto activeTimeNs = pThreadInfo->GetLocalRootSpanActiveTime(localRootSpanId, nowNs);
+    if ((localRootSpanId == 0) || (activeTimeNs < std::chrono::duration_cast<std::chrono::nanoseconds>(threshold).count()))
+    {
+        return false;
+    }
+
+    if (!pThreadInfo->TryStartBurstForLocalRootSpan(localRootSpanId))
+    {
+        return false;
+    }
+
+    return Add(pThreadInfo, duration, spanId, nowNs);
+}
+
+bool HotThreadList::IsEmpty() const
+{
+    return _threadsCount == 0;
+}
+
+void HotThreadList::GetThreadsToSample(std::int64_t nowNs, std::vector<HotThread>& threads)
+{
+    std::lock_guard lock(_threadsLock);
+
+    auto current = _threads.begin();
+    while (current != _threads.end())
+    {
+        if ((current->DeadlineNs <= nowNs) || current->ThreadInfo->IsThreadDestroyed())
+        {
+            current->ThreadInfo->Release();
+            current = _threads.erase(current);
+            continue;
+        }
+
+        current->ThreadInfo->AddRef();
+        threads.push_back({current->ThreadInfo, current->SpanId});
+        ++current;
+    }
+
+    _threadsCount = _threads.size();
+}
+
+bool HotThreadList::HasBudget(std::int64_t nowNs)
+{
+    if (nowNs - _budgetPeriodStartNs >= BudgetPeriod.count())
+    {
+        _budgetPeriodStartNs = nowNs;
+        _costInPeriodNs = 0;
+        _isBudgetExhausted = false;
+    }
+
+    if (_costInPeriodNs < MaxBurstCostPerPeriod.count())
+    {
+        return true;
+    }
+
+    // count each period only once
+    if (!_isBudgetExhausted)
+    {
+        _isBudgetExhausted = true;
+        _exhaustedBudgetPeriodsCount++;
+    }
+
+    return false;
+}
+
+void HotThreadList::AddBurstSampleCost(std::int64_t costNs)
+{
+    _costInPeriodNs += costNs;
+    _burstSamplesCount++;
+}
+
+void HotThreadList::LogStatistics()
+{
+    if (_requestsCount == 0)
+    {
+        return;
+    }
+
+    Log::Info("Burst sampling: ", _requestsCount.load(), " requests (", _rejectedRequestsCount.load(), " rejected because more than ", MaxHotThreads,
+              " threads were hot), ", _burstSamplesCount, " samples, budget exhausted during ", _exhaustedBudgetPeriodsCount, " periods.");
+}
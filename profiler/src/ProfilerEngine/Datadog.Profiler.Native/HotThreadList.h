@@ -0,0 +1,88 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "ManagedThreadInfo.h"
+
+struct HotThread
+{
+    ManagedThreadInfo* ThreadInfo;
+
+    // span that triggered the burst: its samples are tagged with it
+    std::uint64_t SpanId;
+};
+
+// Threads marked "hot" by the tracer (i.e. while processing a slow request) are sampled by the StackSamplerLoop
+// at a much higher rate than the regular wall time sampling, for a short period of time.
+// The cost of these burst samples is bounded by a global budget: once the time spent walking the stacks of hot
+// threads exceeds MaxBurstCostPerPeriod during BudgetPeriod, burst sampling is paused until the next period.
+//
+// Add() is called by application threads while the other methods (including AddIfSlow) are only called by the
+// StackSamplerLoop thread.
+class HotThreadList
+{
+public:
+    HotThreadList();
+    ~HotThreadList();
+    HotThreadList(HotThreadList const&) = delete;
+    HotThreadList& operator=(HotThreadList const&) = delete;
+
+    // Mark the thread as hot until nowNs + duration; calling it again for the same thread extends the burst.
+    // Return false if too many threads are already hot.
+    bool Add(ManagedThreadInfo* pThreadInfo, std::chrono::milliseconds duration, std::uint64_t spanId, std::int64_t nowNs);
+
+    // Called by the sampler for the threads it samples: mark the thread as hot when its local root span has been
+    // active on it for longer than threshold, even if the tracer did not activate any span since then.
+    bool AddIfSlow(ManagedThreadInfo* pThreadInfo, std::chrono::milliseconds threshold, std::chrono::milliseconds duration, std::int64_t nowNs);
+
+    // Fast check done by the sampler before each regular sampling period
+    bool IsEmpty() const;
+
+    // Remove the threads whose burst is over (or that are dead) and return the other ones.
+    // The returned threads are AddRef'ed: the caller must release them.
+    void GetThreadsToSample(std::int64_t nowNs, std::vector<HotThread>& threads);
+
+    // Return false if the budget of the current period has already been consumed by burst samples
+    bool HasBudget(std::int64_t nowNs);
+    void AddBurstSampleCost(std::int64_t costNs);
+
+    void LogStatistics();
+
+public:
+    static constexpr std::size_t MaxHotThreads = 8;
+    static constexpr std::chrono::milliseconds MaxBurstDuration = std::chrono::milliseconds(5000);
+    static constexpr std::chrono::nanoseconds BudgetPeriod = std::chrono::seconds(1);
+
+    // 1% of a core
+    static constexpr std::chrono::nanoseconds MaxBurstCostPerPeriod = std::chrono::milliseconds(10);
+
+private:
+    struct HotThreadEntry
+    {
+        ManagedThreadInfo* ThreadInfo;
+        std::uint64_t SpanId;
+        std::int64_t DeadlineNs;
+    };
+
+    std::mutex _threadsLock;
+    std::vector<HotThreadEntry> _threads;
+    std::atomic<std::size_t> _threadsCount;
+
+    // only used by the sampler thread
+    std::int64_t _budgetPeriodStartNs;
+    std::int64_t _costInPeriodNs;
+
+    // statistics
+    std::atomic<std::uint64_t> _requestsCount;
+    std::atomic<std::uint64_t> _rejectedRequestsCount;
+    std::uint64_t _burstSamplesCount;
+    std::uint64_t _exhaustedBudgetPeriodsCount;
+    bool _isBudgetExhausted;
+};
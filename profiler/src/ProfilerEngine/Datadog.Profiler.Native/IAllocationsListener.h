@@ -0,0 +1,26 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include <cstdint>
+
+#include "cor.h"
+#include "corprof.h"
+
+class IAllocationsListener
+{
+public:
+    // Called on the allocating thread for each AllocationTick event (i.e. every ~100 KB allocated).
+    // typeName is not null terminated and only valid during the call.
+    // objectId is the object that crossed the threshold (0 if the runtime does not provide it).
+    virtual void OnAllocation(
+        std::uint32_t allocationKind,
+        ClassID classId,
+        const WCHAR* typeName,
+        std::size_t typeNameLength,
+        std::uint64_t allocationAmount,
+        ObjectID objectId) = 0;
+
+    virtual ~IAllocationsListener() = default;
+};
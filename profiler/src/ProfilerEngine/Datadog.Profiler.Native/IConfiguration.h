@@ -37,4 +37,17 @@ public:
     virtual bool IsCpuProfilingEnabled() const = 0;
     virtual bool IsExceptionProfilingEnabled() const = 0;
     virtual int ExceptionSampleLimit() const = 0;
+    virtual bool IsTimelineEnabled() const = 0;
+    virtual int ExceptionMessageMaxLength() const = 0;
+    virtual bool IsExceptionMessageNormalizationEnabled() const = 0;
+    virtual bool IsAllocationProfilingEnabled() const = 0;
+    virtual int AllocationSampleLimit() const = 0;
+    virtual bool IsContentionProfilingEnabled() const = 0;
+    virtual int ContentionSampleLimit() const = 0;
+    virtual bool IsGarbageCollectionProfilingEnabled() const = 0;
+    virtual bool IsHeapProfilingEnabled() const = 0;
+    virtual bool IsNativeThreadsProfilingEnabled() const = 0;
+    virtual bool IsJitProfilingEnabled() const = 0;
+    virtual std::chrono::milliseconds GetBurstSamplingThreshold() const = 0;
+    virtual std::chrono::milliseconds GetBurstSamplingDuration() const = 0;
 };
\ No newline at end of file
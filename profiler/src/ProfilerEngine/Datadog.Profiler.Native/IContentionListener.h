@@ -0,0 +1,14 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+class IContentionListener
+{
+public:
+    // Called on the waiting thread when it acquires a contended lock (ContentionStop event):
+    // the callstack is still the one of the waiting call site.
+    virtual void OnContention(double contentionDurationNs) = 0;
+
+    virtual ~IContentionListener() = default;
+};
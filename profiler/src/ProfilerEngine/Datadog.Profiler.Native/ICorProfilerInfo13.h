@@ -0,0 +1,44 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+// from dotnet coreclr includes
+#include "cor.h"
+#include "corprof.h"
+// end
+
+// The coreclr headers in shared/src/native-lib stop at ICorProfilerInfo12: the .NET 7 additions needed to
+// keep track of objects without preventing their collection are declared here, as in corprof.idl.
+#ifndef __ICorProfilerInfo13_INTERFACE_DEFINED__
+#define __ICorProfilerInfo13_INTERFACE_DEFINED__
+
+typedef enum COR_PRF_HANDLE_TYPE
+{
+    COR_PRF_HANDLE_TYPE_WEAK = 0x1,
+    COR_PRF_HANDLE_TYPE_STRONG = 0x2,
+    COR_PRF_HANDLE_TYPE_PINNED = 0x3
+} COR_PRF_HANDLE_TYPE;
+
+typedef void** ObjectHandleID;
+
+EXTERN_C const IID IID_ICorProfilerInfo13;
+
+MIDL_INTERFACE("6E6C7EE2-0701-4EC2-9D29-2E8733B66934")
+ICorProfilerInfo13 : public ICorProfilerInfo12
+{
+public:
+    virtual HRESULT STDMETHODCALLTYPE CreateHandle(
+        /* [in] */ ObjectID object,
+        /* [in] */ COR_PRF_HANDLE_TYPE type,
+        /* [out] */ ObjectHandleID* pHandle) = 0;
+
+    virtual HRESULT STDMETHODCALLTYPE DestroyHandle(
+        /* [in] */ ObjectHandleID handle) = 0;
+
+    virtual HRESULT STDMETHODCALLTYPE GetObjectIDFromHandle(
+        /* [in] */ ObjectHandleID handle,
+        /* [out] */ ObjectID* pObject) = 0;
+};
+
+#endif
@@ -0,0 +1,22 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include "IService.h"
+
+#include <cstdint>
+#include <string>
+
+class IEndpointStore : public IService
+{
+public:
+    // return the interned id (> 0) of the endpoint or 0 if too many endpoints were registered
+    virtual std::uint64_t Register(const std::string& endpoint) = 0;
+
+    // return false if the id is unknown
+    virtual bool GetEndpoint(std::uint64_t endpointId, std::string& endpoint) = 0;
+
+    virtual void AddWallTime(std::uint64_t endpointId, std::int64_t durationNs) = 0;
+    virtual void AddCpuTime(std::uint64_t endpointId, std::int64_t durationNs) = 0;
+};
@@ -17,4 +17,10 @@ public:
     //  - module name
     //  - frame text
     virtual std::tuple<bool, std::string, std::string> GetFrame(uintptr_t instructionPointer) = 0;
+
+    // return
+    //  - module name
+    //  - frame text
+    // of a managed method (i.e. not running yet when being compiled)
+    virtual std::pair<std::string, std::string> GetManagedFrame(FunctionID functionId) = 0;
 };
@@ -0,0 +1,16 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include <cstdint>
+
+class IGarbageCollectionsListener
+{
+public:
+    // Called by the thread starting a garbage collection (GCStart event), right before the
+    // GarbageCollectionStarted profiler callback: reason and type are the gc_reason and gc_type of the runtime.
+    virtual void OnGarbageCollectionStart(std::uint32_t number, std::uint32_t generation, std::uint32_t reason, std::uint32_t type) = 0;
+
+    virtual ~IGarbageCollectionsListener() = default;
+};
@@ -0,0 +1,14 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+class IRuntimeSuspensionState
+{
+public:
+    // Returns the reason of the ongoing runtime suspension (i.e. "gc") or nullptr if the runtime is not suspended.
+    // The returned string is static.
+    virtual const char* GetCurrentSuspensionReason() const = 0;
+
+    virtual ~IRuntimeSuspensionState() = default;
+};
@@ -3,6 +3,10 @@
 
 #pragma once
 #include "IService.h"
+
+#include <chrono>
+#include <cstdint>
+
 #include "ManagedThreadInfo.h"
 
 
@@ -14,4 +18,7 @@ public:
     virtual void NotifyCollectionStart() = 0;
     virtual void NotifyCollectionEnd() = 0;
     virtual void NotifyIterationFinished() = 0;
+
+    // sample the given thread at a higher rate for the given duration (i.e. while it is processing a slow request)
+    virtual bool StartBurstSampling(ManagedThreadInfo* pThreadInfo, std::chrono::milliseconds duration, std::uint64_t spanId) = 0;
 };
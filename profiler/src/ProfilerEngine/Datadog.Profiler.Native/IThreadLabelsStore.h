@@ -0,0 +1,19 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include "IService.h"
+
+#include <cstdint>
+#include <string>
+
+class IThreadLabelsStore : public IService
+{
+public:
+    // return the interned id (> 0) of the label key or value or 0 if too many strings were interned
+    virtual std::uint32_t Intern(const std::string& text) = 0;
+
+    // return false if the id is unknown
+    virtual bool GetText(std::uint32_t id, std::string& text) = 0;
+};
@@ -0,0 +1,208 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "JitCompilationProvider.h"
+
+#include "Log.h"
+#include "OpSysTools.h"
+#include "Sample.h"
+
+#include <algorithm>
+
+thread_local std::vector<JitCompilationProvider::PendingCompilation> JitCompilationProvider::_pendingCompilations;
+
+JitCompilationProvider::JitCompilationProvider(ICorProfilerInfo4* pCorProfilerInfo, IFrameStore* pFrameStore, IRuntimeIdStore* pRuntimeIdStore) :
+    ProviderBase("JitCompilationProvider"),
+    _pCorProfilerInfo{pCorProfilerInfo},
+    _pFrameStore{pFrameStore},
+    _pRuntimeIdStore{pRuntimeIdStore},
+    _droppedEventsCount{0},
+    _statistics{},
+    _startupStatistics{},
+    _slowestCompilation{}
+{
+    // the startup phase is counted from the profiler initialization (i.e. before any method is compiled)
+    _startupPhaseEnd = OpSysTools::GetHighPrecisionNanoseconds() + std::chrono::duration_cast<std::chrono::nanoseconds>(StartupPhaseDuration).count();
+}
+
+const char* JitCompilationProvider::GetName()
+{
+    return _name.c_str();
+}
+
+bool JitCompilationProvider::Start()
+{
+    return true;
+}
+
+bool JitCompilationProvider::Stop()
+{
+    LogStatistics();
+    return true;
+}
+
+void JitCompilationProvider::OnJitCompilationStarted(FunctionID functionId)
+{
+    _pendingCompilations.push_back({functionId, OpSysTools::GetHighPrecisionNanoseconds()});
+}
+
+void JitCompilationProvider::OnJitCompilationFinished(FunctionID functionId, HRESULT hrStatus, BOOL fIsSafeToBlock, bool isReJit)
+{
+    auto now = OpSysTools::GetHighPrecisionNanoseconds();
+
+    // the innermost compilation of the method is the one finishing
+    auto pending = std::find_if(_pendingCompilations.rbegin(), _pendingCompilations.rend(), [functionId](PendingCompilation const& compilation) {
+        return compilation.FunctionId == functionId;
+    });
+    if (pending == _pendingCompilations.rend())
+    {
+        // compilation started before the provider was created
+        return;
+    }
+
+    auto start = pending->Start;
+    _pendingCompilations.erase(std::next(pending).base());
+
+    if (FAILED(hrStatus))
+    {
+        return;
+    }
+
+    JitCompilationEvent compilation;
+    compilation.Timestamp = OpSysTools::GetUnixTimeMilliseconds() - (now - start) / 1000000;
+    compilation.Duration = now - start;
+    compilation.FunctionId = functionId;
+    compilation.AppDomainId = GetCurrentAppDomain();
+    compilation.IsSafeToBlock = (fIsSafeToBlock != FALSE);
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    // with tiered compilation, the same method is compiled again when it becomes hot
+    auto isFirstCompilation = _compiledFunctions.insert(functionId).second;
+    compilation.Tier = isReJit ? JitTier::ReJit : (isFirstCompilation ? JitTier::Initial : JitTier::TierUp);
+
+    auto& statistics = _statistics[static_cast<std::size_t>(compilation.Tier)];
+    statistics.Count++;
+    statistics.Duration += compilation.Duration;
+    if (start < _startupPhaseEnd)
+    {
+        auto& startupStatistics = _startupStatistics[static_cast<std::size_t>(compilation.Tier)];
+        startupStatistics.Count++;
+        startupStatistics.Duration += compilation.Duration;
+    }
+
+    if (compilation.Duration > _slowestCompilation.Duration)
+    {
+        _slowestCompilation = compilation;
+    }
+
+    if (_events.size() >= MaxPendingEvents)
+    {
+        _droppedEventsCount++;
+        return;
+    }
+
+    _events.push_back(compilation);
+}
+
+std::list<Sample> JitCompilationProvider::GetSamples()
+{
+    std::vector<JitCompilationEvent> events;
+    std::uint64_t droppedEventsCount;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        events.swap(_events);
+        droppedEventsCount = _droppedEventsCount;
+        _droppedEventsCount = 0;
+    }
+
+    std::list<Sample> samples;
+
+    for (auto const& compilation : events)
+    {
+        Sample sample(compilation.Timestamp, _pRuntimeIdStore->GetId(compilation.AppDomainId));
+        sample.AddValue(1, SampleValue::JitCompilationCount);
+        sample.AddValue(compilation.Duration, SampleValue::JitCompilationDuration);
+        sample.AddLabel(Label(Sample::JitTierLabel, GetTierName(compilation.Tier)));
+        sample.AddLabel(Label(Sample::JitSafeToBlockLabel, compilation.IsSafeToBlock ? "true" : "false"));
+
+        auto [moduleName, frame] = _pFrameStore->GetManagedFrame(compilation.FunctionId);
+        sample.AddFrame(moduleName, frame);
+
+        samples.push_back(std::move(sample));
+    }
+
+    if (droppedEventsCount != 0)
+    {
+        Log::Debug(droppedEventsCount, " JIT compilations were dropped: more than ", MaxPendingEvents, " compilations between two collections.");
+    }
+
+    return samples;
+}
+
+void JitCompilationProvider::LogStatistics()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    auto toMilliseconds = [](std::int64_t durationNs) { return durationNs / 1000000; };
+
+    std::uint64_t totalCount = 0;
+    std::int64_t totalDuration = 0;
+    std::uint64_t startupCount = 0;
+    std::int64_t startupDuration = 0;
+    for (std::size_t tier = 0; tier < TiersCount; tier++)
+    {
+        totalCount += _statistics[tier].Count;
+        totalDuration += _statistics[tier].Duration;
+        startupCount += _startupStatistics[tier].Count;
+        startupDuration += _startupStatistics[tier].Duration;
+    }
+
+    if (totalCount == 0)
+    {
+        return;
+    }
+
+    Log::Info("JIT compilations: ", totalCount, " methods compiled in ", toMilliseconds(totalDuration), " ms",
+              " (", GetTierName(JitTier::Initial), ": ", _statistics[0].Count, " in ", toMilliseconds(_statistics[0].Duration), " ms",
+              ", ", GetTierName(JitTier::TierUp), ": ", _statistics[1].Count, " in ", toMilliseconds(_statistics[1].Duration), " ms",
+              ", ", GetTierName(JitTier::ReJit), ": ", _statistics[2].Count, " in ", toMilliseconds(_statistics[2].Duration), " ms)");
+
+    Log::Info("JIT compilations during the first ", StartupPhaseDuration.count(), " seconds: ", startupCount, " methods compiled in ", toMilliseconds(startupDuration), " ms",
+              " (", GetTierName(JitTier::Initial), ": ", _startupStatistics[0].Count, " in ", toMilliseconds(_startupStatistics[0].Duration), " ms",
+              ", ", GetTierName(JitTier::TierUp), ": ", _startupStatistics[1].Count, " in ", toMilliseconds(_startupStatistics[1].Duration), " ms)");
+
+    auto [moduleName, frame] = _pFrameStore->GetManagedFrame(_slowestCompilation.FunctionId);
+    Log::Info("Slowest JIT compilation: ", frame, " (", GetTierName(_slowestCompilation.Tier), ") in ", _slowestCompilation.Duration / 1000, " us");
+}
+
+AppDomainID JitCompilationProvider::GetCurrentAppDomain()
+{
+    // the compiling thread is the one calling the method for the first time
+    ThreadID threadId;
+    AppDomainID appDomainId;
+    if ((_pCorProfilerInfo != nullptr) &&
+        SUCCEEDED(_pCorProfilerInfo->GetCurrentThreadID(&threadId)) &&
+        SUCCEEDED(_pCorProfilerInfo->GetThreadAppDomain(threadId, &appDomainId)))
+    {
+        return appDomainId;
+    }
+
+    return 0;
+}
+
+const char* JitCompilationProvider::GetTierName(JitTier tier)
+{
+    switch (tier)
+    {
+        case JitTier::Initial:
+            return "initial";
+        case JitTier::TierUp:
+            return "tier-up";
+        case JitTier::ReJit:
+            return "rejit";
+        default:
+            return "unknown";
+    }
+}
@@ -0,0 +1,94 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "cor.h"
+#include "corprof.h"
+
+#include "IFrameStore.h"
+#include "IRuntimeIdStore.h"
+#include "IService.h"
+#include "ProviderBase.h"
+
+enum class JitTier
+{
+    Initial,  // first compilation of the method (tier0 when tiered compilation is enabled)
+    TierUp,   // new native code version of an already compiled method (i.e. tier1 or OSR)
+    ReJit     // compilation requested by a profiler through RequestReJIT
+};
+
+struct JitCompilationEvent
+{
+    std::uint64_t Timestamp;  // start of the compilation (unix time in milliseconds)
+    std::int64_t Duration;    // in nanoseconds
+    FunctionID FunctionId;
+    AppDomainID AppDomainId;
+    JitTier Tier;
+    bool IsSafeToBlock;
+};
+
+// Times the (Re)JITCompilationStarted/Finished callbacks: one sample per compiled method version
+// with the compiled method as single frame so that the JIT cost is visible per method and module.
+// A compilation starts and finishes on the same thread so the start time is kept in a thread local
+// list (compilations may be nested) and only the finished compilations are shared under lock.
+class JitCompilationProvider
+    : public IService,
+      public ProviderBase
+{
+public:
+    JitCompilationProvider(ICorProfilerInfo4* pCorProfilerInfo, IFrameStore* pFrameStore, IRuntimeIdStore* pRuntimeIdStore);
+
+    const char* GetName() override;
+    bool Start() override;
+    bool Stop() override;
+
+    void OnJitCompilationStarted(FunctionID functionId);
+    void OnJitCompilationFinished(FunctionID functionId, HRESULT hrStatus, BOOL fIsSafeToBlock, bool isReJit);
+
+    std::list<Sample> GetSamples() override;
+
+    static const char* GetTierName(JitTier tier);
+
+private:
+    struct JitStatistics
+    {
+        std::uint64_t Count;
+        std::int64_t Duration;  // in nanoseconds
+    };
+
+    struct PendingCompilation
+    {
+        FunctionID FunctionId;
+        std::int64_t Start;
+    };
+
+    AppDomainID GetCurrentAppDomain();
+    void LogStatistics();
+
+private:
+    static constexpr std::size_t MaxPendingEvents = 16384;
+    static constexpr std::chrono::seconds StartupPhaseDuration = std::chrono::seconds(60);
+    static constexpr std::size_t TiersCount = 3;
+
+    ICorProfilerInfo4* _pCorProfilerInfo;
+    IFrameStore* _pFrameStore;
+    IRuntimeIdStore* _pRuntimeIdStore;
+    std::int64_t _startupPhaseEnd;
+
+    static thread_local std::vector<PendingCompilation> _pendingCompilations;
+
+    std::mutex _lock;
+    std::vector<JitCompilationEvent> _events;
+    std::uint64_t _droppedEventsCount;
+    std::unordered_set<FunctionID> _compiledFunctions;
+    JitStatistics _statistics[TiersCount];
+    JitStatistics _startupStatistics[TiersCount];
+    JitCompilationEvent _slowestCompilation;
+};
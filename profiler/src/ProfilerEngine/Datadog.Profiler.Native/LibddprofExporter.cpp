@@ -46,8 +46,11 @@ std::string const LibddprofExporter::ProfilePeriodType = "RealTime";
 
 std::string const LibddprofExporter::ProfilePeriodUnit = "Nanoseconds";
 
+std::string const LibddprofExporter::TimelineDeltaUnit = "milliseconds";
+
 LibddprofExporter::LibddprofExporter(IConfiguration* configuration, IApplicationStore* applicationStore) :
     _locationsAndLinesSize{512},
+    _isTimelineEnabled{configuration->IsTimelineEnabled()},
     _applicationStore{applicationStore}
 {
     _exporterBaseTags = CreateTags(configuration);
@@ -163,6 +166,7 @@ LibddprofExporter::ProfileInfo& LibddprofExporter::GetInfo(std::string_view runt
     }
 
     profileInfo.profile = CreateProfile();
+    profileInfo.startTimestamp = OpSysTools::GetUnixTimeMilliseconds();
 
     return profileInfo;
 }
@@ -210,12 +214,26 @@ void LibddprofExporter::Add(Sample const& sample)
     // Labels
     auto const& labels = sample.GetLabels();
     std::vector<ddprof_ffi_Label> ffiLabels;
-    ffiLabels.reserve(labels.size());
+    ffiLabels.reserve(labels.size() + 1);
 
     for (auto const& [label, value] : labels)
     {
         ffiLabels.push_back({{label.data(), label.size()}, {value.data(), value.size()}});
     }
+
+    // In timeline mode, the sample timestamp is stored as a numeric label relative to the profile start
+    // to keep the encoded value small. Note that it prevents libddprof from merging samples with the same stack.
+    if (_isTimelineEnabled)
+    {
+        auto timestamp = sample.GetTimeStamp();
+        auto delta = (timestamp > profileInfo.startTimestamp) ? timestamp - profileInfo.startTimestamp : 0;
+
+        auto timelineLabel = ddprof_ffi_Label{};
+        timelineLabel.key = FfiHelper::StringToCharSlice(Sample::TimelineDeltaLabel);
+        timelineLabel.num = static_cast<std::int64_t>(delta);
+        timelineLabel.num_unit = FfiHelper::StringToCharSlice(TimelineDeltaUnit);
+        ffiLabels.push_back(timelineLabel);
+    }
     ffiSample.labels = {ffiLabels.data(), ffiLabels.size()};
 
     // values
@@ -247,12 +265,22 @@ bool LibddprofExporter::Export()
         auto* profile = profileInfo.profile;
         auto profileAutoReset = ProfileAutoReset{profile};
         auto serializedProfile = SerializedProfile{profile};
+
+        // the next samples will be relative to the reset profile
+        profileInfo.startTimestamp = OpSysTools::GetUnixTimeMilliseconds();
+
         if (!serializedProfile.IsValid())
         {
             Log::Error("Unable to serialize the libddprof profile. No profile will be sent.");
             return false;
         }
 
+        if (_isTimelineEnabled)
+        {
+            // timestamped samples are not aggregated: keep track of the resulting size
+            Log::Debug("Timeline enabled: ", samplesCount, " timestamped samples serialized in ", serializedProfile.GetBuffer().len, " bytes.");
+        }
+
         if (!_pprofOutputPath.empty())
         {
             ExportToDisk(applicationInfo.ServiceName, serializedProfile, idx++);
@@ -479,4 +507,5 @@ LibddprofExporter::ProfileInfo::ProfileInfo()
     profile = nullptr;
     samplesCount = 0;
     exportsCount = 0;
+    startTimestamp = 0;
 }
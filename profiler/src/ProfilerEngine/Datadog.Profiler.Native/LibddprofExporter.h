@@ -76,6 +76,10 @@ private:
         ddprof_ffi_Profile* profile;
         std::int32_t samplesCount;
         std::int32_t exportsCount;
+
+        // unix time (in milliseconds) when the current profile was created/reset:
+        // used as the origin of the delta encoded sample timestamps in timeline mode
+        std::uint64_t startTimestamp;
     };
 
     static Tags CreateTags(IConfiguration* configuration);
@@ -102,6 +106,7 @@ private:
     static std::string const RequestFileName;
     static std::string const ProfilePeriodType;
     static std::string const ProfilePeriodUnit;
+    static std::string const TimelineDeltaUnit;
 
     fs::path _pprofOutputPath;
 
@@ -109,6 +114,7 @@ private:
     std::vector<ddprof_ffi_Line> _lines;
     std::string _agentUrl;
     std::size_t _locationsAndLinesSize;
+    bool _isTimelineEnabled;
 
     // for each application, keep track of a profile, a samples count since the last export and an export count
     std::unordered_map<std::string_view, ProfileInfo> _perAppInfo;
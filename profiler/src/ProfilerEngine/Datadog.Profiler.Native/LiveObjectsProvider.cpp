@@ -0,0 +1,217 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "LiveObjectsProvider.h"
+
+#include "HResultConverter.h"
+#include "Log.h"
+
+// see ICorProfilerInfo13.h
+EXTERN_C const IID IID_ICorProfilerInfo13 = {0x6e6c7ee2, 0x0701, 0x4ec2, {0x9d, 0x29, 0x2e, 0x87, 0x33, 0xb6, 0x69, 0x34}};
+
+LiveObjectsProvider::LiveObjectsProvider(
+    ICorProfilerInfo13* pCorProfilerInfo,
+    IFrameStore* pFrameStore,
+    IThreadsCpuManager* pThreadsCpuManager,
+    IAppDomainStore* pAppDomainStore,
+    IRuntimeIdStore* pRuntimeIdStore)
+    :
+    CollectorBase<RawAllocationSample>("LiveObjectsProvider", pThreadsCpuManager, pFrameStore, pAppDomainStore, pRuntimeIdStore),
+    _pCorProfilerInfo(pCorProfilerInfo),
+    _allocationsCount(0),
+    _random(std::random_device{}())
+{
+    _liveObjects.reserve(MaxTrackedObjects);
+}
+
+bool LiveObjectsProvider::Start()
+{
+    // no background transformation: see GetSamples()
+    return true;
+}
+
+bool LiveObjectsProvider::Stop()
+{
+    std::lock_guard<std::mutex> lock(_liveObjectsLock);
+
+    for (auto& liveObject : _liveObjects)
+    {
+        Forget(liveObject);
+    }
+    _liveObjects.clear();
+
+    for (auto& pendingObject : _pendingObjects)
+    {
+        Release(pendingObject.Sample);
+    }
+    _pendingObjects.clear();
+
+    return true;
+}
+
+void LiveObjectsProvider::OnAllocation(ObjectID objectId, const RawAllocationSample& rawSample)
+{
+    std::lock_guard<std::mutex> lock(_liveObjectsLock);
+
+    // no more than what could be tracked between two garbage collections
+    if (_pendingObjects.size() >= MaxTrackedObjects)
+    {
+        return;
+    }
+
+    PendingObject pendingObject{objectId, rawSample};
+    if (pendingObject.Sample.ThreadInfo != nullptr)
+    {
+        pendingObject.Sample.ThreadInfo->AddRef();
+    }
+    _pendingObjects.push_back(std::move(pendingObject));
+}
+
+void LiveObjectsProvider::OnGarbageCollectionStarted()
+{
+    std::lock_guard<std::mutex> lock(_liveObjectsLock);
+
+    if (_pendingObjects.empty())
+    {
+        return;
+    }
+
+    if (_liveObjects.size() + _pendingObjects.size() > MaxTrackedObjects)
+    {
+        RemoveCollectedObjects();
+    }
+
+    for (auto& pendingObject : _pendingObjects)
+    {
+        Track(pendingObject);
+    }
+    _pendingObjects.clear();
+}
+
+void LiveObjectsProvider::Track(PendingObject& pendingObject)
+{
+    // _liveObjectsLock must be held
+    _allocationsCount++;
+
+    LiveObject* pSlot = nullptr;
+    if (_liveObjects.size() < MaxTrackedObjects)
+    {
+        _liveObjects.push_back(LiveObject{nullptr, RawAllocationSample()});
+        pSlot = &_liveObjects.back();
+    }
+    else
+    {
+        auto index = std::uniform_int_distribution<std::uint64_t>(0, _allocationsCount - 1)(_random);
+        if (index < MaxTrackedObjects)
+        {
+            pSlot = &_liveObjects[index];
+        }
+    }
+
+    if (pSlot == nullptr)
+    {
+        Release(pendingObject.Sample);
+        return;
+    }
+
+    ObjectHandleID handle = nullptr;
+    HRESULT hr = _pCorProfilerInfo->CreateHandle(pendingObject.Address, COR_PRF_HANDLE_TYPE_WEAK, &handle);
+    if (FAILED(hr) || (handle == nullptr))
+    {
+        Log::Debug("Failed to create a weak handle for a sampled allocation: ", HResultConverter::ToStringWithCode(hr));
+        Release(pendingObject.Sample);
+
+        // keep the replaced object if any
+        if (pSlot->Handle == nullptr)
+        {
+            _liveObjects.pop_back();
+        }
+        return;
+    }
+
+    if (pSlot->Handle != nullptr)
+    {
+        Forget(*pSlot);
+    }
+
+    pSlot->Handle = handle;
+    pSlot->Sample = std::move(pendingObject.Sample);
+    pendingObject.Sample.ThreadInfo = nullptr;
+}
+
+std::list<Sample> LiveObjectsProvider::GetSamples()
+{
+    std::list<Sample> samples;
+
+    std::lock_guard<std::mutex> lock(_liveObjectsLock);
+
+    RemoveCollectedObjects();
+
+    // the next profile samples among its own allocations
+    _allocationsCount = _liveObjects.size();
+
+    for (auto const& liveObject : _liveObjects)
+    {
+        // the transformation releases the thread: the tracked object keeps its own reference
+        if (liveObject.Sample.ThreadInfo != nullptr)
+        {
+            liveObject.Sample.ThreadInfo->AddRef();
+        }
+        samples.push_back(TransformRawSample(liveObject.Sample));
+    }
+
+    return samples;
+}
+
+void LiveObjectsProvider::OnTransformRawSample(const RawAllocationSample& rawSample, Sample& sample)
+{
+    // each sampled object stands for the bytes allocated since the previous AllocationTick event
+    sample.AddValue(1, SampleValue::LiveObjectCount);
+    sample.AddValue(rawSample.GetUpscaledAllocationSize(), SampleValue::LiveObjectSize);
+    sample.AddLabel(Label(Sample::AllocationClassLabel, rawSample.AllocationClass));
+}
+
+bool LiveObjectsProvider::IsAlive(ObjectHandleID handle) const
+{
+    ObjectID objectId = 0;
+    HRESULT hr = _pCorProfilerInfo->GetObjectIDFromHandle(handle, &objectId);
+    return SUCCEEDED(hr) && (objectId != 0);
+}
+
+void LiveObjectsProvider::Forget(LiveObject& liveObject)
+{
+    _pCorProfilerInfo->DestroyHandle(liveObject.Handle);
+    liveObject.Handle = nullptr;
+
+    Release(liveObject.Sample);
+}
+
+void LiveObjectsProvider::Release(RawAllocationSample& rawSample)
+{
+    if (rawSample.ThreadInfo != nullptr)
+    {
+        rawSample.ThreadInfo->Release();
+        rawSample.ThreadInfo = nullptr;
+    }
+}
+
+void LiveObjectsProvider::RemoveCollectedObjects()
+{
+    // _liveObjectsLock must be held
+    std::size_t kept = 0;
+    for (auto& liveObject : _liveObjects)
+    {
+        if (!IsAlive(liveObject.Handle))
+        {
+            Forget(liveObject);
+            continue;
+        }
+
+        if (&liveObject != &_liveObjects[kept])
+        {
+            _liveObjects[kept] = std::move(liveObject);
+        }
+        kept++;
+    }
+    _liveObjects.resize(kept);
+}
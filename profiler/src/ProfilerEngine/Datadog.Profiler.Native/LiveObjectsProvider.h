@@ -0,0 +1,81 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#include "CollectorBase.h"
+#include "ICorProfilerInfo13.h"
+#include "IFrameStore.h"
+#include "RawAllocationSample.h"
+
+// The sampled allocations are followed with a weak handle until they are collected: each exported profile
+// contains the sampled objects that are still alive with their allocation callstack. Since only sampled
+// allocations are tracked (with an upper bound), the overhead does not depend on the size of the heap.
+// Once the bound is reached, the new sampled allocations replace tracked objects at random (reservoir
+// sampling over the allocations of the current profile) so that recent allocations are still followed.
+//
+// Unlike the other collectors, the samples are not transformed in the background: they are built from
+// the tracked objects only when the aggregator asks for them (i.e. right before a profile is exported).
+class LiveObjectsProvider : public CollectorBase<RawAllocationSample>
+{
+public:
+    LiveObjectsProvider(
+        ICorProfilerInfo13* pCorProfilerInfo,
+        IFrameStore* pFrameStore,
+        IThreadsCpuManager* pThreadsCpuManager,
+        IAppDomainStore* pAppDomainStore,
+        IRuntimeIdStore* pRuntimeIdStore);
+
+    bool Start() override;
+    bool Stop() override;
+
+    std::list<Sample> GetSamples() override;
+
+    // Called on the allocating thread for the sampled allocations (i.e. from the EventPipe callback):
+    // the objects are only recorded, their weak handle is created when the next garbage collection starts
+    void OnAllocation(ObjectID objectId, const RawAllocationSample& rawSample);
+
+    // Called by GarbageCollectionStarted, before the objects are moved or collected
+    void OnGarbageCollectionStarted();
+
+protected:
+    void OnTransformRawSample(const RawAllocationSample& rawSample, Sample& sample) override;
+
+private:
+    struct LiveObject
+    {
+        ObjectHandleID Handle;
+        RawAllocationSample Sample;
+    };
+
+    struct PendingObject
+    {
+        ObjectID Address;
+        RawAllocationSample Sample;
+    };
+
+    void Track(PendingObject& pendingObject);
+    bool IsAlive(ObjectHandleID handle) const;
+    void Forget(LiveObject& liveObject);
+    static void Release(RawAllocationSample& rawSample);
+    void RemoveCollectedObjects();
+
+private:
+    static constexpr std::size_t MaxTrackedObjects = 1024;
+
+    ICorProfilerInfo13* _pCorProfilerInfo;
+
+    std::mutex _liveObjectsLock;
+    std::vector<LiveObject> _liveObjects;
+    std::vector<PendingObject> _pendingObjects;
+
+    // sampled allocations since the last export: each one has MaxTrackedObjects / _allocationsCount chance
+    // to replace a tracked object once the bound is reached
+    std::uint64_t _allocationsCount;
+    std::mt19937_64 _random;
+};
@@ -0,0 +1,66 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed size ring of events written by one producer at a time and read by one consumer.
+// Neither side takes a lock nor allocates: when the ring is full, new events are dropped (and counted).
+template <typename T, std::size_t Capacity>
+class LockFreeRingBuffer
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+
+public:
+    LockFreeRingBuffer() :
+        _head{0},
+        _tail{0},
+        _droppedCount{0}
+    {
+    }
+
+    // producer side
+    bool TryPush(const T& item)
+    {
+        auto tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == Capacity)
+        {
+            _droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        _items[tail & (Capacity - 1)] = item;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer side
+    bool TryPop(T& item)
+    {
+        auto head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        item = _items[head & (Capacity - 1)];
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // returns the number of events dropped since the last call
+    std::uint64_t ResetDroppedCount()
+    {
+        return _droppedCount.exchange(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<T, Capacity> _items;
+    std::atomic<std::uint64_t> _head;
+    std::atomic<std::uint64_t> _tail;
+    std::atomic<std::uint64_t> _droppedCount;
+};
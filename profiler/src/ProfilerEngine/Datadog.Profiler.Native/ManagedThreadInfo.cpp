@@ -41,6 +41,9 @@ ManagedThreadInfo::ManagedThreadInfo(ThreadID clrThreadId, DWORD osThreadId, HAN
     _stackWalkLock(1),
     _isThreadDestroyed{false},
     _traceContextTrackingInfo{},
+    _sampledLocalRootSpanId{0},
+    _sampledLocalRootSpanStartNs{0},
+    _burstLocalRootSpanId{0},
     _cpuConsumptionMilliseconds{0}
 {
 }
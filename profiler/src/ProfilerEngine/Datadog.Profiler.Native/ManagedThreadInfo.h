@@ -10,6 +10,7 @@
 
 #include "RefCountingObject.h"
 #include "Semaphore.h"
+#include "ThreadLabels.h"
 #include "shared/src/native-src/string.h"
 
 
@@ -22,6 +23,9 @@ public:
     std::uint64_t _writeGuard;
     std::uint64_t _currentLocalRootSpanId;
     std::uint64_t _currentSpanId;
+
+    // interned by RegisterEndpoint(): 0 when the tracer does not know the endpoint yet
+    std::uint64_t _currentEndpointId;
 };
 
 struct ManagedThreadInfo : public RefCountingObject
@@ -74,8 +78,16 @@ public:
     inline TraceContextTrackingInfo* GetTraceContextPointer();
     inline std::uint64_t GetLocalRootSpanId() const;
     inline std::uint64_t GetSpanId() const;
+    inline std::uint64_t GetEndpointId() const;
     inline bool CanReadTraceContext() const;
 
+    // Only called by the sampler thread: the active time of a local root span is measured from the first time
+    // the sampler sees it on this thread, and a burst is requested at most once per local root span
+    inline std::int64_t GetLocalRootSpanActiveTime(std::uint64_t localRootSpanId, std::int64_t nowNs);
+    inline bool TryStartBurstForLocalRootSpan(std::uint64_t localRootSpanId);
+
+    inline ThreadLabels& GetThreadLabels();
+
 private:
     static constexpr std::uint32_t MaxProfilerThreadInfoId = 0xFFFFFF; // = 16,777,215
     static std::atomic<std::uint32_t> s_nextProfilerThreadInfoId;
@@ -103,6 +115,13 @@ private:
 
 
      TraceContextTrackingInfo _traceContextTrackingInfo;
+
+    std::uint64_t _sampledLocalRootSpanId;
+    std::int64_t _sampledLocalRootSpanStartNs;
+    std::uint64_t _burstLocalRootSpanId;
+
+    // custom labels set by the application for the code running on this thread
+    ThreadLabels _threadLabels;
 };
 
 std::uint32_t ManagedThreadInfo::GetProfilerThreadInfoId(void) const
@@ -287,14 +306,46 @@ inline std::uint64_t ManagedThreadInfo::GetSpanId() const
     return _traceContextTrackingInfo._currentSpanId;
 }
 
+inline std::uint64_t ManagedThreadInfo::GetEndpointId() const
+{
+    return _traceContextTrackingInfo._currentEndpointId;
+}
+
 inline bool ManagedThreadInfo::CanReadTraceContext() const
 {
     bool canReadTraceContext = _traceContextTrackingInfo._writeGuard;
 
     // As said in the doc, on x86 (x86_64 including) this is a compiler fence.
     // In our case, it suffices. We have to make sure that reading this field is done
-    // before reading the _currentLocalRootSpanId and _currentSpandId.
+    // before reading the _currentLocalRootSpanId, _currentSpandId and _currentEndpointId.
     // On Arm the __sync_synchronize is generated.
     std::atomic_thread_fence(std::memory_order_acquire);
     return canReadTraceContext == 0;
 }
+
+inline std::int64_t ManagedThreadInfo::GetLocalRootSpanActiveTime(std::uint64_t localRootSpanId, std::int64_t nowNs)
+{
+    if (_sampledLocalRootSpanId != localRootSpanId)
+    {
+        _sampledLocalRootSpanId = localRootSpanId;
+        _sampledLocalRootSpanStartNs = nowNs;
+    }
+
+    return nowNs - _sampledLocalRootSpanStartNs;
+}
+
+inline bool ManagedThreadInfo::TryStartBurstForLocalRootSpan(std::uint64_t localRootSpanId)
+{
+    if (_burstLocalRootSpanId == localRootSpanId)
+    {
+        return false;
+    }
+
+    _burstLocalRootSpanId = localRootSpanId;
+    return true;
+}
+
+inline ThreadLabels& ManagedThreadInfo::GetThreadLabels()
+{
+    return _threadLabels;
+}
@@ -0,0 +1,121 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "NativeThreadList.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "OpSysTools.h"
+#include "OsSpecificApi.h"
+
+NativeThreadList::NativeThreadList(IManagedThreadList* pManagedThreadList) :
+    _pManagedThreadList{pManagedThreadList},
+    _managedThreadsIterator{pManagedThreadList->CreateIterator()},
+    _threads{},
+    _next{0},
+    _lastRefreshTimestamp{0}
+{
+}
+
+NativeThreadList::~NativeThreadList()
+{
+    for (auto* pThreadInfo : _threads)
+    {
+        pThreadInfo->Release();
+    }
+}
+
+void NativeThreadList::Refresh(DWORD excludedThreadId)
+{
+    auto now = OpSysTools::GetHighPrecisionNanoseconds();
+    if ((_lastRefreshTimestamp != 0) &&
+        (now - _lastRefreshTimestamp < std::chrono::duration_cast<std::chrono::nanoseconds>(RefreshPeriod).count()))
+    {
+        return;
+    }
+    _lastRefreshTimestamp = now;
+
+    // the managed threads are already sampled
+    std::unordered_set<DWORD> managedThreadIds;
+    auto managedThreadsCount = _pManagedThreadList->Count();
+    for (std::uint32_t i = 0; i < managedThreadsCount; i++)
+    {
+        auto* pThreadInfo = _pManagedThreadList->LoopNext(_managedThreadsIterator);
+        if (pThreadInfo != nullptr)
+        {
+            managedThreadIds.insert(pThreadInfo->GetOsThreadId());
+            pThreadInfo->Release();
+        }
+    }
+
+    // keep the same ManagedThreadInfo for the threads that are still there
+    std::unordered_map<DWORD, ManagedThreadInfo*> previousThreads;
+    for (auto* pThreadInfo : _threads)
+    {
+        previousThreads[pThreadInfo->GetOsThreadId()] = pThreadInfo;
+    }
+
+    std::vector<ManagedThreadInfo*> threads;
+    for (auto& [osThreadId, threadName] : OsSpecificApi::GetProcessThreads())
+    {
+        if ((osThreadId == excludedThreadId) || (managedThreadIds.find(osThreadId) != managedThreadIds.end()))
+        {
+            continue;
+        }
+
+        // the thread name (comm) can change after the thread started: the same ManagedThreadInfo is kept
+        // so that its CPU consumption is not counted again from the start of the thread
+        auto previous = previousThreads.find(osThreadId);
+        if (previous != previousThreads.end())
+        {
+            auto* pThreadInfo = previous->second;
+            if (pThreadInfo->GetThreadName() != threadName)
+            {
+                pThreadInfo->SetThreadName(std::move(threadName));
+            }
+
+            threads.push_back(pThreadInfo);
+            previousThreads.erase(previous);
+            continue;
+        }
+
+        // there is no thread handle for a native thread: the thread id is used
+        // so that the thread is not seen as "not yet associated to an OS thread"
+        auto* pThreadInfo = new ManagedThreadInfo(0);
+        pThreadInfo->AddRef();
+        pThreadInfo->SetOsInfo(osThreadId, reinterpret_cast<HANDLE>(static_cast<std::uintptr_t>(osThreadId)));
+        pThreadInfo->SetThreadName(std::move(threadName));
+        threads.push_back(pThreadInfo);
+    }
+
+    for (auto& [osThreadId, pThreadInfo] : previousThreads)
+    {
+        pThreadInfo->Release();
+    }
+
+    _threads = std::move(threads);
+    if (_next >= _threads.size())
+    {
+        _next = 0;
+    }
+}
+
+std::uint32_t NativeThreadList::Count() const
+{
+    return static_cast<std::uint32_t>(_threads.size());
+}
+
+ManagedThreadInfo* NativeThreadList::LoopNext()
+{
+    if (_threads.empty())
+    {
+        return nullptr;
+    }
+
+    auto* pThreadInfo = _threads[_next];
+    pThreadInfo->AddRef();
+
+    _next = (_next + 1) % _threads.size();
+    return pThreadInfo;
+}
@@ -0,0 +1,44 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "IManagedThreadList.h"
+#include "ManagedThreadInfo.h"
+
+// Threads of the process that are unknown to the CLR (i.e. GC, tiered compilation background worker, finalizer
+// or threads created by native libraries) are found by enumerating the threads of the process (only on Linux today).
+// They are represented by a ManagedThreadInfo without CLR thread id so that they can be sampled by the same walker
+// as the managed threads; their name is the one given by the kernel (i.e. comm).
+//
+// This class is not thread safe: it is expected to be used only by the StackSamplerLoop thread.
+class NativeThreadList
+{
+public:
+    NativeThreadList(IManagedThreadList* pManagedThreadList);
+    ~NativeThreadList();
+    NativeThreadList(NativeThreadList const&) = delete;
+    NativeThreadList& operator=(NativeThreadList const&) = delete;
+
+    // Enumerate the threads of the process if the previous enumeration is too old.
+    // The given thread (i.e. the sampling thread) is never part of the list.
+    void Refresh(DWORD excludedThreadId);
+
+    std::uint32_t Count() const;
+
+    // Loop over the native threads: the caller must release the returned thread
+    ManagedThreadInfo* LoopNext();
+
+private:
+    static constexpr std::chrono::milliseconds RefreshPeriod = std::chrono::milliseconds(1000);
+
+    IManagedThreadList* _pManagedThreadList;
+    std::uint32_t _managedThreadsIterator;
+    std::vector<ManagedThreadInfo*> _threads;
+    std::size_t _next;
+    std::int64_t _lastRefreshTimestamp;
+};
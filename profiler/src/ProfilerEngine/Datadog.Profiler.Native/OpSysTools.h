@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <thread>
 
@@ -32,6 +33,12 @@ public:
 
     static bool InitHighPrecisionTimer(void);
 
+    /// <summary>
+    /// Gets the number of milliseconds elapsed since the Unix epoch (UTC).
+    /// Unlike <i>time(..)</i>, this does not allocate and can be used to timestamp samples.
+    /// </summary>
+    static inline std::uint64_t GetUnixTimeMilliseconds(void);
+
     static inline bool QueryThreadCycleTime(HANDLE handle, PULONG64 cycleTime);
     static inline HANDLE GetCurrentProcess();
 
@@ -101,6 +108,12 @@ inline std::int64_t OpSysTools::GetHighPrecisionNanoseconds(void)
 #endif
 }
 
+inline std::uint64_t OpSysTools::GetUnixTimeMilliseconds(void)
+{
+    auto sinceEpoch = std::chrono::system_clock::now().time_since_epoch();
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(sinceEpoch).count());
+}
+
 inline bool OpSysTools::QueryThreadCycleTime(HANDLE handle, PULONG64 cycleTime)
 {
 #ifdef _WINDOWS
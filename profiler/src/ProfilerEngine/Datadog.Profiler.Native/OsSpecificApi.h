@@ -2,10 +2,15 @@
 // This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
 
 #pragma once
+#include <utility>
+#include <vector>
+
 #include "cor.h"
 #include "corprof.h"
 
 #include "StackFramesCollectorBase.h"
+#include "ThreadState.h"
+#include "shared/src/native-src/string.h"
 
 // forward declarations
 namespace shared {
@@ -23,4 +28,8 @@ void InitializeLoaderResourceMonikerIDs(shared::LoaderResourceMonikerIDs* monike
 std::unique_ptr<StackFramesCollectorBase> CreateNewStackFramesCollectorInstance(ICorProfilerInfo4* pCorProfilerInfo);
 uint64_t GetThreadCpuTime(ManagedThreadInfo* pThreadInfo);
 bool IsRunning(ManagedThreadInfo* pThreadInfo, uint64_t& cpuTime);
+ThreadState GetThreadState(ManagedThreadInfo* pThreadInfo);
+
+// OS thread id and name of the threads of the current process that can be sampled
+std::vector<std::pair<DWORD, shared::WSTRING>> GetProcessThreads();
 }
\ No newline at end of file
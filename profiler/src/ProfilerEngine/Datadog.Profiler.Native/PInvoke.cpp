@@ -7,6 +7,7 @@
 #include "Log.h"
 #include "ManagedThreadList.h"
 #include "ProfilerEngineStatus.h"
+#include "StackSamplerLoopManager.h"
 #include "ThreadsCpuManager.h"
 
 #include "shared/src/native-src/loader.h"
@@ -93,6 +94,118 @@ extern "C" void* __stdcall GetPointerToNativeTraceContext()
     return pCurrentThreadInfo->GetTraceContextPointer();
 }
 
+extern "C" std::uint64_t __stdcall RegisterEndpoint(const char* endpoint)
+{
+    if (!CorProfilerCallback::GetClrLifetime()->IsRunning())
+    {
+        return 0;
+    }
+
+    const auto profiler = CorProfilerCallback::GetInstance();
+    if (profiler == nullptr)
+    {
+        Log::Error("RegisterEndpoint is called BEFORE CLR initialize");
+        return 0;
+    }
+
+    if ((endpoint == nullptr) || (*endpoint == '\0'))
+    {
+        return 0;
+    }
+
+    // the returned id is written by the tracer into the trace context of the threads processing this endpoint
+    return profiler->GetEndpointStore()->Register(endpoint);
+}
+
+static ManagedThreadInfo* GetCurrentThreadInfo(const char* caller)
+{
+    if (!CorProfilerCallback::GetClrLifetime()->IsRunning())
+    {
+        return nullptr;
+    }
+
+    const auto profiler = CorProfilerCallback::GetInstance();
+    if (profiler == nullptr)
+    {
+        Log::Error(caller, " is called BEFORE CLR initialize");
+        return nullptr;
+    }
+
+    ManagedThreadInfo* pCurrentThreadInfo;
+    HRESULT hr = profiler->GetManagedThreadList()->TryGetCurrentThreadInfo(&pCurrentThreadInfo);
+    if (hr != S_OK)
+    {
+        // either an error or the current thread is not tracked
+        return nullptr;
+    }
+
+    return pCurrentThreadInfo;
+}
+
+extern "C" BOOL __stdcall SetThreadLabel(const char* key, const char* value)
+{
+    if ((key == nullptr) || (*key == '\0'))
+    {
+        return FALSE;
+    }
+
+    auto pCurrentThreadInfo = GetCurrentThreadInfo("SetThreadLabel");
+    if (pCurrentThreadInfo == nullptr)
+    {
+        return FALSE;
+    }
+
+    // the slots are only written by the current thread: no lock is needed besides the interning of the texts
+    auto pThreadLabelsStore = CorProfilerCallback::GetInstance()->GetThreadLabelsStore();
+    auto keyId = pThreadLabelsStore->Intern(key);
+    if (keyId == 0)
+    {
+        return FALSE;
+    }
+
+    // a null or empty value removes the label
+    std::uint32_t valueId = 0;
+    if ((value != nullptr) && (*value != '\0'))
+    {
+        valueId = pThreadLabelsStore->Intern(value);
+        if (valueId == 0)
+        {
+            return FALSE;
+        }
+    }
+
+    return pCurrentThreadInfo->GetThreadLabels().Set(keyId, valueId) ? TRUE : FALSE;
+}
+
+extern "C" void __stdcall ClearThreadLabels()
+{
+    auto pCurrentThreadInfo = GetCurrentThreadInfo("ClearThreadLabels");
+    if (pCurrentThreadInfo == nullptr)
+    {
+        return;
+    }
+
+    pCurrentThreadInfo->GetThreadLabels().Reset(nullptr, 0);
+}
+
+extern "C" BOOL __stdcall StartBurstSampling(std::int32_t durationMs, std::uint64_t spanId)
+{
+    if (durationMs <= 0)
+    {
+        return FALSE;
+    }
+
+    auto pCurrentThreadInfo = GetCurrentThreadInfo("StartBurstSampling");
+    if (pCurrentThreadInfo == nullptr)
+    {
+        return FALSE;
+    }
+
+    // the current thread is sampled at a higher rate by the StackSamplerLoop within a global overhead budget
+    auto pStackSamplerLoopManager = CorProfilerCallback::GetInstance()->GetStackSamplerLoopManager();
+    return pStackSamplerLoopManager->StartBurstSampling(pCurrentThreadInfo, std::chrono::milliseconds(durationMs), spanId) ? TRUE : FALSE;
+}
+
 extern "C" void __stdcall SetApplicationInfoForAppDomain(const char* runtimeId, const char* serviceName, const char* environment, const char* version)
 {
     if (!CorProfilerCallback::GetClrLifetime()->IsRunning())
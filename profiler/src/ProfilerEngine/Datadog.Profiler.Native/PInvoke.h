@@ -40,4 +40,12 @@ extern "C" void* __stdcall GetNativeProfilerIsReadyPtr();
 
 extern "C" void* __stdcall GetPointerToNativeTraceContext();
 
+extern "C" std::uint64_t __stdcall RegisterEndpoint(const char* endpoint);
+
+extern "C" BOOL __stdcall SetThreadLabel(const char* key, const char* value);
+
+extern "C" void __stdcall ClearThreadLabels();
+
+extern "C" BOOL __stdcall StartBurstSampling(std::int32_t durationMs, std::uint64_t spanId);
+
 extern "C" void __stdcall SetApplicationInfoForAppDomain(const char* runtimeId, const char* serviceName, const char* environment, const char* version);
\ No newline at end of file
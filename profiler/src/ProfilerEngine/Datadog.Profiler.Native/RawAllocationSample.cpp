@@ -0,0 +1,10 @@
+#include "RawAllocationSample.h"
+
+#include <cmath>
+
+std::int64_t RawAllocationSample::GetUpscaledAllocationSize() const
+{
+    return (SamplingProbability > 0)
+               ? std::llround(static_cast<double>(AllocationSize) / SamplingProbability)
+               : static_cast<std::int64_t>(AllocationSize);
+}
@@ -0,0 +1,22 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+#include <string>
+
+#include "RawSample.h"
+
+class RawAllocationSample : public RawSample
+{
+public:
+    std::string AllocationClass;
+
+    // bytes allocated since the previous AllocationTick event
+    std::uint64_t AllocationSize;
+
+    // probability for this AllocationTick event to be sampled: used to upscale the exported size
+    double SamplingProbability;
+
+public:
+    std::int64_t GetUpscaledAllocationSize() const;
+};
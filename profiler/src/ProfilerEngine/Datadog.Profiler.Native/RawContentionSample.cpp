@@ -0,0 +1 @@
+#include "RawContentionSample.h"
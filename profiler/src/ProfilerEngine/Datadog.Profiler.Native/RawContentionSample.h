@@ -0,0 +1,15 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include "RawSample.h"
+
+class RawContentionSample : public RawSample
+{
+public:
+    double ContentionDuration; // in nanoseconds
+
+    // probability for this contention to be sampled: used to upscale the exported count and duration
+    double SamplingProbability;
+};
@@ -1,8 +1,14 @@
 #pragma once
+#include <memory>
+
 #include "RawSample.h"
 class RawExceptionSample : public RawSample
 {
 public:
-    std::string ExceptionMessage;
+    // interned by ExceptionMessagesCache: identical messages share the same string
+    std::shared_ptr<const std::string> ExceptionMessage;
     std::string ExceptionType;
+
+    // probability for this exception to be sampled: used to upscale the exported count
+    double SamplingProbability;
 };
@@ -9,6 +9,8 @@ RawSample::RawSample()
     AppDomainId {0},
     LocalRootSpanId {0},
     SpanId {0},
+    EndpointId {0},
+    ThreadLabels {},
     ThreadInfo{nullptr},
     Stack{}
 {
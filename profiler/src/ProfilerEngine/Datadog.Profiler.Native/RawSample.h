@@ -8,6 +8,7 @@
 #include "cor.h"
 #include "corprof.h"
 #include "ManagedThreadInfo.h"
+#include "ThreadLabels.h"
 
 
 class RawSample
@@ -17,10 +18,12 @@ public:
     virtual ~RawSample() = default;
 
 public:
-    std::uint64_t Timestamp;        // _unixTimeUtc;
+    std::uint64_t Timestamp;        // _unixTimeUtc (in milliseconds);
     AppDomainID AppDomainId;
     std::uint64_t LocalRootSpanId;  // _localRootSpanId;
     std::uint64_t SpanId;           // _spanId;
+    std::uint64_t EndpointId;       // _endpointId (interned by the IEndpointStore)
+    ThreadLabelsArray ThreadLabels; // custom labels (interned by the IThreadLabelsStore)
     ManagedThreadInfo* ThreadInfo;
 
     // array of instruction pointers (32 or 64 bit address)
@@ -8,10 +8,20 @@
 #include "corprof.h"
 #include "ManagedThreadInfo.h"
 #include "RawSample.h"
+#include "ThreadState.h"
 
 
 class RawWallTimeSample : public RawSample
 {
 public:
     std::uint64_t  Duration;  // in nanoseconds
+
+    // reason of the runtime suspension (i.e. "gc") in progress when the sample was taken, nullptr if none
+    const char* RuntimeSuspensionReason = nullptr;
+
+    // scheduler state of the thread read right before its stack was walked
+    ThreadState State = ThreadState::Unknown;
+
+    // span for which the thread was marked as hot by the tracer (see HotThreadList), 0 for regular samples
+    std::uint64_t BurstSpanId = 0;
 };
@@ -12,6 +12,16 @@ const std::string Sample::LocalRootSpanIdLabel = "local root span id";
 const std::string Sample::SpanIdLabel = "span id";
 const std::string Sample::ExceptionTypeLabel = "exception type";
 const std::string Sample::ExceptionMessageLabel = "exception message";
+const std::string Sample::TimelineDeltaLabel = "timestamp delta";
+const std::string Sample::AllocationClassLabel = "allocation class";
+const std::string Sample::GarbageCollectionGenerationLabel = "gc generation";
+const std::string Sample::GarbageCollectionReasonLabel = "gc reason";
+const std::string Sample::RuntimeSuspensionLabel = "runtime suspension";
+const std::string Sample::ThreadStateLabel = "thread state";
+const std::string Sample::JitTierLabel = "jit tier";
+const std::string Sample::JitSafeToBlockLabel = "jit safe to block";
+const std::string Sample::EndpointLabel = "endpoint";
+const std::string Sample::BurstSpanIdLabel = "burst span id";
 
 
 Sample::Sample(uint64_t timestamp, std::string_view runtimeId) :
@@ -86,6 +96,13 @@ void Sample::AddFrame(const std::string& moduleName, const std::string& frame)
     _callstack.push_back({ moduleName, frame });
 }
 
+void Sample::AddRuntimeFrame(const std::string& functionName)
+{
+    static const std::string RuntimeModuleName("CLR");
+
+    _callstack.push_back({RuntimeModuleName, "|lm:CLR |ns:CLR |ct:CLR |fn:" + functionName});
+}
+
 const std::vector<std::pair<std::string, std::string>>& Sample::GetCallstack() const
 {
     return _callstack;
@@ -23,6 +23,19 @@ SampleValueType const SampleTypeDefinitions[] =
     {"wall", "nanoseconds"}, // WallTimeDuration
     {"cpu", "nanoseconds"},  // CPUTimeDuration
     {"exception", "count"},
+    {"exception-upscaled", "count"},
+    {"exception-thrown", "count"},
+    {"alloc-samples", "count"},
+    {"alloc-size", "bytes"},
+    {"lock-count", "count"},
+    {"lock-time", "nanoseconds"},
+    {"gc-count", "count"},
+    {"suspension-time", "nanoseconds"},
+    {"inuse-objects", "count"},
+    {"inuse-space", "bytes"},
+    {"jit-count", "count"},
+    {"jit-time", "nanoseconds"},
+    {"gc-pause-time", "nanoseconds"},
 
     // the new ones should be added here at the same time
     // new identifiers are added to SampleValue
@@ -40,14 +53,32 @@ enum class SampleValue : size_t
     CpuTimeDuration = 1,
 
     // Exception profiler
-    ExceptionCount = 2,
+    ExceptionCount = 2,          // sampled exceptions
+    ExceptionUpscaledCount = 3,  // sampled exceptions upscaled by their sampling probability
+    ExceptionThrownCount = 4,    // exact count of thrown exceptions per type (no callstack)
 
     // Allocation tick profiler
-    //AllocationCount = 3,
+    AllocationCount = 5,         // sampled AllocationTick events
+    AllocationSize = 6,          // bytes allocated since the previous AllocationTick event, upscaled by the sampling probability
 
     // Thread contention profiler
-    //ContentionCount = 4,
-    //ContentionDuration = 5,
+    ContentionCount = 7,         // lock contentions upscaled by their sampling probability
+    ContentionDuration = 8,      // time spent waiting for the lock, upscaled by the sampling probability
+
+    // Garbage collection profiler
+    GarbageCollectionCount = 9,      // garbage collections that suspended the runtime (no callstack)
+    RuntimeSuspensionDuration = 10,  // duration of the runtime suspensions, with or without garbage collection (no callstack)
+
+    // Live heap profiler
+    LiveObjectCount = 11,        // sampled allocations still alive when the profile is exported
+    LiveObjectSize = 12,         // bytes allocated since the previous AllocationTick event of a live object, upscaled by the sampling probability
+
+    // JIT compilation profiler
+    JitCompilationCount = 13,    // compilations of the method (one per tier)
+    JitCompilationDuration = 14, // time spent in the JIT compiler, from JITCompilationStarted to JITCompilationFinished
+
+    // Garbage collection profiler
+    GarbageCollectionPauseDuration = 15, // time spent in the garbage collection, from GarbageCollectionStarted to GarbageCollectionFinished (no callstack)
 
 
 };
@@ -87,6 +118,10 @@ public:
     // and a Sample in each Provider (this is the each behind CollectorBase template class)
     void AddValue(std::int64_t value, SampleValue index);
     void AddFrame(const std::string& moduleName, const std::string& frame); // TODO: use stringview to avoid copy
+
+    // samples without callstack are dropped by the aggregator: runtime-level values (i.e. thrown exceptions counts)
+    // are attached to a single fake CLR frame instead
+    void AddRuntimeFrame(const std::string& functionName);
     void AddLabel(const Label& label);
 
     // helpers for well known mandatory labels
@@ -105,6 +140,16 @@ public:
     static const std::string SpanIdLabel;
     static const std::string ExceptionTypeLabel;
     static const std::string ExceptionMessageLabel;
+    static const std::string TimelineDeltaLabel;
+    static const std::string AllocationClassLabel;
+    static const std::string GarbageCollectionGenerationLabel;
+    static const std::string GarbageCollectionReasonLabel;
+    static const std::string RuntimeSuspensionLabel;
+    static const std::string ThreadStateLabel;
+    static const std::string JitTierLabel;
+    static const std::string JitSafeToBlockLabel;
+    static const std::string EndpointLabel;
+    static const std::string BurstSpanIdLabel;
 
 private:
     uint64_t _timestamp;
@@ -72,6 +72,11 @@ void SamplesAggregator::Register(ISamplesProvider* samplesProvider)
     _samplesProviders.push_front(samplesProvider);
 }
 
+void SamplesAggregator::RegisterSnapshotProvider(ISamplesProvider* samplesProvider)
+{
+    _snapshotProviders.push_front(samplesProvider);
+}
+
 void SamplesAggregator::Work()
 {
     _pThreadsCpuManager->Map(OpSysTools::GetThreadId(), WorkerThreadName);
@@ -97,7 +102,12 @@ void SamplesAggregator::Work()
 
 void SamplesAggregator::ProcessSamples()
 {
-    auto samples = CollectSamples();
+    Add(CollectSamples());
+    Export();
+}
+
+void SamplesAggregator::Add(std::list<Sample> const& samples)
+{
     for (auto const& sample : samples)
     {
         if (!sample.GetCallstack().empty())
@@ -105,7 +115,6 @@ void SamplesAggregator::ProcessSamples()
             _exporter->Add(sample);
         }
     }
-    Export();
 }
 
 std::list<Sample> SamplesAggregator::CollectSamples()
@@ -120,6 +129,18 @@ std::list<Sample> SamplesAggregator::CollectSamples()
     return result;
 }
 
+std::list<Sample> SamplesAggregator::CollectSnapshotSamples()
+{
+    auto result = std::list<Sample>{};
+
+    for (auto const& samplesProvider : _snapshotProviders)
+    {
+        result.splice(result.cend(), samplesProvider->GetSamples());
+    }
+
+    return result;
+}
+
 void SamplesAggregator::Export()
 {
     auto now = std::chrono::steady_clock::now();
@@ -129,6 +150,8 @@ void SamplesAggregator::Export()
     {
         _nextExportTime = now + _uploadInterval;
 
+        Add(CollectSnapshotSamples());
+
         auto success = _exporter->Export();
 
         SendHeartBeatMetric(success);
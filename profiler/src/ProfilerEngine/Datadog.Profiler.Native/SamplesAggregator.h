@@ -32,10 +32,16 @@ public:
 
     void Register(ISamplesProvider* sampleProvider);
 
+    // the samples of these providers describe the state of the application (i.e. live objects)
+    // so they are only collected right before a profile is exported
+    void RegisterSnapshotProvider(ISamplesProvider* sampleProvider);
+
 private:
     void Work();
     void ProcessSamples();
     std::list<Sample> CollectSamples();
+    std::list<Sample> CollectSnapshotSamples();
+    void Add(std::list<Sample> const& samples);
     void Export();
     void SendHeartBeatMetric(bool success);
 
@@ -47,6 +53,7 @@ private:
     std::chrono::seconds _uploadInterval;
     std::chrono::time_point<std::chrono::steady_clock> _nextExportTime;
     std::forward_list<ISamplesProvider*> _samplesProviders;
+    std::forward_list<ISamplesProvider*> _snapshotProviders;
     IExporter* _exporter;
     IThreadsCpuManager* _pThreadsCpuManager;
     std::thread _worker;
@@ -107,13 +107,28 @@ bool StackFramesCollectorBase::TryApplyTraceContextDataFromCurrentCollectionThre
 {
     // If TraceContext Tracking is not enabled, then we will simply get zero IDs.
     ManagedThreadInfo* pCurrentCollectionThreadInfo = _pCurrentCollectionThreadInfo;
-    if (nullptr != pCurrentCollectionThreadInfo && pCurrentCollectionThreadInfo->CanReadTraceContext())
+    if (nullptr == pCurrentCollectionThreadInfo)
+    {
+        return false;
+    }
+
+    // The custom labels are protected by their own sequence (independent from the trace context write guard):
+    // they are simply missing from this sample if the thread was interrupted while updating them.
+    auto& threadLabels = _pReusableStackSnapshotResult->GetThreadLabels();
+    if (!pCurrentCollectionThreadInfo->GetThreadLabels().TryCopy(threadLabels))
+    {
+        threadLabels.fill({0, 0});
+    }
+
+    if (pCurrentCollectionThreadInfo->CanReadTraceContext())
     {
         std::uint64_t localRootSpanId = pCurrentCollectionThreadInfo->GetLocalRootSpanId();
         std::uint64_t spanId = pCurrentCollectionThreadInfo->GetSpanId();
+        std::uint64_t endpointId = pCurrentCollectionThreadInfo->GetEndpointId();
 
         _pReusableStackSnapshotResult->SetLocalRootSpanId(localRootSpanId);
         _pReusableStackSnapshotResult->SetSpanId(spanId);
+        _pReusableStackSnapshotResult->SetEndpointId(endpointId);
 
         return true;
     }
@@ -0,0 +1,97 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "StackFramesCollectorPool.h"
+
+#include "Log.h"
+#include "OsSpecificApi.h"
+
+StackFramesCollectorPool::StackFramesCollectorPool(ICorProfilerInfo4* pCorProfilerInfo) :
+    StackFramesCollectorPool([pCorProfilerInfo]() { return OsSpecificApi::CreateNewStackFramesCollectorInstance(pCorProfilerInfo); })
+{
+}
+
+StackFramesCollectorPool::StackFramesCollectorPool(CollectorFactory createCollector) :
+    _createCollector{std::move(createCollector)},
+    _createdCollectorsCount{0}
+{
+    _collectors.reserve(MaxPooledCollectors);
+}
+
+StackFramesCollectorPool::Lease StackFramesCollectorPool::Acquire()
+{
+    std::uint64_t createdCollectorsCount;
+    {
+        std::lock_guard<std::mutex> lock(_collectorsLock);
+
+        if (!_collectors.empty())
+        {
+            auto pCollector = std::move(_collectors.back());
+            _collectors.pop_back();
+            return Lease(this, std::move(pCollector));
+        }
+
+        createdCollectorsCount = ++_createdCollectorsCount;
+    }
+
+    // the pool is empty: create a new collector outside of the lock
+    Log::Debug("StackFramesCollectorPool: creating a new stack frames collector (", createdCollectorsCount, " created so far)");
+    return Lease(this, _createCollector());
+}
+
+std::uint64_t StackFramesCollectorPool::GetCreatedCollectorsCount()
+{
+    std::lock_guard<std::mutex> lock(_collectorsLock);
+    return _createdCollectorsCount;
+}
+
+void StackFramesCollectorPool::Release(std::unique_ptr<StackFramesCollectorBase> pCollector)
+{
+    if (pCollector == nullptr)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_collectorsLock);
+
+        if (_collectors.size() < MaxPooledCollectors)
+        {
+            _collectors.push_back(std::move(pCollector));
+            return;
+        }
+    }
+
+    // pCollector is destroyed here, outside of the lock
+}
+
+//
+// StackFramesCollectorPool::Lease class
+//
+
+StackFramesCollectorPool::Lease::Lease(StackFramesCollectorPool* pPool, std::unique_ptr<StackFramesCollectorBase> pCollector) :
+    _pPool{pPool},
+    _pCollector{std::move(pCollector)}
+{
+}
+
+StackFramesCollectorPool::Lease::Lease(Lease&& other) noexcept :
+    _pPool{other._pPool},
+    _pCollector{std::move(other._pCollector)}
+{
+}
+
+StackFramesCollectorPool::Lease::~Lease()
+{
+    _pPool->Release(std::move(_pCollector));
+}
+
+StackFramesCollectorBase* StackFramesCollectorPool::Lease::operator->() const
+{
+    return _pCollector.get();
+}
+
+StackFramesCollectorBase* StackFramesCollectorPool::Lease::Get() const
+{
+    return _pCollector.get();
+}
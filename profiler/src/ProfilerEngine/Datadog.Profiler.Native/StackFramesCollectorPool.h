@@ -0,0 +1,63 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "cor.h"
+#include "corprof.h"
+
+#include "StackFramesCollectorBase.h"
+
+// Keeps stack frames collectors (and their snapshot buffer) alive between synchronous collections
+// done on the current thread (i.e. when an exception is thrown) instead of creating and destroying
+// a collector each time.
+class StackFramesCollectorPool
+{
+public:
+    // Gives exclusive access to a pooled collector and puts it back into the pool when destroyed
+    class Lease
+    {
+    public:
+        Lease(StackFramesCollectorPool* pPool, std::unique_ptr<StackFramesCollectorBase> pCollector);
+        ~Lease();
+
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) = delete;
+        Lease(Lease const&) = delete;
+        Lease& operator=(Lease const&) = delete;
+
+        StackFramesCollectorBase* operator->() const;
+        StackFramesCollectorBase* Get() const;
+
+    private:
+        StackFramesCollectorPool* _pPool;
+        std::unique_ptr<StackFramesCollectorBase> _pCollector;
+    };
+
+public:
+    using CollectorFactory = std::function<std::unique_ptr<StackFramesCollectorBase>()>;
+
+    StackFramesCollectorPool(ICorProfilerInfo4* pCorProfilerInfo);
+    StackFramesCollectorPool(CollectorFactory createCollector);
+
+    Lease Acquire();
+    std::uint64_t GetCreatedCollectorsCount();
+
+private:
+    void Release(std::unique_ptr<StackFramesCollectorBase> pCollector);
+
+private:
+    // Collectors in excess (more threads throwing at the same time) are destroyed when released
+    // to avoid keeping too many snapshot buffers alive
+    static const std::size_t MaxPooledCollectors = 16;
+
+    CollectorFactory _createCollector;
+    std::vector<std::unique_ptr<StackFramesCollectorBase>> _collectors;
+    std::mutex _collectorsLock;
+    std::uint64_t _createdCollectorsCount;
+};
@@ -33,6 +33,7 @@
 using namespace std::chrono_literals;
 constexpr std::chrono::nanoseconds SamplingPeriod = 9ms;
 constexpr uint64_t SamplingPeriodMs = SamplingPeriod.count() / 1000000;
+constexpr std::chrono::nanoseconds BurstSamplingPeriod = 1ms;
 constexpr int32_t MaxThreadsPerIterationForWallTime = 5;
 constexpr int32_t MaxThreadsPerIterationForCpuTime = 60;
 constexpr const WCHAR* ThreadName = WStr("DD.Profiler.StackSamplerLoop.Thread");
@@ -53,7 +54,9 @@ StackSamplerLoop::StackSamplerLoop(
     IThreadsCpuManager* pThreadsCpuManager,
     IManagedThreadList* pManagedThreadList,
     ICollector<RawWallTimeSample>* pWallTimeCollector,
-    ICollector<RawCpuSample>* pCpuTimeCollector)
+    ICollector<RawCpuSample>* pCpuTimeCollector,
+    IRuntimeSuspensionState* pRuntimeSuspensionState,
+    HotThreadList* pHotThreadList)
     :
     _pCorProfilerInfo{pCorProfilerInfo},
     _pConfiguration{pConfiguration},
@@ -63,6 +66,10 @@ StackSamplerLoop::StackSamplerLoop(
     _pManagedThreadList{pManagedThreadList},
     _pWallTimeCollector{pWallTimeCollector},
     _pCpuTimeCollector{pCpuTimeCollector},
+    _pRuntimeSuspensionState{pRuntimeSuspensionState},
+    _pHotThreadList{pHotThreadList},
+    _burstSamplingThreshold{pConfiguration->GetBurstSamplingThreshold()},
+    _burstSamplingDuration{pConfiguration->GetBurstSamplingDuration()},
     _pLoopThread{nullptr},
     _loopThreadOsId{0},
     _targetThread(nullptr),
@@ -74,6 +81,16 @@ StackSamplerLoop::StackSamplerLoop(
     _iteratorWallTime = _pManagedThreadList->CreateIterator();
     _iteratorCpuTime = _pManagedThreadList->CreateIterator();
 
+    if (_pConfiguration->IsCpuProfilingEnabled() && _pConfiguration->IsNativeThreadsProfilingEnabled())
+    {
+        _pNativeThreadList = std::make_unique<NativeThreadList>(_pManagedThreadList);
+
+        if (!_pConfiguration->IsNativeFramesEnabled())
+        {
+            Log::Warn("Native threads are sampled but their frames are not resolved: DD_PROFILING_FRAMES_NATIVE_ENABLED should be set.");
+        }
+    }
+
     _pLoopThread = new std::thread(&StackSamplerLoop::MainLoop, this);
     OpSysTools::SetNativeThreadName(_pLoopThread, ThreadName);
 }
@@ -154,7 +171,26 @@ void StackSamplerLoop::MainLoop()
 
 void StackSamplerLoop::WaitOnePeriod(void)
 {
-    std::this_thread::sleep_for(SamplingPeriod);
+    if ((_pHotThreadList == nullptr) || _pHotThreadList->IsEmpty())
+    {
+        std::this_thread::sleep_for(SamplingPeriod);
+        return;
+    }
+
+    // The threads marked as hot by the tracer are sampled at a higher rate between two regular iterations
+    int64_t periodEndNanosecs = OpSysTools::GetHighPrecisionNanoseconds() + SamplingPeriod.count();
+    while (!_shutdownRequested)
+    {
+        std::this_thread::sleep_for(BurstSamplingPeriod);
+
+        int64_t nowNanosecs = OpSysTools::GetHighPrecisionNanoseconds();
+        if (nowNanosecs >= periodEndNanosecs)
+        {
+            break;
+        }
+
+        BurstSamplingIteration(nowNanosecs);
+    }
 }
 
 void StackSamplerLoop::MainLoopIteration(void)
@@ -185,7 +221,17 @@ void StackSamplerLoop::WalltimeProfilingIteration(void)
             int64_t prevSampleTimestampNanosecs = _targetThread->SetLastSampleHighPrecisionTimestampNanoseconds(thisSampleTimestampNanosecs);
             int64_t duration = ComputeWallTime(thisSampleTimestampNanosecs, prevSampleTimestampNanosecs);
 
-            CollectOneThreadStackSample(_targetThread, thisSampleTimestampNanosecs, duration, PROFILING_TYPE::WallTime);
+            // the state must be read before the stack walk: on Linux, the signal wakes the thread up
+            auto threadState = OsSpecificApi::GetThreadState(_targetThread);
+
+            CollectOneThreadStackSample(_targetThread, thisSampleTimestampNanosecs, duration, PROFILING_TYPE::WallTime, threadState, 0);
+
+            // a request that stays on the thread for longer than the threshold is sampled at a higher rate
+            // even when the tracer does not activate another span
+            if (_pHotThreadList != nullptr)
+            {
+                _pHotThreadList->AddIfSlow(_targetThread, _burstSamplingThreshold, _burstSamplingDuration, thisSampleTimestampNanosecs);
+            }
 
             // LoopNext() calls AddRef() on the threadInfo before returning it.
             // This is because it needs to happen under the managedThreads's internal lock
@@ -202,6 +248,38 @@ void StackSamplerLoop::WalltimeProfilingIteration(void)
     }
 }
 
+void StackSamplerLoop::BurstSamplingIteration(int64_t nowNanosecs)
+{
+    if (!_pHotThreadList->HasBudget(nowNanosecs))
+    {
+        return;
+    }
+
+    // the returned threads are AddRef'ed
+    _pHotThreadList->GetThreadsToSample(nowNanosecs, _hotThreads);
+
+    for (auto const& hotThread : _hotThreads)
+    {
+        int64_t thisSampleTimestampNanosecs = OpSysTools::GetHighPrecisionNanoseconds();
+        if (!_shutdownRequested && _pHotThreadList->HasBudget(thisSampleTimestampNanosecs))
+        {
+            // Sharing the last sample timestamp with the regular wall time sampling ensures that the wall time
+            // of the thread is not counted twice: the burst samples only make it more precise
+            int64_t prevSampleTimestampNanosecs = hotThread.ThreadInfo->SetLastSampleHighPrecisionTimestampNanoseconds(thisSampleTimestampNanosecs);
+            int64_t duration = ComputeWallTime(thisSampleTimestampNanosecs, prevSampleTimestampNanosecs);
+            auto threadState = OsSpecificApi::GetThreadState(hotThread.ThreadInfo);
+
+            CollectOneThreadStackSample(hotThread.ThreadInfo, thisSampleTimestampNanosecs, duration, PROFILING_TYPE::WallTime, threadState, hotThread.SpanId);
+
+            _pHotThreadList->AddBurstSampleCost(OpSysTools::GetHighPrecisionNanoseconds() - thisSampleTimestampNanosecs);
+        }
+
+        hotThread.ThreadInfo->Release();
+    }
+
+    _hotThreads.clear();
+}
+
 void StackSamplerLoop::CpuProfilingIteration(void)
 {
     int managedThreadsCount = _pManagedThreadList->Count();
@@ -213,33 +291,7 @@ void StackSamplerLoop::CpuProfilingIteration(void)
         _targetThread = _pManagedThreadList->LoopNext(_iteratorCpuTime);
         if (_targetThread != nullptr)
         {
-            // sample only if the thread is currently running on a core
-            uint64_t currentConsumption = 0;
-            uint64_t lastConsumption = _targetThread->GetCpuConsumptionMilliseconds();
-            bool isRunning = OsSpecificApi::IsRunning(_targetThread, currentConsumption);
-            // Note: it is not possible to get this information on Windows 32-bit
-            //       so true is returned if this thread consumed some CPU since
-            //       the last iteration
-#if _WINDOWS
-    #if BIT64  // nothing to do for Windows 64-bit
-    #else  // Windows 32-bit
-            isRunning = (lastConsumption < currentConsumption);
-    #endif
-#else  // nothing to do for Linux
-#endif
-
-            if (isRunning)
-            {
-                _targetThread->SetCpuConsumptionMilliseconds(currentConsumption);
-                uint64_t cpuForSample = currentConsumption - lastConsumption;
-
-                // we don't collect a sample for this thread is no CPU was consumed since the last check
-                if (cpuForSample > 0)
-                {
-                    int64_t thisSampleTimestampNanosecs = OpSysTools::GetHighPrecisionNanoseconds();
-                    CollectOneThreadStackSample(_targetThread, thisSampleTimestampNanosecs, cpuForSample, PROFILING_TYPE::CpuTime);
-                }
-            }
+            CollectCpuSampleIfRunning(_targetThread);
             // don't yield until a thread to sample is found
 
             // LoopNext() calls AddRef() on the threadInfo before returning it.
@@ -251,13 +303,75 @@ void StackSamplerLoop::CpuProfilingIteration(void)
 
         }
     }
+
+    if (_pNativeThreadList != nullptr)
+    {
+        NativeThreadsCpuProfilingIteration();
+    }
+}
+
+void StackSamplerLoop::NativeThreadsCpuProfilingIteration(void)
+{
+    // the CLR internal threads (GC, JIT, finalizer...) and the threads created by native libraries
+    // are unknown to the ManagedThreadList: they are found by enumerating the threads of the process
+    _pNativeThreadList->Refresh(_loopThreadOsId);
+
+    int nativeThreadsCount = _pNativeThreadList->Count();
+    int sampledThreadsCount = (std::min)(nativeThreadsCount, MaxThreadsPerIterationForCpuTime);
+
+    for (int i = 0; i < sampledThreadsCount && !_shutdownRequested; i++)
+    {
+        _targetThread = _pNativeThreadList->LoopNext();
+        if (_targetThread != nullptr)
+        {
+            CollectCpuSampleIfRunning(_targetThread);
+
+            _targetThread->Release();
+            _targetThread = nullptr;
+        }
+    }
+}
+
+void StackSamplerLoop::CollectCpuSampleIfRunning(ManagedThreadInfo* pThreadInfo)
+{
+    // sample only if the thread is currently running on a core
+    uint64_t currentConsumption = 0;
+    uint64_t lastConsumption = pThreadInfo->GetCpuConsumptionMilliseconds();
+    bool isRunning = OsSpecificApi::IsRunning(pThreadInfo, currentConsumption);
+    // Note: it is not possible to get this information on Windows 32-bit
+    //       so true is returned if this thread consumed some CPU since
+    //       the last iteration
+#if _WINDOWS
+    #if BIT64  // nothing to do for Windows 64-bit
+    #else  // Windows 32-bit
+    isRunning = (lastConsumption < currentConsumption);
+    #endif
+#else  // nothing to do for Linux
+#endif
+
+    if (isRunning)
+    {
+        pThreadInfo->SetCpuConsumptionMilliseconds(currentConsumption);
+
+        // a native thread id could have been reused by a new thread that consumed less CPU
+        uint64_t cpuForSample = (currentConsumption > lastConsumption) ? currentConsumption - lastConsumption : 0;
+
+        // we don't collect a sample for this thread is no CPU was consumed since the last check
+        if (cpuForSample > 0)
+        {
+            int64_t thisSampleTimestampNanosecs = OpSysTools::GetHighPrecisionNanoseconds();
+            CollectOneThreadStackSample(pThreadInfo, thisSampleTimestampNanosecs, cpuForSample, PROFILING_TYPE::CpuTime, ThreadState::Running, 0);
+        }
+    }
 }
 
 void StackSamplerLoop::CollectOneThreadStackSample(
     ManagedThreadInfo* pThreadInfo,
     int64_t thisSampleTimestampNanosecs,
     int64_t duration,
-    PROFILING_TYPE profilingType)
+    PROFILING_TYPE profilingType,
+    ThreadState threadState,
+    std::uint64_t burstSpanId)
 {
     HANDLE osThreadHandle = pThreadInfo->GetOsThreadHandle();
     if (osThreadHandle == static_cast<HANDLE>(0))
@@ -293,10 +407,9 @@ void StackSamplerLoop::CollectOneThreadStackSample(
 
         // block used to ensure that NotifyIterationFinished gets called
         {
-            // Get the timestamp of the current collection
-            // /!\ Must not be called while the thread is suspended:
-            // current implementation uses time function which allocates
-            time_t currentUnixTimestamp = GetCurrentTimestamp();
+            // Get the timestamp (in milliseconds) of the current collection
+            // /!\ Must not be called while the thread is suspended
+            std::uint64_t currentUnixTimestamp = GetCurrentTimestamp();
 
             // Get the high-precision timestamp for this sample (this is a time-unit counter, not a real time value).
             pThreadInfo->SetLastKnownSampleUnixTimestamp(currentUnixTimestamp, thisSampleTimestampNanosecs);
@@ -351,7 +464,11 @@ void StackSamplerLoop::CollectOneThreadStackSample(
             if (isStackSnapshotSuccessful)
             {
                 UpdateSnapshotInfos(pStackSnapshotResult, duration, currentUnixTimestamp);
-                pStackSnapshotResult->DetermineAppDomain(pThreadInfo->GetClrThreadId(), _pCorProfilerInfo);
+                // native threads (see NativeThreadList) do not run in any AppDomain
+                if (pThreadInfo->GetClrThreadId() != 0)
+                {
+                    pStackSnapshotResult->DetermineAppDomain(pThreadInfo->GetClrThreadId(), _pCorProfilerInfo);
+                }
             }
 
             // If we got here, then either target thread == sampler thread (we are sampling the current thread),
@@ -383,7 +500,7 @@ void StackSamplerLoop::CollectOneThreadStackSample(
     LogEncounteredStackSnapshotResultStatistics(thisSampleTimestampNanosecs);
 
     // Store stack-walk results into the results buffer:
-    PersistStackSnapshotResults(pStackSnapshotResult, pThreadInfo, profilingType);
+    PersistStackSnapshotResults(pStackSnapshotResult, pThreadInfo, profilingType, threadState, burstSpanId);
 }
 
 void StackSamplerLoop::UpdateStatistics(HRESULT hrCollectStack, std::size_t countCollectedStackFrames)
@@ -405,25 +522,16 @@ void StackSamplerLoop::UpdateStatistics(HRESULT hrCollectStack, std::size_t coun
     ++_totalStacksCollectedCount;
 }
 
-void StackSamplerLoop::UpdateSnapshotInfos(StackSnapshotResultBuffer* const pStackSnapshotResult, int64_t representedDurationNanosecs, time_t currentUnixTimestamp)
+void StackSamplerLoop::UpdateSnapshotInfos(StackSnapshotResultBuffer* const pStackSnapshotResult, int64_t representedDurationNanosecs, std::uint64_t currentUnixTimestamp)
 {
     pStackSnapshotResult->SetRepresentedDurationNanoseconds(representedDurationNanosecs);
-    pStackSnapshotResult->SetUnixTimeUtc(static_cast<int64_t>(currentUnixTimestamp));
+    pStackSnapshotResult->SetUnixTimeUtc(currentUnixTimestamp);
 }
 
-time_t StackSamplerLoop::GetCurrentTimestamp()
+std::uint64_t StackSamplerLoop::GetCurrentTimestamp()
 {
-    // /!\ time function allocates so we *MUST* not call it while the thread is suspended
-
-    time_t currentUnixTimestamp;
-    time(&currentUnixTimestamp);
-
-    if (currentUnixTimestamp == static_cast<time_t>(-1))
-    {
-        currentUnixTimestamp = 0;
-    }
-
-    return currentUnixTimestamp;
+    // Millisecond resolution is needed to order samples when the timeline is enabled
+    return OpSysTools::GetUnixTimeMilliseconds();
 }
 
 int64_t StackSamplerLoop::ComputeWallTime(int64_t currentTimestampNs, int64_t prevTimestampNs)
@@ -552,7 +660,9 @@ void StackSamplerLoop::LogEncounteredStackSnapshotResultStatistics(int64_t thisS
 void StackSamplerLoop::PersistStackSnapshotResults(
     StackSnapshotResultBuffer const* pSnapshotResult,
     ManagedThreadInfo* pThreadInfo,
-    PROFILING_TYPE profilingType)
+    PROFILING_TYPE profilingType,
+    ThreadState threadState,
+    std::uint64_t burstSpanId)
 {
     if (pSnapshotResult == nullptr || pSnapshotResult->GetFramesCount() == 0)
     {
@@ -566,11 +676,16 @@ void StackSamplerLoop::PersistStackSnapshotResults(
         rawSample.Timestamp = pSnapshotResult->GetUnixTimeUtc();
         rawSample.LocalRootSpanId = pSnapshotResult->GetLocalRootSpanId();
         rawSample.SpanId = pSnapshotResult->GetSpanId();
+        rawSample.EndpointId = pSnapshotResult->GetEndpointId();
+        rawSample.ThreadLabels = pSnapshotResult->GetThreadLabels();
         rawSample.AppDomainId = pSnapshotResult->GetAppDomainId();
         pSnapshotResult->CopyInstructionPointers(rawSample.Stack);
         rawSample.ThreadInfo = pThreadInfo;
         pThreadInfo->AddRef();
         rawSample.Duration = pSnapshotResult->GetRepresentedDurationNanoseconds();
+        rawSample.RuntimeSuspensionReason = (_pRuntimeSuspensionState != nullptr) ? _pRuntimeSuspensionState->GetCurrentSuspensionReason() : nullptr;
+        rawSample.State = threadState;
+        rawSample.BurstSpanId = burstSpanId;
         _pWallTimeCollector->Add(std::move(rawSample));
     }
     else
@@ -581,6 +696,8 @@ void StackSamplerLoop::PersistStackSnapshotResults(
         rawCpuSample.Timestamp = pSnapshotResult->GetUnixTimeUtc();
         rawCpuSample.LocalRootSpanId = pSnapshotResult->GetLocalRootSpanId();
         rawCpuSample.SpanId = pSnapshotResult->GetSpanId();
+        rawCpuSample.EndpointId = pSnapshotResult->GetEndpointId();
+        rawCpuSample.ThreadLabels = pSnapshotResult->GetThreadLabels();
         rawCpuSample.AppDomainId = pSnapshotResult->GetAppDomainId();
         pSnapshotResult->CopyInstructionPointers(rawCpuSample.Stack);
         rawCpuSample.ThreadInfo = pThreadInfo;
@@ -16,10 +16,14 @@
 #include "corprof.h"
 // end
 
+#include "HotThreadList.h"
 #include "ManagedThreadInfo.h"
 #include "ICollector.h"
 #include "RawCpuSample.h"
+#include "IRuntimeSuspensionState.h"
+#include "NativeThreadList.h"
 #include "RawWallTimeSample.h"
+#include "ThreadState.h"
 
 #include "shared/src/native-src/string.h"
 
@@ -51,7 +55,9 @@ public:
         IThreadsCpuManager* pThreadsCpuManager,
         IManagedThreadList* pManagedThreadList,
         ICollector<RawWallTimeSample>* pWallTimeCollector,
-        ICollector<RawCpuSample>* pCpuTimeCollector
+        ICollector<RawCpuSample>* pCpuTimeCollector,
+        IRuntimeSuspensionState* pRuntimeSuspensionState,
+        HotThreadList* pHotThreadList
         );
     ~StackSamplerLoop();
     StackSamplerLoop(StackSamplerLoop const&) = delete;
@@ -69,6 +75,10 @@ private:
     IManagedThreadList* _pManagedThreadList;
     ICollector<RawWallTimeSample>* _pWallTimeCollector;
     ICollector<RawCpuSample>* _pCpuTimeCollector;
+    IRuntimeSuspensionState* _pRuntimeSuspensionState;
+    HotThreadList* _pHotThreadList;
+    std::chrono::milliseconds _burstSamplingThreshold;
+    std::chrono::milliseconds _burstSamplingDuration;
 
     std::thread* _pLoopThread;
     DWORD _loopThreadOsId;
@@ -76,6 +86,8 @@ private:
     ManagedThreadInfo* _targetThread;
     uint32_t _iteratorWallTime;
     uint32_t _iteratorCpuTime;
+    std::unique_ptr<NativeThreadList> _pNativeThreadList;
+    std::vector<HotThread> _hotThreads;
 
 private:
     std::unordered_map<HRESULT, uint64_t> _encounteredStackSnapshotHRs;
@@ -89,17 +101,24 @@ private:
     void WaitOnePeriod(void);
     void MainLoopIteration(void);
     void CpuProfilingIteration(void);
+    void NativeThreadsCpuProfilingIteration(void);
+    void CollectCpuSampleIfRunning(ManagedThreadInfo* pThreadInfo);
     void WalltimeProfilingIteration(void);
+    void BurstSamplingIteration(int64_t nowNanosecs);
     void CollectOneThreadStackSample(ManagedThreadInfo* pThreadInfo,
                                      int64_t thisSampleTimestampNanosecs,
                                      int64_t duration,
-                                     PROFILING_TYPE profilingType);
+                                     PROFILING_TYPE profilingType,
+                                     ThreadState threadState,
+                                     std::uint64_t burstSpanId);
     void LogEncounteredStackSnapshotResultStatistics(int64_t thisSampleTimestampNanosecs, bool useStdOutInsteadOfLog = false);
     int64_t ComputeWallTime(int64_t thisSampleTimestampNanosecs, int64_t prevSampleTimestampNanosecs);
-    void UpdateSnapshotInfos(StackSnapshotResultBuffer* const pStackSnapshotResult, int64_t representedDurationNanosecs, time_t currentUnixTimestamp);
+    void UpdateSnapshotInfos(StackSnapshotResultBuffer* const pStackSnapshotResult, int64_t representedDurationNanosecs, std::uint64_t currentUnixTimestamp);
     void UpdateStatistics(HRESULT hrCollectStack, std::size_t countCollectedStackFrames);
-    time_t GetCurrentTimestamp();
+    std::uint64_t GetCurrentTimestamp();
     void PersistStackSnapshotResults(StackSnapshotResultBuffer const* pSnapshotResult,
                                      ManagedThreadInfo* pThreadInfo,
-                                     PROFILING_TYPE profilingType);
+                                     PROFILING_TYPE profilingType,
+                                     ThreadState threadState,
+                                     std::uint64_t burstSpanId);
 };
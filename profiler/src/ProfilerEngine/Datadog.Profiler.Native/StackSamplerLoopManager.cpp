@@ -31,7 +31,8 @@ StackSamplerLoopManager::StackSamplerLoopManager(
     IThreadsCpuManager* pThreadsCpuManager,
     IManagedThreadList* pManagedThreadList,
     ICollector<RawWallTimeSample>* pWallTimeCollector,
-    ICollector<RawCpuSample>* pCpuTimeCollector
+    ICollector<RawCpuSample>* pCpuTimeCollector,
+    IRuntimeSuspensionState* pRuntimeSuspensionState
     ) :
     _pCorProfilerInfo{pCorProfilerInfo},
     _pConfiguration{pConfiguration},
@@ -54,6 +55,7 @@ StackSamplerLoopManager::StackSamplerLoopManager(
     _pManagedThreadList{pManagedThreadList},
     _pWallTimeCollector{pWallTimeCollector},
     _pCpuTimeCollector{pCpuTimeCollector},
+    _pRuntimeSuspensionState{pRuntimeSuspensionState},
     _deadlockInterventionInProgress{0}
 {
     _pCorProfilerInfo->AddRef();
@@ -101,6 +103,8 @@ bool StackSamplerLoopManager::Stop()
     GracefulShutdownStackSampling();
     ShutdownWatcher();
 
+    _hotThreadList.LogStatistics();
+
     return true;
 }
 
@@ -119,7 +123,9 @@ void StackSamplerLoopManager::RunStackSampling()
             _pThreadsCpuManager,
             _pManagedThreadList,
             _pWallTimeCollector,
-            _pCpuTimeCollector
+            _pCpuTimeCollector,
+            _pRuntimeSuspensionState,
+            &_hotThreadList
             );
         _pStackSamplerLoop = stackSamplerLoop;
     }
@@ -428,6 +434,16 @@ double StackSamplerLoopManager::ToMillis(const std::chrono::nanoseconds& nanosec
     return nanosecs.count() / 1000000.0;
 }
 
+bool StackSamplerLoopManager::StartBurstSampling(ManagedThreadInfo* pThreadInfo, std::chrono::milliseconds duration, std::uint64_t spanId)
+{
+    if (_isStopped)
+    {
+        return false;
+    }
+
+    return _hotThreadList.Add(pThreadInfo, duration, spanId, OpSysTools::GetHighPrecisionNanoseconds());
+}
+
 bool StackSamplerLoopManager::AllowStackWalk(ManagedThreadInfo* pThreadInfo)
 {
     std::lock_guard<std::mutex> guardedLock(_watcherActivityLock);
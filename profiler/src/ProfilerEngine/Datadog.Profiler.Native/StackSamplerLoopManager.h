@@ -16,8 +16,10 @@
 #include "IMetricsSender.h"
 #include "Log.h"
 #include "OpSysTools.h"
+#include "HotThreadList.h"
 #include "ICollector.h"
 #include "RawCpuSample.h"
+#include "IRuntimeSuspensionState.h"
 #include "RawWallTimeSample.h"
 #include "StackSamplerLoop.h"
 #include "IStackSamplerLoopManager.h"
@@ -86,7 +88,8 @@ public:
         IThreadsCpuManager* pThreadsCpuManager,
         IManagedThreadList* pManagedThreadList,
         ICollector<RawWallTimeSample>* pWallTimeCollector,
-        ICollector<RawCpuSample>* pCpuTimeCollector
+        ICollector<RawCpuSample>* pCpuTimeCollector,
+        IRuntimeSuspensionState* pRuntimeSuspensionState
         );
 
     ~StackSamplerLoopManager() override;
@@ -100,6 +103,7 @@ public:
     void NotifyCollectionStart() override;
     void NotifyCollectionEnd() override;
     void NotifyIterationFinished() override;
+    bool StartBurstSampling(ManagedThreadInfo* pThreadInfo, std::chrono::milliseconds duration, std::uint64_t spanId) override;
 
 private:
     StackSamplerLoopManager() = delete;
@@ -207,9 +211,11 @@ private:
     IManagedThreadList* _pManagedThreadList = nullptr;
     ICollector<RawWallTimeSample>* _pWallTimeCollector = nullptr;
     ICollector<RawCpuSample>* _pCpuTimeCollector = nullptr;
+    IRuntimeSuspensionState* _pRuntimeSuspensionState = nullptr;
 
     std::unique_ptr<StackFramesCollectorBase> _pStackFramesCollector;
     StackSamplerLoop* _pStackSamplerLoop;
+    HotThreadList _hotThreadList;
     std::uint8_t _deadlockInterventionInProgress;
 
     std::thread* _pWatcherThread;
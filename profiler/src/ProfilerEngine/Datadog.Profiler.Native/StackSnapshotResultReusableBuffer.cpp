@@ -11,7 +11,9 @@ StackSnapshotResultBuffer::StackSnapshotResultBuffer(std::uint16_t initialCapaci
     _nextResetCapacity{initialCapacity},
     _currentFramesCount{0},
     _localRootSpanId{0},
-    _spanId{0}
+    _spanId{0},
+    _endpointId{0},
+    _threadLabels{}
 {
     _instructionPointers.reserve(initialCapacity);
 }
@@ -26,6 +28,7 @@ StackSnapshotResultBuffer::~StackSnapshotResultBuffer()
     _currentFramesCount = 0;
     _localRootSpanId = 0;
     _spanId = 0;
+    _endpointId = 0;
 }
 
 void StackSnapshotResultReusableBuffer::Reset(void)
@@ -35,6 +38,8 @@ void StackSnapshotResultReusableBuffer::Reset(void)
 
     _localRootSpanId = 0;
     _spanId = 0;
+    _endpointId = 0;
+    _threadLabels.fill({0, 0});
 
     _currentFramesCount = 0;
     _appDomainId = static_cast<AppDomainID>(0);
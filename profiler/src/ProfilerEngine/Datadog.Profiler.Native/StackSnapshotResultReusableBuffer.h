@@ -11,6 +11,8 @@
 #include <vector>
 #include <cstdint>
 
+#include "ThreadLabels.h"
+
 /// <summary>
 /// Allocating when a thread is suspended can lead to deadlocks.
 /// This container holds a buffer that is used while walking stacks to temporarily hold results.
@@ -37,6 +39,12 @@ public:
     inline std::uint64_t GetSpanId() const;
     inline std::uint64_t SetSpanId(std::uint64_t value);
 
+    inline std::uint64_t GetEndpointId() const;
+    inline std::uint64_t SetEndpointId(std::uint64_t value);
+
+    inline const ThreadLabelsArray& GetThreadLabels() const;
+    inline ThreadLabelsArray& GetThreadLabels();
+
     inline std::size_t GetFramesCount(void) const;
     inline void CopyInstructionPointers(std::vector<std::uintptr_t>& ips) const;
 
@@ -58,6 +66,8 @@ protected:
 
     std::uint64_t _localRootSpanId;
     std::uint64_t _spanId;
+    std::uint64_t _endpointId;
+    ThreadLabelsArray _threadLabels;
 };
 
 // ----------- ----------- ----------- ----------- ----------- ----------- ----------- ----------- -----------
@@ -141,6 +151,28 @@ inline std::uint64_t StackSnapshotResultBuffer::SetSpanId(std::uint64_t value)
     return prevValue;
 }
 
+inline std::uint64_t StackSnapshotResultBuffer::GetEndpointId() const
+{
+    return _endpointId;
+}
+
+inline std::uint64_t StackSnapshotResultBuffer::SetEndpointId(std::uint64_t value)
+{
+    std::uint64_t prevValue = _endpointId;
+    _endpointId = value;
+    return prevValue;
+}
+
+inline const ThreadLabelsArray& StackSnapshotResultBuffer::GetThreadLabels() const
+{
+    return _threadLabels;
+}
+
+inline ThreadLabelsArray& StackSnapshotResultBuffer::GetThreadLabels()
+{
+    return _threadLabels;
+}
+
 inline std::size_t StackSnapshotResultBuffer::GetFramesCount(void) const
 {
     return _instructionPointers.size();
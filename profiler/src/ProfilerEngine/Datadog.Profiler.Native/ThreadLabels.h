@@ -0,0 +1,194 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// custom labels are low cardinality by design: only a few of them can be attached to a thread at the same time
+static constexpr std::size_t MaxThreadLabels = 8;
+
+struct ThreadLabel
+{
+    // both ids are interned by the IThreadLabelsStore: 0 means that the slot is empty
+    std::uint32_t KeyId;
+    std::uint32_t ValueId;
+};
+
+using ThreadLabelsArray = std::array<ThreadLabel, MaxThreadLabels>;
+
+/// <summary>
+/// Fixed-size key/value slots attached to a managed thread.
+/// The slots are only written by the thread itself (through the SetThreadLabel/ClearThreadLabels P/Invokes)
+/// and read by the sampler without taking any lock: either from a signal handler running on the interrupted
+/// thread (Linux) or while the thread is suspended (Windows).
+/// A sequence number protects the slots (seqlock): it is odd while a write is in progress and the reader
+/// discards the copy if the sequence was odd or changed during the copy. Because the writer might be the
+/// interrupted thread itself, the reader never waits for the write to complete: the labels are simply
+/// missing from this sample.
+/// </summary>
+class ThreadLabels
+{
+public:
+    ThreadLabels();
+
+    ThreadLabels(ThreadLabels const&) = delete;
+    ThreadLabels& operator=(ThreadLabels const&) = delete;
+
+    // add or update the label with the given key; valueId = 0 removes it
+    // return false if all slots are already used by other keys
+    inline bool Set(std::uint32_t keyId, std::uint32_t valueId);
+
+    // replace all the labels at once (count = 0 clears them)
+    inline void Reset(const ThreadLabel* labels, std::size_t count);
+
+    // lock-free and allocation-free: safe to be called from a signal handler
+    inline bool TryCopy(ThreadLabelsArray& labels) const;
+
+private:
+    static inline std::uint64_t Pack(std::uint32_t keyId, std::uint32_t valueId);
+    static inline std::uint32_t GetKeyId(std::uint64_t slot);
+
+    inline void BeginWrite();
+    inline void EndWrite();
+
+private:
+    // a few retries are enough for a reader running on another thread (i.e. tests)
+    static constexpr int MaxReadAttempts = 4;
+
+    std::atomic<std::uint64_t> _sequence;
+
+    // each slot packs the key id (high 32 bits) and the value id (low 32 bits) so a slot is never torn
+    std::array<std::atomic<std::uint64_t>, MaxThreadLabels> _slots;
+};
+
+inline ThreadLabels::ThreadLabels() :
+    _sequence{0}
+{
+    for (auto& slot : _slots)
+    {
+        slot.store(0, std::memory_order_relaxed);
+    }
+}
+
+inline bool ThreadLabels::Set(std::uint32_t keyId, std::uint32_t valueId)
+{
+    if (keyId == 0)
+    {
+        return false;
+    }
+
+    // only the owning thread writes: the slots can be scanned before entering the write section
+    std::size_t keySlot = MaxThreadLabels;
+    std::size_t freeSlot = MaxThreadLabels;
+    for (std::size_t i = 0; i < MaxThreadLabels; i++)
+    {
+        auto currentKeyId = GetKeyId(_slots[i].load(std::memory_order_relaxed));
+        if (currentKeyId == keyId)
+        {
+            keySlot = i;
+            break;
+        }
+
+        if ((currentKeyId == 0) && (freeSlot == MaxThreadLabels))
+        {
+            freeSlot = i;
+        }
+    }
+
+    if (valueId == 0)
+    {
+        if (keySlot != MaxThreadLabels)
+        {
+            BeginWrite();
+            _slots[keySlot].store(0, std::memory_order_relaxed);
+            EndWrite();
+        }
+
+        return true;
+    }
+
+    auto slot = (keySlot != MaxThreadLabels) ? keySlot : freeSlot;
+    if (slot == MaxThreadLabels)
+    {
+        return false;
+    }
+
+    BeginWrite();
+    _slots[slot].store(Pack(keyId, valueId), std::memory_order_relaxed);
+    EndWrite();
+
+    return true;
+}
+
+inline void ThreadLabels::Reset(const ThreadLabel* labels, std::size_t count)
+{
+    BeginWrite();
+    for (std::size_t i = 0; i < MaxThreadLabels; i++)
+    {
+        auto slot = (i < count) ? Pack(labels[i].KeyId, labels[i].ValueId) : 0;
+        _slots[i].store(slot, std::memory_order_relaxed);
+    }
+    EndWrite();
+}
+
+inline bool ThreadLabels::TryCopy(ThreadLabelsArray& labels) const
+{
+    for (int attempt = 0; attempt < MaxReadAttempts; attempt++)
+    {
+        auto before = _sequence.load(std::memory_order_acquire);
+        if ((before & 1) != 0)
+        {
+            // a write is in progress
+            continue;
+        }
+
+        for (std::size_t i = 0; i < MaxThreadLabels; i++)
+        {
+            auto slot = _slots[i].load(std::memory_order_relaxed);
+            labels[i].KeyId = GetKeyId(slot);
+            labels[i].ValueId = static_cast<std::uint32_t>(slot);
+        }
+
+        // the slots must be read before checking that the sequence did not change
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_sequence.load(std::memory_order_relaxed) == before)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+inline std::uint64_t ThreadLabels::Pack(std::uint32_t keyId, std::uint32_t valueId)
+{
+    if ((keyId == 0) || (valueId == 0))
+    {
+        return 0;
+    }
+
+    return (static_cast<std::uint64_t>(keyId) << 32) | valueId;
+}
+
+inline std::uint32_t ThreadLabels::GetKeyId(std::uint64_t slot)
+{
+    return static_cast<std::uint32_t>(slot >> 32);
+}
+
+inline void ThreadLabels::BeginWrite()
+{
+    auto sequence = _sequence.load(std::memory_order_relaxed);
+    _sequence.store(sequence + 1, std::memory_order_relaxed);
+
+    // the odd sequence must be visible before any slot is updated
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+inline void ThreadLabels::EndWrite()
+{
+    auto sequence = _sequence.load(std::memory_order_relaxed);
+    _sequence.store(sequence + 1, std::memory_order_release);
+}
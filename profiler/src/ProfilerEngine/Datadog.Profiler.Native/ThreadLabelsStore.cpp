@@ -0,0 +1,70 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "ThreadLabelsStore.h"
+
+#include "Log.h"
+
+std::uint32_t ThreadLabelsStore::Intern(const std::string& text)
+{
+    std::lock_guard lock(_textsLock);
+
+    auto it = _textIds.find(text);
+    if (it != _textIds.end())
+    {
+        return it->second;
+    }
+
+    if (_texts.size() >= MaxTexts)
+    {
+        if (!_isFullLogged)
+        {
+            _isFullLogged = true;
+            Log::Warn("More than ", MaxTexts, " thread label keys and values were set: new ones are ignored.");
+        }
+
+        return 0;
+    }
+
+    _texts.push_back(text);
+    auto id = static_cast<std::uint32_t>(_texts.size());
+    _textIds.emplace(text, id);
+
+    return id;
+}
+
+bool ThreadLabelsStore::GetText(std::uint32_t id, std::string& text)
+{
+    std::lock_guard lock(_textsLock);
+
+    if ((id == 0) || (id > _texts.size()))
+    {
+        return false;
+    }
+
+    text = _texts[id - 1];
+    return true;
+}
+
+const char* ThreadLabelsStore::GetName()
+{
+    return _serviceName;
+}
+
+bool ThreadLabelsStore::Start()
+{
+    // nothing special to start
+    return true;
+}
+
+bool ThreadLabelsStore::Stop()
+{
+    std::lock_guard lock(_textsLock);
+
+    if (!_texts.empty())
+    {
+        Log::Info(_texts.size(), " thread label keys and values were set.");
+    }
+
+    return true;
+}
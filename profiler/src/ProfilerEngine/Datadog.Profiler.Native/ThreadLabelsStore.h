@@ -0,0 +1,38 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+#include "IThreadLabelsStore.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// Interns the keys and values of the custom labels set by the application on its threads
+/// so that only small ids are stored in the per-thread label slots
+/// </summary>
+class ThreadLabelsStore : public IThreadLabelsStore
+{
+public:
+    ThreadLabelsStore() = default;
+
+    std::uint32_t Intern(const std::string& text) override;
+    bool GetText(std::uint32_t id, std::string& text) override;
+
+    const char* GetName() override;
+    bool Start() override;
+    bool Stop() override;
+
+public:
+    // keys and values are shared by all threads and are expected to be low cardinality
+    static constexpr std::size_t MaxTexts = 1024;
+
+private:
+    const char* _serviceName = "ThreadLabelsStore";
+
+    std::mutex _textsLock;
+    std::vector<std::string> _texts;  // id = index + 1
+    std::unordered_map<std::string, std::uint32_t> _textIds;
+    bool _isFullLogged = false;
+};
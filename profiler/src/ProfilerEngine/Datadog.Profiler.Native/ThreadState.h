@@ -0,0 +1,15 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#pragma once
+
+// Scheduler state of a thread when its wall time sample is taken (see OsSpecificApi::GetThreadState)
+enum class ThreadState
+{
+    Unknown,
+    Running,   // on a core
+    Runnable,  // ready to run but waiting for a core
+    IoWait,    // waiting for an I/O (disk, page fault, socket...)
+    Sleeping,  // waiting for a timer or for anything else
+    LockWait,  // waiting for a lock or another synchronization primitive
+};
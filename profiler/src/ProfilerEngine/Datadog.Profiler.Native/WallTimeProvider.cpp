@@ -5,8 +5,10 @@
 
 #include "IAppDomainStore.h"
 #include "IConfiguration.h"
+#include "IEndpointStore.h"
 #include "IFrameStore.h"
 #include "IRuntimeIdStore.h"
+#include "IThreadLabelsStore.h"
 #include "IThreadsCpuManager.h"
 #include "RawWallTimeSample.h"
 
@@ -15,15 +17,67 @@ WallTimeProvider::WallTimeProvider(
     IThreadsCpuManager* pThreadsCpuManager,
     IFrameStore* pFrameStore,
     IAppDomainStore* pAppDomainStore,
-    IRuntimeIdStore* pRuntimeIdStore
+    IRuntimeIdStore* pRuntimeIdStore,
+    IEndpointStore* pEndpointStore,
+    IThreadLabelsStore* pThreadLabelsStore
     )
     :
-    CollectorBase<RawWallTimeSample>("WallTimeProvider", pThreadsCpuManager, pFrameStore, pAppDomainStore, pRuntimeIdStore)
+    CollectorBase<RawWallTimeSample>("WallTimeProvider", pThreadsCpuManager, pFrameStore, pAppDomainStore, pRuntimeIdStore),
+    _pEndpointStore{pEndpointStore},
+    _pThreadLabelsStore{pThreadLabelsStore}
 {
 }
 
 void WallTimeProvider::OnTransformRawSample(const RawWallTimeSample& rawSample, Sample& sample)
 {
     sample.AddValue(rawSample.Duration, SampleValue::WallTimeDuration);
+
+    // the endpoint of the local root span is interned by the tracer: the name is only resolved here
+    std::string endpoint;
+    if ((_pEndpointStore != nullptr) && _pEndpointStore->GetEndpoint(rawSample.EndpointId, endpoint))
+    {
+        sample.AddLabel(Label(Sample::EndpointLabel, std::move(endpoint)));
+        _pEndpointStore->AddWallTime(rawSample.EndpointId, rawSample.Duration);
+    }
+
+    SetThreadLabels(_pThreadLabelsStore, rawSample, sample);
+
+    // samples collected at a higher rate because the tracer detected a slow span
+    if (rawSample.BurstSpanId != 0)
+    {
+        sample.AddLabel(Label(Sample::BurstSpanIdLabel, std::to_string(rawSample.BurstSpanId)));
+    }
+
+    // allow to separate the threads waiting for the runtime to resume from the application waits
+    if (rawSample.RuntimeSuspensionReason != nullptr)
+    {
+        sample.AddLabel(Label(Sample::RuntimeSuspensionLabel, rawSample.RuntimeSuspensionReason));
+    }
+
+    // allow to break down the off-cpu time by cause
+    auto threadState = GetThreadStateName(rawSample.State);
+    if (threadState != nullptr)
+    {
+        sample.AddLabel(Label(Sample::ThreadStateLabel, threadState));
+    }
+}
+
+const char* WallTimeProvider::GetThreadStateName(ThreadState state)
+{
+    switch (state)
+    {
+        case ThreadState::Running:
+            return "running";
+        case ThreadState::Runnable:
+            return "runnable";
+        case ThreadState::IoWait:
+            return "io-wait";
+        case ThreadState::Sleeping:
+            return "sleeping";
+        case ThreadState::LockWait:
+            return "lock-wait";
+        default:
+            return nullptr;
+    }
 }
 
@@ -15,6 +15,8 @@ class IConfiguration;
 class IFrameStore;
 class IAppDomainStore;
 class IRuntimeIdStore;
+class IEndpointStore;
+class IThreadLabelsStore;
 class IThreadsCpuManager;
 
 
@@ -26,9 +28,17 @@ public:
         IThreadsCpuManager* pThreadsCpuManager,
         IFrameStore* pFrameStore,
         IAppDomainStore* pAssemblyStore,
-        IRuntimeIdStore* pRuntimeIdStore
+        IRuntimeIdStore* pRuntimeIdStore,
+        IEndpointStore* pEndpointStore,
+        IThreadLabelsStore* pThreadLabelsStore
         );
 
 private:
     virtual void OnTransformRawSample(const RawWallTimeSample& rawSample, Sample& sample) override;
+
+    static const char* GetThreadStateName(ThreadState state);
+
+private:
+    IEndpointStore* _pEndpointStore;
+    IThreadLabelsStore* _pThreadLabelsStore;
 };
@@ -0,0 +1,243 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "gtest/gtest.h"
+
+#include "ClrEventsParser.h"
+#include "shared/src/native-src/string.h"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+class TestAllocationsListener : public IAllocationsListener
+{
+public:
+    void OnAllocation(std::uint32_t allocationKind, ClassID classId, const WCHAR* typeName, std::size_t typeNameLength, std::uint64_t allocationAmount, ObjectID objectId) override
+    {
+        CallsCount++;
+        AllocationKind = allocationKind;
+        ClassId = classId;
+        TypeName = shared::ToString(typeName, typeNameLength);
+        AllocationAmount = allocationAmount;
+        ObjectId = objectId;
+    }
+
+    int CallsCount = 0;
+    std::uint32_t AllocationKind = 0;
+    ClassID ClassId = 0;
+    std::string TypeName;
+    std::uint64_t AllocationAmount = 0;
+    ObjectID ObjectId = 0;
+};
+
+class TestContentionListener : public IContentionListener
+{
+public:
+    void OnContention(double contentionDurationNs) override
+    {
+        CallsCount++;
+        ContentionDuration = contentionDurationNs;
+    }
+
+    int CallsCount = 0;
+    double ContentionDuration = 0;
+};
+
+class TestGarbageCollectionsListener : public IGarbageCollectionsListener
+{
+public:
+    void OnGarbageCollectionStart(std::uint32_t number, std::uint32_t generation, std::uint32_t reason, std::uint32_t type) override
+    {
+        CallsCount++;
+        Number = number;
+        Generation = generation;
+        Reason = reason;
+        Type = type;
+    }
+
+    int CallsCount = 0;
+    std::uint32_t Number = 0;
+    std::uint32_t Generation = 0;
+    std::uint32_t Reason = 0;
+    std::uint32_t Type = 0;
+};
+
+template <typename T>
+void Append(std::vector<std::uint8_t>& payload, T value)
+{
+    auto offset = payload.size();
+    payload.resize(offset + sizeof(T));
+    std::memcpy(payload.data() + offset, &value, sizeof(T));
+}
+
+void AppendString(std::vector<std::uint8_t>& payload, const shared::WSTRING& value)
+{
+    for (auto c : value)
+    {
+        Append(payload, c);
+    }
+    Append(payload, static_cast<WCHAR>(0));
+}
+
+std::vector<std::uint8_t> GetAllocationTickPayload(const shared::WSTRING& typeName)
+{
+    // GCAllocationTick_V4
+    std::vector<std::uint8_t> payload;
+    Append(payload, static_cast<std::uint32_t>(102400)); // AllocationAmount
+    Append(payload, static_cast<std::uint32_t>(1));      // AllocationKind
+    Append(payload, static_cast<std::uint16_t>(7));      // ClrInstanceID
+    Append(payload, static_cast<std::uint64_t>(5000000000)); // AllocationAmount64
+    Append(payload, static_cast<std::uintptr_t>(0x1234)); // TypeId
+    AppendString(payload, typeName);                     // TypeName
+    Append(payload, static_cast<std::uint32_t>(3));      // HeapIndex
+    Append(payload, static_cast<std::uintptr_t>(0x5678)); // Address
+    Append(payload, static_cast<std::uint64_t>(88000));  // ObjectSize
+    return payload;
+}
+
+TEST(ClrEventsParserTest, CheckAllocationTickIsParsed)
+{
+    TestAllocationsListener listener;
+    ClrEventsParser parser(&listener, nullptr, nullptr);
+
+    auto payload = GetAllocationTickPayload(WStr("System.Byte[]"));
+    parser.ParseEvent(ClrEventsParser::EVENT_ALLOCATION_TICK, 4, static_cast<std::uint32_t>(payload.size()), payload.data());
+
+    ASSERT_EQ(1, listener.CallsCount);
+    ASSERT_EQ(1, listener.AllocationKind);
+    ASSERT_EQ(0x1234, listener.ClassId);
+    ASSERT_EQ("System.Byte[]", listener.TypeName);
+    ASSERT_EQ(5000000000, listener.AllocationAmount);
+    ASSERT_EQ(0x5678, listener.ObjectId);
+}
+
+TEST(ClrEventsParserTest, CheckAllocationTickAddressIsOnlyReadSinceV3)
+{
+    TestAllocationsListener listener;
+    ClrEventsParser parser(&listener, nullptr, nullptr);
+
+    auto payload = GetAllocationTickPayload(WStr("System.Byte[]"));
+    parser.ParseEvent(ClrEventsParser::EVENT_ALLOCATION_TICK, 2, static_cast<std::uint32_t>(payload.size()), payload.data());
+
+    ASSERT_EQ(1, listener.CallsCount);
+    ASSERT_EQ("System.Byte[]", listener.TypeName);
+    ASSERT_EQ(0, listener.ObjectId);
+}
+
+TEST(ClrEventsParserTest, CheckOtherEventsAreIgnored)
+{
+    TestAllocationsListener listener;
+    ClrEventsParser parser(&listener, nullptr, nullptr);
+
+    auto payload = GetAllocationTickPayload(WStr("System.Byte[]"));
+    parser.ParseEvent(ClrEventsParser::EVENT_ALLOCATION_TICK + 1, 4, static_cast<std::uint32_t>(payload.size()), payload.data());
+
+    // no type name before V2
+    parser.ParseEvent(ClrEventsParser::EVENT_ALLOCATION_TICK, 1, static_cast<std::uint32_t>(payload.size()), payload.data());
+
+    ASSERT_EQ(0, listener.CallsCount);
+}
+
+TEST(ClrEventsParserTest, CheckTruncatedAllocationTickIsIgnored)
+{
+    TestAllocationsListener listener;
+    ClrEventsParser parser(&listener, nullptr, nullptr);
+
+    auto payload = GetAllocationTickPayload(WStr("System.Byte[]"));
+
+    // the type name terminator is missing
+    auto truncatedSize = static_cast<std::uint32_t>(4 + 4 + 2 + 8 + sizeof(std::uintptr_t) + 2 * 4);
+    parser.ParseEvent(ClrEventsParser::EVENT_ALLOCATION_TICK, 4, truncatedSize, payload.data());
+    parser.ParseEvent(ClrEventsParser::EVENT_ALLOCATION_TICK, 4, 0, nullptr);
+
+    ASSERT_EQ(0, listener.CallsCount);
+}
+
+std::vector<std::uint8_t> GetContentionStopPayload(double durationNs)
+{
+    // ContentionStop_V1
+    std::vector<std::uint8_t> payload;
+    Append(payload, static_cast<std::uint8_t>(0));  // ContentionFlags
+    Append(payload, static_cast<std::uint16_t>(7)); // ClrInstanceID
+    Append(payload, durationNs);                    // DurationNs
+    return payload;
+}
+
+TEST(ClrEventsParserTest, CheckContentionDurationIsReadFromContentionStop)
+{
+    TestContentionListener listener;
+    ClrEventsParser parser(nullptr, &listener, nullptr);
+
+    auto payload = GetContentionStopPayload(123456.0);
+    parser.ParseEvent(ClrEventsParser::EVENT_CONTENTION_START, 2, 0, nullptr);
+    parser.ParseEvent(ClrEventsParser::EVENT_CONTENTION_STOP, 1, static_cast<std::uint32_t>(payload.size()), payload.data());
+
+    ASSERT_EQ(1, listener.CallsCount);
+    ASSERT_EQ(123456.0, listener.ContentionDuration);
+}
+
+TEST(ClrEventsParserTest, CheckContentionDurationIsMeasuredBetweenStartAndStop)
+{
+    TestContentionListener listener;
+    ClrEventsParser parser(nullptr, &listener, nullptr);
+
+    // before .NET 8, ContentionStop has no duration
+    auto payload = GetContentionStopPayload(0);
+    parser.ParseEvent(ClrEventsParser::EVENT_CONTENTION_START, 2, 0, nullptr);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    parser.ParseEvent(ClrEventsParser::EVENT_CONTENTION_STOP, 0, 3, payload.data());
+
+    ASSERT_EQ(1, listener.CallsCount);
+    ASSERT_LE(10000000.0, listener.ContentionDuration);
+}
+
+TEST(ClrEventsParserTest, CheckContentionStopWithoutStartIsIgnored)
+{
+    TestContentionListener listener;
+    ClrEventsParser parser(nullptr, &listener, nullptr);
+
+    auto payload = GetContentionStopPayload(0);
+    parser.ParseEvent(ClrEventsParser::EVENT_CONTENTION_STOP, 0, 3, payload.data());
+
+    ASSERT_EQ(0, listener.CallsCount);
+}
+
+std::vector<std::uint8_t> GetGarbageCollectionStartPayload()
+{
+    // GCStart_V2
+    std::vector<std::uint8_t> payload;
+    Append(payload, static_cast<std::uint32_t>(42)); // Count
+    Append(payload, static_cast<std::uint32_t>(1));  // Depth
+    Append(payload, static_cast<std::uint32_t>(4));  // Reason (large object allocation)
+    Append(payload, static_cast<std::uint32_t>(2));  // Type
+    Append(payload, static_cast<std::uint16_t>(7));  // ClrInstanceID
+    Append(payload, static_cast<std::uint64_t>(0));  // ClientSequenceNumber
+    return payload;
+}
+
+TEST(ClrEventsParserTest, CheckGarbageCollectionStartIsParsed)
+{
+    TestGarbageCollectionsListener listener;
+    ClrEventsParser parser(nullptr, nullptr, &listener);
+
+    auto payload = GetGarbageCollectionStartPayload();
+    parser.ParseEvent(ClrEventsParser::EVENT_GC_START, 2, static_cast<std::uint32_t>(payload.size()), payload.data());
+
+    ASSERT_EQ(1, listener.CallsCount);
+    ASSERT_EQ(42, listener.Number);
+    ASSERT_EQ(1, listener.Generation);
+    ASSERT_EQ(4, listener.Reason);
+    ASSERT_EQ(2, listener.Type);
+
+    // no type before V1
+    parser.ParseEvent(ClrEventsParser::EVENT_GC_START, 0, 12, payload.data());
+    ASSERT_EQ(2, listener.CallsCount);
+    ASSERT_EQ(4, listener.Reason);
+    ASSERT_EQ(0, listener.Type);
+
+    // truncated before the reason
+    parser.ParseEvent(ClrEventsParser::EVENT_GC_START, 2, 8, payload.data());
+    ASSERT_EQ(2, listener.CallsCount);
+}
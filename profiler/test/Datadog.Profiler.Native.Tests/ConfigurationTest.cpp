@@ -332,3 +332,173 @@ TEST(ConfigurationTest, CheckUserTagsWhenVariableIsSetWithIncompleteTag)
     auto configuration = Configuration{};
     EXPECT_THAT(configuration.GetUserTags(), ::testing::ContainerEq(tags{{"foo", "bar"}, {"foobar", "barbar"}, {"lab1", ""}}));
 }
+
+TEST(ConfigurationTest, CheckIfTimelineIsEnabledWhenVariableIsNotSet)
+{
+    unsetenv(EnvironmentVariables::TimelineEnabled);
+    auto configuration = Configuration{};
+    ASSERT_FALSE(configuration.IsTimelineEnabled());
+}
+
+TEST(ConfigurationTest, CheckIfTimelineIsEnabledWhenEnvVariableIsSetToTrue)
+{
+    EnvironmentHelper::EnvironmentVariable ar(EnvironmentVariables::TimelineEnabled, WStr("1"));
+    auto configuration = Configuration{};
+    ASSERT_TRUE(configuration.IsTimelineEnabled());
+}
+
+TEST(ConfigurationTest, CheckExceptionMessageMaxLengthWhenVariableIsNotSet)
+{
+    unsetenv(EnvironmentVariables::ExceptionMessageMaxLength);
+    auto configuration = Configuration{};
+    ASSERT_EQ(1024, configuration.ExceptionMessageMaxLength());
+}
+
+TEST(ConfigurationTest, CheckExceptionMessageMaxLengthWhenVariableIsSet)
+{
+    EnvironmentHelper::EnvironmentVariable ar(EnvironmentVariables::ExceptionMessageMaxLength, WStr("128"));
+    auto configuration = Configuration{};
+    ASSERT_EQ(128, configuration.ExceptionMessageMaxLength());
+}
+
+TEST(ConfigurationTest, CheckIfExceptionMessageNormalizationIsEnabledWhenVariableIsNotSet)
+{
+    unsetenv(EnvironmentVariables::ExceptionMessageNormalizationEnabled);
+    auto configuration = Configuration{};
+    ASSERT_FALSE(configuration.IsExceptionMessageNormalizationEnabled());
+}
+
+TEST(ConfigurationTest, CheckIfAllocationProfilingIsEnabledWhenVariableIsNotSet)
+{
+    unsetenv(EnvironmentVariables::AllocationProfilingEnabled);
+    auto configuration = Configuration{};
+    ASSERT_FALSE(configuration.IsAllocationProfilingEnabled());
+}
+
+TEST(ConfigurationTest, CheckIfAllocationProfilingIsEnabledWhenEnvVariableIsSetToTrue)
+{
+    EnvironmentHelper::EnvironmentVariable ar(EnvironmentVariables::AllocationProfilingEnabled, WStr("1"));
+    auto configuration = Configuration{};
+    ASSERT_TRUE(configuration.IsAllocationProfilingEnabled());
+}
+
+TEST(ConfigurationTest, CheckAllocationSampleLimitWhenVariableIsNotSet)
+{
+    unsetenv(EnvironmentVariables::AllocationSampleLimit);
+    auto configuration = Configuration{};
+    ASSERT_EQ(10000, configuration.AllocationSampleLimit());
+}
+
+TEST(ConfigurationTest, CheckAllocationSampleLimitWhenVariableIsSet)
+{
+    EnvironmentHelper::EnvironmentVariable ar(EnvironmentVariables::AllocationSampleLimit, WStr("500"));
+    auto configuration = Configuration{};
+    ASSERT_EQ(500, configuration.AllocationSampleLimit());
+}
+
+TEST(ConfigurationTest, CheckIfContentionProfilingIsEnabledWhenVariableIsNotSet)
+{
+    unsetenv(EnvironmentVariables::ContentionProfilingEnabled);
+    auto configuration = Configuration{};
+    ASSERT_FALSE(configuration.IsContentionProfilingEnabled());
+}
+
+TEST(ConfigurationTest, CheckIfContentionProfilingIsEnabledWhenEnvVariableIsSetToTrue)
+{
+    EnvironmentHelper::EnvironmentVariable ar(EnvironmentVariables::ContentionProfilingEnabled, WStr("1"));
+    auto configuration = Configuration{};
+    ASSERT_TRUE(configuration.IsContentionProfilingEnabled());
+}
+
+TEST(ConfigurationTest, CheckContentionSampleLimitWhenVariableIsNotSet)
+{
+    unsetenv(EnvironmentVariables::ContentionSampleLimit);
+    auto configuration = Configuration{};
+    ASSERT_EQ(10000, configuration.ContentionSampleLimit());
+}
+
+TEST(ConfigurationTest, CheckContentionSampleLimitWhenVariableIsSet)
+{
+    EnvironmentHelper::EnvironmentVariable ar(EnvironmentVariables::ContentionSampleLimit, WStr("500"));
+    auto configuration = Configuration{};
+    ASSERT_EQ(500, configuration.ContentionSampleLimit());
+}
+
+TEST(ConfigurationTest, CheckIfGarbageCollectionProfilingIsEnabledWhenVariableIsNotSet)
+{
+    unsetenv(EnvironmentVariables::GarbageCollectionProfilingEnabled);
+    auto configuration = Configuration{};
+    ASSERT_FALSE(configuration.IsGarbageCollectionProfilingEnabled());
+}
+
+TEST(ConfigurationTest, CheckIfGarbageCollectionProfilingIsEnabledWhenEnvVariableIsSetToTrue)
+{
+    EnvironmentHelper::EnvironmentVariable ar(EnvironmentVariables::GarbageCollectionProfilingEnabled, WStr("1"));
+    auto configuration = Configuration{};
+    ASSERT_TRUE(configuration.IsGarbageCollectionProfilingEnabled());
+}
+
+TEST(ConfigurationTest, CheckIfHeapProfilingIsEnabledWhenVariableIsNotSet)
+{
+    unsetenv(EnvironmentVariables::HeapProfilingEnabled);
+    auto configuration = Configuration{};
+    ASSERT_FALSE(configuration.IsHeapProfilingEnabled());
+}
+
+TEST(ConfigurationTest, CheckIfHeapProfilingIsEnabledWhenEnvVariableIsSetToTrue)
+{
+    EnvironmentHelper::EnvironmentVariable ar(EnvironmentVariables::HeapProfilingEnabled, WStr("1"));
+    auto configuration = Configuration{};
+    ASSERT_TRUE(configuration.IsHeapProfilingEnabled());
+}
+
+TEST(ConfigurationTest, CheckIfNativeThreadsProfilingIsEnabledWhenVariableIsNotSet)
+{
+    unsetenv(EnvironmentVariables::NativeThreadsProfilingEnabled);
+    auto configuration = Configuration{};
+    ASSERT_FALSE(configuration.IsNativeThreadsProfilingEnabled());
+}
+
+TEST(ConfigurationTest, CheckIfNativeThreadsProfilingIsEnabledWhenEnvVariableIsSetToTrue)
+{
+    EnvironmentHelper::EnvironmentVariable ar(EnvironmentVariables::NativeThreadsProfilingEnabled, WStr("1"));
+    auto configuration = Configuration{};
+#ifdef _WINDOWS
+    // only supported on Linux
+    ASSERT_FALSE(configuration.IsNativeThreadsProfilingEnabled());
+#else
+    ASSERT_TRUE(configuration.IsNativeThreadsProfilingEnabled());
+#endif
+}
+
+TEST(ConfigurationTest, CheckIfJitProfilingIsEnabledWhenVariableIsNotSet)
+{
+    unsetenv(EnvironmentVariables::JitProfilingEnabled);
+    auto configuration = Configuration{};
+    ASSERT_FALSE(configuration.IsJitProfilingEnabled());
+}
+
+TEST(ConfigurationTest, CheckIfJitProfilingIsEnabledWhenEnvVariableIsSetToTrue)
+{
+    EnvironmentHelper::EnvironmentVariable ar(EnvironmentVariables::JitProfilingEnabled, WStr("1"));
+    auto configuration = Configuration{};
+    ASSERT_TRUE(configuration.IsJitProfilingEnabled());
+}
+
+TEST(ConfigurationTest, CheckBurstSamplingIsDisabledWhenVariablesAreNotSet)
+{
+    unsetenv(EnvironmentVariables::BurstSamplingThreshold);
+    unsetenv(EnvironmentVariables::BurstSamplingDuration);
+    auto configuration = Configuration{};
+    ASSERT_EQ(0ms, configuration.GetBurstSamplingThreshold());
+    ASSERT_EQ(500ms, configuration.GetBurstSamplingDuration());
+}
+
+TEST(ConfigurationTest, CheckBurstSamplingThresholdAndDurationWhenVariablesAreSet)
+{
+    EnvironmentHelper::EnvironmentVariable threshold(EnvironmentVariables::BurstSamplingThreshold, WStr("2000"));
+    EnvironmentHelper::EnvironmentVariable duration(EnvironmentVariables::BurstSamplingDuration, WStr("1000"));
+    auto configuration = Configuration{};
+    ASSERT_EQ(2000ms, configuration.GetBurstSamplingThreshold());
+    ASSERT_EQ(1000ms, configuration.GetBurstSamplingDuration());
+}
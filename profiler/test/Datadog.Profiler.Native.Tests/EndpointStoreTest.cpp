@@ -0,0 +1,54 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "EndpointStore.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+TEST(EndpointStoreTest, CheckEndpointsAreInterned)
+{
+    EndpointStore endpointStore;
+
+    auto firstId = endpointStore.Register("GET /api/values");
+    auto secondId = endpointStore.Register("POST /api/values");
+
+    ASSERT_NE(0, firstId);
+    ASSERT_NE(0, secondId);
+    ASSERT_NE(firstId, secondId);
+    ASSERT_EQ(firstId, endpointStore.Register("GET /api/values"));
+
+    std::string endpoint;
+    ASSERT_TRUE(endpointStore.GetEndpoint(secondId, endpoint));
+    ASSERT_EQ("POST /api/values", endpoint);
+}
+
+TEST(EndpointStoreTest, CheckUnknownIdsAreNotResolved)
+{
+    EndpointStore endpointStore;
+    endpointStore.Register("GET /api/values");
+
+    std::string endpoint;
+    ASSERT_FALSE(endpointStore.GetEndpoint(0, endpoint));
+    ASSERT_FALSE(endpointStore.GetEndpoint(2, endpoint));
+
+    // costs of unknown endpoints are ignored
+    endpointStore.AddCpuTime(2, 1000);
+    endpointStore.AddWallTime(0, 1000);
+}
+
+TEST(EndpointStoreTest, CheckEndpointsCountIsBounded)
+{
+    EndpointStore endpointStore;
+
+    for (std::size_t i = 0; i < EndpointStore::MaxEndpoints; i++)
+    {
+        ASSERT_NE(0, endpointStore.Register("endpoint #" + std::to_string(i)));
+    }
+
+    ASSERT_EQ(0, endpointStore.Register("one too many"));
+
+    // already known endpoints are still resolved
+    ASSERT_EQ(1, endpointStore.Register("endpoint #0"));
+}
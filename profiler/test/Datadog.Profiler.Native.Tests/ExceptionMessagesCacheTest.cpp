@@ -0,0 +1,73 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "gtest/gtest.h"
+
+#include "ExceptionMessagesCache.h"
+
+#include "shared/src/native-src/string.h"
+
+TEST(ExceptionMessagesCacheTest, CheckIdenticalMessagesAreInterned)
+{
+    ExceptionMessagesCache cache(0, false);
+    shared::WSTRING message = WStr("Object reference not set to an instance of an object.");
+
+    auto first = cache.Intern(message.c_str(), message.size());
+    auto second = cache.Intern(message.c_str(), message.size());
+
+    ASSERT_EQ(first.get(), second.get());
+    ASSERT_EQ("Object reference not set to an instance of an object.", *first);
+
+    auto stats = cache.Reset();
+    ASSERT_EQ(2, stats.MessagesCount);
+    ASSERT_EQ(1, stats.UniqueMessagesCount);
+    ASSERT_EQ(2 * first->size(), stats.CapturedBytes);
+    ASSERT_EQ(first->size(), stats.StoredBytes);
+}
+
+TEST(ExceptionMessagesCacheTest, CheckLongMessageIsTruncated)
+{
+    ExceptionMessagesCache cache(5, false);
+    shared::WSTRING message = WStr("0123456789");
+
+    auto interned = cache.Intern(message.c_str(), message.size());
+
+    ASSERT_EQ("01234" + ExceptionMessagesCache::TruncationSuffix, *interned);
+}
+
+TEST(ExceptionMessagesCacheTest, CheckMessagesWithDifferentIdsAreNormalized)
+{
+    ExceptionMessagesCache cache(0, true);
+    shared::WSTRING message1 = WStr("Order 1234 not found for 0f8fad5b-d9cb-469f-a165-70867728950e");
+    shared::WSTRING message2 = WStr("Order 42 not found for 7c9e6679-7425-40de-944b-e07fc1f90ae7");
+
+    auto interned1 = cache.Intern(message1.c_str(), message1.size());
+    auto interned2 = cache.Intern(message2.c_str(), message2.size());
+
+    ASSERT_EQ(interned1.get(), interned2.get());
+    ASSERT_EQ("Order # not found for <guid>", *interned1);
+}
+
+TEST(ExceptionMessagesCacheTest, CheckNormalize)
+{
+    ASSERT_EQ("", ExceptionMessagesCache::Normalize(""));
+    ASSERT_EQ("no id", ExceptionMessagesCache::Normalize("no id"));
+    ASSERT_EQ("# items (#.#%)", ExceptionMessagesCache::Normalize("10 items (99.5%)"));
+    ASSERT_EQ("id=<guid>.", ExceptionMessagesCache::Normalize("id=0F8FAD5B-D9CB-469F-A165-70867728950E."));
+    // not a complete GUID: only the digits are replaced
+    ASSERT_EQ("#-d#cb-#f", ExceptionMessagesCache::Normalize("0-d9cb-469f"));
+}
+
+TEST(ExceptionMessagesCacheTest, CheckResetForgetsMessages)
+{
+    ExceptionMessagesCache cache(0, false);
+    shared::WSTRING message = WStr("message");
+
+    auto first = cache.Intern(message.c_str(), message.size());
+    cache.Reset();
+    auto second = cache.Intern(message.c_str(), message.size());
+
+    // the first string is still alive while referenced
+    ASSERT_EQ("message", *first);
+    ASSERT_NE(first.get(), second.get());
+}
@@ -0,0 +1,89 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "gtest/gtest.h"
+
+#include "ExceptionSampler.h"
+#include "ExceptionTypesCache.h"
+
+#include <thread>
+#include <vector>
+
+TEST(ExceptionTypesCacheTest, CheckUnknownClassIdIsNotFound)
+{
+    ExceptionTypesCache cache;
+
+    ASSERT_EQ(nullptr, cache.Find(0x1000));
+}
+
+TEST(ExceptionTypesCacheTest, CheckAddedClassIdIsFound)
+{
+    ExceptionTypesCache cache;
+
+    auto const* added = cache.Add(0x1000, "System.InvalidOperationException");
+    auto const* found = cache.Find(0x1000);
+
+    ASSERT_EQ(added, found);
+    ASSERT_EQ(0, found->Id);
+    ASSERT_EQ("System.InvalidOperationException", found->Name);
+}
+
+TEST(ExceptionTypesCacheTest, CheckSameNameIsInterned)
+{
+    ExceptionTypesCache cache;
+
+    auto const* first = cache.Add(0x1000, "System.InvalidOperationException");
+    auto const* other = cache.Add(0x2000, "System.ArgumentException");
+    auto const* sameName = cache.Add(0x3000, "System.InvalidOperationException");
+
+    ASSERT_EQ(first, sameName);
+    ASSERT_NE(first->Id, other->Id);
+    ASSERT_EQ(2, cache.GetTypesCount());
+}
+
+TEST(ExceptionTypesCacheTest, CheckConcurrentAddAndFind)
+{
+    ExceptionTypesCache cache;
+
+    const int threadsCount = 8;
+    const int classIdsCount = 1000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadsCount; t++)
+    {
+        threads.emplace_back([&cache]() {
+            for (int i = 1; i <= classIdsCount; i++)
+            {
+                auto classId = static_cast<ClassID>(i * 0x40);
+                auto const* type = cache.Find(classId);
+                if (type == nullptr)
+                {
+                    type = cache.Add(classId, std::to_string(i % 100));
+                }
+
+                ASSERT_NE(nullptr, type);
+                ASSERT_EQ(std::to_string(i % 100), type->Name);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(100, cache.GetTypesCount());
+}
+
+TEST(ExceptionSamplerTest, CheckFirstExceptionOfEachTypeIsSampled)
+{
+    // the window is never rolled by the timer and there is no budget for non forced samples
+    ExceptionSampler sampler(std::chrono::milliseconds::zero(), 0, 1);
+    double probability = 0;
+
+    ASSERT_TRUE(sampler.Sample(0, probability));
+    ASSERT_DOUBLE_EQ(1.0, probability);
+    ASSERT_TRUE(sampler.Sample(1, probability));
+    ASSERT_FALSE(sampler.Sample(0, probability));
+    ASSERT_FALSE(sampler.Sample(1, probability));
+}
@@ -39,3 +39,9 @@ std::tuple<bool, std::string, std::string> FrameStoreHelper::GetFrame(uintptr_t
 
     return { true, "module???", "frame???" };
 }
+
+std::pair<std::string, std::string> FrameStoreHelper::GetManagedFrame(FunctionID functionId)
+{
+    auto [isManaged, moduleName, frame] = GetFrame(static_cast<uintptr_t>(functionId));
+    return {moduleName, frame};
+}
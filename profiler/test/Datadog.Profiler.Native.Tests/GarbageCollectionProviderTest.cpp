@@ -0,0 +1,152 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "gtest/gtest.h"
+
+#include "GarbageCollectionProvider.h"
+#include "ProfilerMockedInterface.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+static std::string GetLabel(const Sample& sample, const std::string& name)
+{
+    for (auto const& label : sample.GetLabels())
+    {
+        if (label.first == name)
+        {
+            return label.second;
+        }
+    }
+
+    return "<none>";
+}
+
+TEST(GarbageCollectionProviderTest, CheckGarbageCollectionDuringSuspensionIsRecorded)
+{
+    MockRuntimeIdStore runtimeIdStore;
+    std::string expectedRuntimeId = "MyRid";
+    EXPECT_CALL(runtimeIdStore, GetId(::testing::_)).WillRepeatedly(::testing::Return(expectedRuntimeId.c_str()));
+
+    GarbageCollectionProvider provider(nullptr, &runtimeIdStore);
+
+    // gen1 garbage collection (LOH not collected)
+    BOOL generationCollected[] = {TRUE, TRUE, FALSE, FALSE};
+    provider.OnRuntimeSuspendStarted(COR_PRF_SUSPEND_FOR_GC);
+    ASSERT_STREQ("gc", provider.GetCurrentSuspensionReason());
+    provider.OnGarbageCollectionStarted(4, generationCollected, COR_PRF_GC_INDUCED);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    provider.OnGarbageCollectionFinished();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    provider.OnRuntimeResumeFinished();
+    ASSERT_EQ(nullptr, provider.GetCurrentSuspensionReason());
+
+    auto samples = provider.GetSamples();
+    ASSERT_EQ(1, samples.size());
+
+    auto const& sample = samples.front();
+    ASSERT_EQ(expectedRuntimeId, sample.GetRuntimeId());
+    // a single fake frame is needed for the sample to be exported
+    ASSERT_EQ(1, sample.GetCallstack().size());
+    ASSERT_EQ("CLR", sample.GetCallstack().front().first);
+    ASSERT_EQ("|lm:CLR |ns:CLR |ct:CLR |fn:Garbage Collection", sample.GetCallstack().front().second);
+    ASSERT_EQ(1, sample.GetValues()[(size_t)SampleValue::GarbageCollectionCount]);
+    // the pause only covers the collection, not the whole suspension
+    auto pauseDuration = sample.GetValues()[(size_t)SampleValue::GarbageCollectionPauseDuration];
+    ASSERT_LE(10000000, pauseDuration);
+    ASSERT_LE(pauseDuration + 10000000, sample.GetValues()[(size_t)SampleValue::RuntimeSuspensionDuration]);
+    ASSERT_EQ("gc", GetLabel(sample, Sample::RuntimeSuspensionLabel));
+    ASSERT_EQ("1", GetLabel(sample, Sample::GarbageCollectionGenerationLabel));
+    ASSERT_EQ("induced", GetLabel(sample, Sample::GarbageCollectionReasonLabel));
+
+    // samples are returned only once
+    ASSERT_EQ(0, provider.GetSamples().size());
+}
+
+TEST(GarbageCollectionProviderTest, CheckGarbageCollectionReasonIsReadFromGCStartEvent)
+{
+    MockRuntimeIdStore runtimeIdStore;
+    EXPECT_CALL(runtimeIdStore, GetId(::testing::_)).WillRepeatedly(::testing::Return("MyRid"));
+
+    GarbageCollectionProvider provider(nullptr, &runtimeIdStore);
+    BOOL generationCollected[] = {TRUE, FALSE, FALSE};
+
+    // GCStart event sent before GarbageCollectionStarted
+    provider.OnRuntimeSuspendStarted(COR_PRF_SUSPEND_FOR_GC);
+    provider.OnGarbageCollectionStart(1, 0, 4, 0);
+    provider.OnGarbageCollectionStarted(3, generationCollected, COR_PRF_GC_OTHER);
+    provider.OnGarbageCollectionFinished();
+    provider.OnRuntimeResumeFinished();
+
+    // GCStart event sent after GarbageCollectionStarted
+    provider.OnRuntimeSuspendStarted(COR_PRF_SUSPEND_FOR_GC);
+    provider.OnGarbageCollectionStarted(3, generationCollected, COR_PRF_GC_OTHER);
+    provider.OnGarbageCollectionStart(2, 0, 2, 0);
+    provider.OnGarbageCollectionFinished();
+    provider.OnRuntimeResumeFinished();
+
+    // unknown reason
+    provider.OnRuntimeSuspendStarted(COR_PRF_SUSPEND_FOR_GC);
+    provider.OnGarbageCollectionStart(3, 0, 100, 0);
+    provider.OnGarbageCollectionStarted(3, generationCollected, COR_PRF_GC_OTHER);
+    provider.OnRuntimeResumeFinished();
+
+    // the event received outside of a suspension is ignored
+    provider.OnGarbageCollectionStart(4, 2, 1, 1);
+    provider.OnRuntimeSuspendStarted(COR_PRF_SUSPEND_FOR_GC);
+    provider.OnGarbageCollectionStarted(3, generationCollected, COR_PRF_GC_OTHER);
+    provider.OnRuntimeResumeFinished();
+
+    auto samples = provider.GetSamples();
+    ASSERT_EQ(4, samples.size());
+
+    auto sample = samples.begin();
+    ASSERT_EQ("large alloc", GetLabel(*sample, Sample::GarbageCollectionReasonLabel));
+    sample++;
+    ASSERT_EQ("low memory", GetLabel(*sample, Sample::GarbageCollectionReasonLabel));
+    sample++;
+    ASSERT_EQ("other", GetLabel(*sample, Sample::GarbageCollectionReasonLabel));
+    // without GarbageCollectionFinished, the pause is unknown
+    ASSERT_EQ(0, sample->GetValues()[(size_t)SampleValue::GarbageCollectionPauseDuration]);
+    sample++;
+    ASSERT_EQ("other", GetLabel(*sample, Sample::GarbageCollectionReasonLabel));
+}
+
+TEST(GarbageCollectionProviderTest, CheckSuspensionWithoutGarbageCollectionIsRecorded)
+{
+    MockRuntimeIdStore runtimeIdStore;
+    std::string expectedRuntimeId = "MyRid";
+    EXPECT_CALL(runtimeIdStore, GetId(::testing::_)).WillRepeatedly(::testing::Return(expectedRuntimeId.c_str()));
+
+    GarbageCollectionProvider provider(nullptr, &runtimeIdStore);
+
+    provider.OnRuntimeSuspendStarted(COR_PRF_SUSPEND_FOR_INPROC_DEBUGGER);
+    provider.OnRuntimeResumeFinished();
+
+    auto samples = provider.GetSamples();
+    ASSERT_EQ(1, samples.size());
+
+    auto const& sample = samples.front();
+    ASSERT_EQ(0, sample.GetValues()[(size_t)SampleValue::GarbageCollectionCount]);
+    ASSERT_EQ("debugger", GetLabel(sample, Sample::RuntimeSuspensionLabel));
+    ASSERT_EQ("<none>", GetLabel(sample, Sample::GarbageCollectionGenerationLabel));
+}
+
+TEST(GarbageCollectionProviderTest, CheckAbortedSuspensionAndBackgroundCollectionAreIgnored)
+{
+    MockRuntimeIdStore runtimeIdStore;
+
+    GarbageCollectionProvider provider(nullptr, &runtimeIdStore);
+
+    provider.OnRuntimeSuspendStarted(COR_PRF_SUSPEND_FOR_GC);
+    provider.OnRuntimeSuspendAborted();
+    ASSERT_EQ(nullptr, provider.GetCurrentSuspensionReason());
+    provider.OnRuntimeResumeFinished();
+
+    // a background GC starts without suspending the runtime
+    BOOL generationCollected[] = {FALSE, FALSE, TRUE};
+    provider.OnGarbageCollectionStarted(3, generationCollected, COR_PRF_GC_OTHER);
+
+    ASSERT_EQ(0, provider.GetSamples().size());
+}
@@ -0,0 +1,197 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <vector>
+
+#include "HotThreadList.h"
+#include "ManagedThreadInfo.h"
+
+using namespace std::chrono_literals;
+
+static constexpr std::int64_t Ms = 1000000;
+
+static void ReleaseThreads(std::vector<HotThread>& threads)
+{
+    for (auto const& thread : threads)
+    {
+        thread.ThreadInfo->Release();
+    }
+    threads.clear();
+}
+
+TEST(HotThreadListTest, CheckThreadIsSampledUntilDeadline)
+{
+    auto pThreadInfo = new ManagedThreadInfo(1);
+    pThreadInfo->AddRef();
+
+    HotThreadList hotThreads;
+    ASSERT_TRUE(hotThreads.IsEmpty());
+    ASSERT_TRUE(hotThreads.Add(pThreadInfo, 100ms, 42, 1000 * Ms));
+    ASSERT_FALSE(hotThreads.IsEmpty());
+
+    std::vector<HotThread> threads;
+    hotThreads.GetThreadsToSample(1050 * Ms, threads);
+    ASSERT_EQ(1, threads.size());
+    ASSERT_EQ(pThreadInfo, threads[0].ThreadInfo);
+    ASSERT_EQ(42, threads[0].SpanId);
+
+    // the list and the returned thread both hold a reference
+    ASSERT_EQ(3, pThreadInfo->GetRefCount());
+    ReleaseThreads(threads);
+
+    // the thread is removed once the burst is over
+    hotThreads.GetThreadsToSample(1100 * Ms, threads);
+    ASSERT_EQ(0, threads.size());
+    ASSERT_TRUE(hotThreads.IsEmpty());
+    ASSERT_EQ(1, pThreadInfo->GetRefCount());
+
+    pThreadInfo->Release();
+}
+
+TEST(HotThreadListTest, CheckSlowLocalRootSpanIsDetectedBySampler)
+{
+    auto pThreadInfo = new ManagedThreadInfo(1);
+    pThreadInfo->AddRef();
+    auto pTraceContext = pThreadInfo->GetTraceContextPointer();
+
+    HotThreadList hotThreads;
+
+    // no local root span
+    ASSERT_FALSE(hotThreads.AddIfSlow(pThreadInfo, 200ms, 100ms, 1000 * Ms));
+
+    // the local root span is active since the first time it is seen
+    pTraceContext->_currentLocalRootSpanId = 1;
+    pTraceContext->_currentSpanId = 2;
+    ASSERT_FALSE(hotThreads.AddIfSlow(pThreadInfo, 200ms, 100ms, 1100 * Ms));
+    ASSERT_FALSE(hotThreads.AddIfSlow(pThreadInfo, 200ms, 100ms, 1250 * Ms));
+    ASSERT_TRUE(hotThreads.IsEmpty());
+
+    // the span has not changed but the request is now slow
+    ASSERT_TRUE(hotThreads.AddIfSlow(pThreadInfo, 200ms, 100ms, 1300 * Ms));
+
+    std::vector<HotThread> threads;
+    hotThreads.GetThreadsToSample(1350 * Ms, threads);
+    ASSERT_EQ(1, threads.size());
+    ASSERT_EQ(2, threads[0].SpanId);
+    ReleaseThreads(threads);
+
+    // only once per local root span
+    ASSERT_FALSE(hotThreads.AddIfSlow(pThreadInfo, 200ms, 100ms, 1600 * Ms));
+
+    // the next local root span is measured from the first time it is seen
+    pTraceContext->_currentLocalRootSpanId = 3;
+    ASSERT_FALSE(hotThreads.AddIfSlow(pThreadInfo, 200ms, 100ms, 1700 * Ms));
+    ASSERT_TRUE(hotThreads.AddIfSlow(pThreadInfo, 200ms, 100ms, 1900 * Ms));
+
+    // disabled
+    pTraceContext->_currentLocalRootSpanId = 4;
+    ASSERT_FALSE(hotThreads.AddIfSlow(pThreadInfo, 0ms, 100ms, 2000 * Ms));
+    ASSERT_FALSE(hotThreads.AddIfSlow(pThreadInfo, 0ms, 100ms, 5000 * Ms));
+
+    hotThreads.GetThreadsToSample(10000 * Ms, threads);
+    ReleaseThreads(threads);
+    pThreadInfo->Release();
+}
+
+TEST(HotThreadListTest, CheckBurstIsExtended)
+{
+    auto pThreadInfo = new ManagedThreadInfo(1);
+    pThreadInfo->AddRef();
+
+    HotThreadList hotThreads;
+    ASSERT_TRUE(hotThreads.Add(pThreadInfo, 100ms, 42, 1000 * Ms));
+    ASSERT_TRUE(hotThreads.Add(pThreadInfo, 100ms, 43, 1050 * Ms));
+
+    std::vector<HotThread> threads;
+    hotThreads.GetThreadsToSample(1120 * Ms, threads);
+    ASSERT_EQ(1, threads.size());
+    ASSERT_EQ(43, threads[0].SpanId);
+    ReleaseThreads(threads);
+
+    // a shorter burst does not cut the current one
+    ASSERT_TRUE(hotThreads.Add(pThreadInfo, 10ms, 44, 1120 * Ms));
+    hotThreads.GetThreadsToSample(1140 * Ms, threads);
+    ASSERT_EQ(1, threads.size());
+    ReleaseThreads(threads);
+
+    // the duration is capped
+    ASSERT_TRUE(hotThreads.Add(pThreadInfo, 1h, 45, 2000 * Ms));
+    hotThreads.GetThreadsToSample(2000 * Ms + HotThreadList::MaxBurstDuration.count() * Ms, threads);
+    ASSERT_EQ(0, threads.size());
+
+    pThreadInfo->Release();
+}
+
+TEST(HotThreadListTest, CheckHotThreadsCountIsBounded)
+{
+    std::vector<ManagedThreadInfo*> threadInfos;
+    for (std::size_t i = 0; i <= HotThreadList::MaxHotThreads; i++)
+    {
+        auto pThreadInfo = new ManagedThreadInfo(i + 1);
+        pThreadInfo->AddRef();
+        threadInfos.push_back(pThreadInfo);
+    }
+
+    {
+        HotThreadList hotThreads;
+        for (std::size_t i = 0; i < HotThreadList::MaxHotThreads; i++)
+        {
+            ASSERT_TRUE(hotThreads.Add(threadInfos[i], 100ms, i, 0));
+        }
+
+        ASSERT_FALSE(hotThreads.Add(threadInfos[HotThreadList::MaxHotThreads], 100ms, 0, 0));
+
+        // invalid requests
+        ASSERT_FALSE(hotThreads.Add(nullptr, 100ms, 0, 0));
+        ASSERT_FALSE(hotThreads.Add(threadInfos[0], 0ms, 0, 0));
+    }
+
+    // the references are released with the list
+    for (auto pThreadInfo : threadInfos)
+    {
+        ASSERT_EQ(1, pThreadInfo->GetRefCount());
+        pThreadInfo->Release();
+    }
+}
+
+TEST(HotThreadListTest, CheckDeadThreadsAreRemoved)
+{
+    auto pThreadInfo = new ManagedThreadInfo(1);
+    pThreadInfo->AddRef();
+
+    HotThreadList hotThreads;
+    ASSERT_TRUE(hotThreads.Add(pThreadInfo, 100ms, 42, 0));
+
+    pThreadInfo->SetThreadDestroyed();
+
+    std::vector<HotThread> threads;
+    hotThreads.GetThreadsToSample(10 * Ms, threads);
+    ASSERT_EQ(0, threads.size());
+    ASSERT_TRUE(hotThreads.IsEmpty());
+    ASSERT_EQ(1, pThreadInfo->GetRefCount());
+
+    pThreadInfo->Release();
+}
+
+TEST(HotThreadListTest, CheckBudgetIsEnforcedPerPeriod)
+{
+    HotThreadList hotThreads;
+    auto periodNs = HotThreadList::BudgetPeriod.count();
+    auto maxCostNs = HotThreadList::MaxBurstCostPerPeriod.count();
+
+    std::int64_t nowNs = 10 * periodNs;
+    ASSERT_TRUE(hotThreads.HasBudget(nowNs));
+
+    hotThreads.AddBurstSampleCost(maxCostNs / 2);
+    ASSERT_TRUE(hotThreads.HasBudget(nowNs + 1));
+
+    hotThreads.AddBurstSampleCost(maxCostNs / 2);
+    ASSERT_FALSE(hotThreads.HasBudget(nowNs + 2));
+    ASSERT_FALSE(hotThreads.HasBudget(nowNs + periodNs - 1));
+
+    // a new period starts with a new budget
+    ASSERT_TRUE(hotThreads.HasBudget(nowNs + periodNs));
+}
@@ -0,0 +1,127 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "gtest/gtest.h"
+
+#include "FrameStoreHelper.h"
+#include "JitCompilationProvider.h"
+#include "ProfilerMockedInterface.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+static std::string GetLabel(const Sample& sample, const std::string& name)
+{
+    for (auto const& label : sample.GetLabels())
+    {
+        if (label.first == name)
+        {
+            return label.second;
+        }
+    }
+
+    return "<none>";
+}
+
+TEST(JitCompilationProviderTest, CheckCompilationIsRecordedWithMethodFrame)
+{
+    MockRuntimeIdStore runtimeIdStore;
+    std::string expectedRuntimeId = "MyRid";
+    EXPECT_CALL(runtimeIdStore, GetId(::testing::_)).WillRepeatedly(::testing::Return(expectedRuntimeId.c_str()));
+    FrameStoreHelper frameStore(true, "Method", 2);
+
+    JitCompilationProvider provider(nullptr, &frameStore, &runtimeIdStore);
+
+    provider.OnJitCompilationStarted(2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    provider.OnJitCompilationFinished(2, S_OK, TRUE, false);
+
+    auto samples = provider.GetSamples();
+    ASSERT_EQ(1, samples.size());
+
+    auto const& sample = samples.front();
+    ASSERT_EQ(expectedRuntimeId, sample.GetRuntimeId());
+    ASSERT_EQ(1, sample.GetValues()[(size_t)SampleValue::JitCompilationCount]);
+    ASSERT_LE(10000000, sample.GetValues()[(size_t)SampleValue::JitCompilationDuration]);
+    ASSERT_EQ("initial", GetLabel(sample, Sample::JitTierLabel));
+    ASSERT_EQ("true", GetLabel(sample, Sample::JitSafeToBlockLabel));
+
+    // the compiled method is the only frame
+    ASSERT_EQ(1, sample.GetCallstack().size());
+    ASSERT_EQ("module #2", sample.GetCallstack().front().first);
+    ASSERT_EQ("Method #2", sample.GetCallstack().front().second);
+
+    // samples are returned only once
+    ASSERT_EQ(0, provider.GetSamples().size());
+}
+
+TEST(JitCompilationProviderTest, CheckTiersAreDetected)
+{
+    MockRuntimeIdStore runtimeIdStore;
+    EXPECT_CALL(runtimeIdStore, GetId(::testing::_)).WillRepeatedly(::testing::Return("MyRid"));
+    FrameStoreHelper frameStore(true, "Method", 1);
+
+    JitCompilationProvider provider(nullptr, &frameStore, &runtimeIdStore);
+
+    // tiered compilation: the same method is compiled twice
+    provider.OnJitCompilationStarted(1);
+    provider.OnJitCompilationFinished(1, S_OK, FALSE, false);
+    provider.OnJitCompilationStarted(1);
+    provider.OnJitCompilationFinished(1, S_OK, TRUE, false);
+    provider.OnJitCompilationStarted(1);
+    provider.OnJitCompilationFinished(1, S_OK, TRUE, true);
+
+    auto samples = provider.GetSamples();
+    ASSERT_EQ(3, samples.size());
+
+    auto sample = samples.begin();
+    ASSERT_EQ("initial", GetLabel(*sample, Sample::JitTierLabel));
+    ASSERT_EQ("false", GetLabel(*sample, Sample::JitSafeToBlockLabel));
+    sample++;
+    ASSERT_EQ("tier-up", GetLabel(*sample, Sample::JitTierLabel));
+    sample++;
+    ASSERT_EQ("rejit", GetLabel(*sample, Sample::JitTierLabel));
+}
+
+TEST(JitCompilationProviderTest, CheckNestedCompilationsAreTimedSeparately)
+{
+    MockRuntimeIdStore runtimeIdStore;
+    EXPECT_CALL(runtimeIdStore, GetId(::testing::_)).WillRepeatedly(::testing::Return("MyRid"));
+    FrameStoreHelper frameStore(true, "Method", 2);
+
+    JitCompilationProvider provider(nullptr, &frameStore, &runtimeIdStore);
+
+    provider.OnJitCompilationStarted(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    provider.OnJitCompilationStarted(2);
+    provider.OnJitCompilationFinished(2, S_OK, TRUE, false);
+    provider.OnJitCompilationFinished(1, S_OK, TRUE, false);
+
+    auto samples = provider.GetSamples();
+    ASSERT_EQ(2, samples.size());
+
+    auto const& inner = samples.front();
+    auto const& outer = samples.back();
+    ASSERT_EQ("Method #2", inner.GetCallstack().front().second);
+    ASSERT_EQ("Method #1", outer.GetCallstack().front().second);
+    ASSERT_GT(20000000, inner.GetValues()[(size_t)SampleValue::JitCompilationDuration]);
+    ASSERT_LE(20000000, outer.GetValues()[(size_t)SampleValue::JitCompilationDuration]);
+}
+
+TEST(JitCompilationProviderTest, CheckFailedOrUnmatchedCompilationsAreIgnored)
+{
+    MockRuntimeIdStore runtimeIdStore;
+    EXPECT_CALL(runtimeIdStore, GetId(::testing::_)).WillRepeatedly(::testing::Return("MyRid"));
+    FrameStoreHelper frameStore(true, "Method", 1);
+
+    JitCompilationProvider provider(nullptr, &frameStore, &runtimeIdStore);
+
+    provider.OnJitCompilationStarted(1);
+    provider.OnJitCompilationFinished(1, E_FAIL, TRUE, false);
+
+    // no matching JITCompilationStarted
+    provider.OnJitCompilationFinished(1, S_OK, TRUE, false);
+
+    ASSERT_EQ(0, provider.GetSamples().size());
+}
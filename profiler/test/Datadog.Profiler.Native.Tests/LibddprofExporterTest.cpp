@@ -402,4 +402,144 @@ TEST(LibddprofExporterTest, MakeSureNoCrashForReallyLongCallstack)
                                 42);
 
     EXPECT_NO_THROW(exporter.Add(sample1));
-}
\ No newline at end of file
+}
+TEST(LibddprofExporterTest, CheckTimelineProfileIsWrittenToDisk)
+{
+    auto [configuration, mockConfiguration] = CreateConfiguration();
+
+    fs::path pprofTempDir = fs::temp_directory_path() / tmpnam(nullptr);
+    EXPECT_CALL(mockConfiguration, GetProfilesOutputDirectory()).Times(1).WillOnce(ReturnRef(pprofTempDir));
+    EXPECT_CALL(mockConfiguration, IsTimelineEnabled()).Times(1).WillOnce(Return(true));
+
+    std::string agentUrl;
+    EXPECT_CALL(mockConfiguration, GetAgentUrl()).Times(1).WillOnce(ReturnRef(agentUrl));
+
+    std::string agentHost = "localhost";
+    EXPECT_CALL(mockConfiguration, GetAgentHost()).Times(1).WillOnce(ReturnRef(agentHost));
+    int agentPort = 8126;
+    EXPECT_CALL(mockConfiguration, GetAgentPort()).Times(1).WillOnce(Return(agentPort));
+    std::string host = "localhost";
+    EXPECT_CALL(mockConfiguration, GetHostname()).Times(1).WillOnce(ReturnRef(host));
+    EXPECT_CALL(mockConfiguration, IsAgentless()).Times(1).WillOnce(Return(false));
+
+    std::vector<std::pair<std::string, std::string>> tags;
+    EXPECT_CALL(mockConfiguration, GetUserTags()).Times(1).WillOnce(ReturnRef(tags));
+
+    auto applicationStore = MockApplicationStore();
+
+    std::string rid = "MyRid";
+    ApplicationInfo applicationInfo("MyApp", "myenv", "1.0.2");
+    EXPECT_CALL(applicationStore, GetApplicationInfo(rid)).WillRepeatedly(Return(applicationInfo));
+
+    auto exporter = LibddprofExporter(&mockConfiguration, &applicationStore);
+
+    // same callstack and labels: only the timestamp delta differs
+    auto callstack = std::initializer_list<std::pair<std::string, std::string>>({{"module", "frame1"}, {"module", "frame2"}});
+    auto now = OpSysTools::GetUnixTimeMilliseconds();
+
+    Sample sample1{now, rid};
+    Sample sample2{now + 10, rid};
+    for (auto* sample : {&sample1, &sample2})
+    {
+        for (auto const& [module, frame] : callstack)
+        {
+            sample->AddFrame(module, frame);
+        }
+        sample->AddLabel({"label1", "value1"});
+        sample->SetValue(21);
+    }
+
+    exporter.Add(sample1);
+    exporter.Add(sample2);
+
+    exporter.Export();
+
+    std::vector<fs::directory_entry> pprofFiles;
+    for (auto const& file : fs::directory_iterator(pprofTempDir))
+    {
+        pprofFiles.push_back(file);
+    }
+
+    ASSERT_EQ(pprofFiles.size(), 1);
+    ASSERT_TRUE(pprofFiles[0].is_regular_file());
+    ASSERT_THAT(pprofFiles[0].path().filename().string(), ::testing::StartsWith(ComputeExpectedFilePrefix(applicationInfo.ServiceName)));
+
+    fs::remove_all(pprofTempDir);
+}
+
+// Returns the size of the pprof file written for samplesCount samples sharing the same callstack and labels
+std::uintmax_t GetSerializedProfileSize(bool isTimelineEnabled, int samplesCount)
+{
+    auto [configuration, mockConfiguration] = CreateConfiguration();
+
+    fs::path pprofTempDir = fs::temp_directory_path() / tmpnam(nullptr);
+    EXPECT_CALL(mockConfiguration, GetProfilesOutputDirectory()).Times(1).WillOnce(ReturnRef(pprofTempDir));
+    EXPECT_CALL(mockConfiguration, IsTimelineEnabled()).Times(1).WillOnce(Return(isTimelineEnabled));
+
+    std::string agentUrl;
+    EXPECT_CALL(mockConfiguration, GetAgentUrl()).Times(1).WillOnce(ReturnRef(agentUrl));
+
+    std::string agentHost = "localhost";
+    EXPECT_CALL(mockConfiguration, GetAgentHost()).Times(1).WillOnce(ReturnRef(agentHost));
+    int agentPort = 8126;
+    EXPECT_CALL(mockConfiguration, GetAgentPort()).Times(1).WillOnce(Return(agentPort));
+    std::string host = "localhost";
+    EXPECT_CALL(mockConfiguration, GetHostname()).Times(1).WillOnce(ReturnRef(host));
+    EXPECT_CALL(mockConfiguration, IsAgentless()).Times(1).WillOnce(Return(false));
+
+    std::vector<std::pair<std::string, std::string>> tags;
+    EXPECT_CALL(mockConfiguration, GetUserTags()).Times(1).WillOnce(ReturnRef(tags));
+
+    auto applicationStore = MockApplicationStore();
+
+    std::string rid = "MyRid";
+    ApplicationInfo applicationInfo("MyApp", "myenv", "1.0.2");
+    EXPECT_CALL(applicationStore, GetApplicationInfo(rid)).WillRepeatedly(Return(applicationInfo));
+
+    auto exporter = LibddprofExporter(&mockConfiguration, &applicationStore);
+
+    // one sample per millisecond after the start of the profile
+    auto start = OpSysTools::GetUnixTimeMilliseconds() + 1000;
+    for (int i = 0; i < samplesCount; i++)
+    {
+        Sample sample{start + i, rid};
+        sample.AddFrame("module", "frame1");
+        sample.AddFrame("module", "frame2");
+        sample.AddLabel({"label1", "value1"});
+        sample.SetValue(21);
+        exporter.Add(sample);
+    }
+
+    exporter.Export();
+
+    std::uintmax_t size = 0;
+    for (auto const& file : fs::directory_iterator(pprofTempDir))
+    {
+        size += file.file_size();
+    }
+
+    fs::remove_all(pprofTempDir);
+    return size;
+}
+
+TEST(LibddprofExporterTest, MeasureTimelineCostPerSample)
+{
+    auto aggregatedSize = GetSerializedProfileSize(false, 10);
+    auto aggregatedSizeForMoreSamples = GetSerializedProfileSize(false, 1010);
+    auto timelineSize = GetSerializedProfileSize(true, 10);
+    auto timelineSizeForMoreSamples = GetSerializedProfileSize(true, 1010);
+
+    ASSERT_NE(0, aggregatedSize);
+    ASSERT_NE(0, timelineSize);
+
+    // without timeline, samples with the same callstack and labels are merged: the size does not depend on their count
+    ASSERT_GT(aggregatedSize + 64, aggregatedSizeForMoreSamples);
+
+    // with timeline, each sample is serialized with its numeric label
+    auto timelineBytesPerSample = (timelineSizeForMoreSamples - timelineSize) / 1000.0;
+    RecordProperty("TimelineBytesPerSample", std::to_string(timelineBytesPerSample));
+    ASSERT_LT(4.0, timelineBytesPerSample);
+
+    // and the label key and unit strings are only stored once in the string table
+    ASSERT_GT(64.0, timelineBytesPerSample);
+}
@@ -0,0 +1,77 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "gtest/gtest.h"
+
+#include "LockFreeRingBuffer.h"
+
+#include <thread>
+
+TEST(LockFreeRingBufferTest, CheckItemsArePoppedInOrder)
+{
+    LockFreeRingBuffer<int, 4> ring;
+
+    ASSERT_TRUE(ring.TryPush(1));
+    ASSERT_TRUE(ring.TryPush(2));
+    ASSERT_TRUE(ring.TryPush(3));
+
+    int item;
+    ASSERT_TRUE(ring.TryPop(item));
+    ASSERT_EQ(1, item);
+    ASSERT_TRUE(ring.TryPop(item));
+    ASSERT_EQ(2, item);
+    ASSERT_TRUE(ring.TryPop(item));
+    ASSERT_EQ(3, item);
+    ASSERT_FALSE(ring.TryPop(item));
+}
+
+TEST(LockFreeRingBufferTest, CheckItemsAreDroppedWhenFull)
+{
+    LockFreeRingBuffer<int, 4> ring;
+
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(ring.TryPush(i));
+    }
+    ASSERT_FALSE(ring.TryPush(4));
+    ASSERT_FALSE(ring.TryPush(5));
+
+    ASSERT_EQ(2, ring.ResetDroppedCount());
+    ASSERT_EQ(0, ring.ResetDroppedCount());
+
+    // a slot is available again once an item is popped
+    int item;
+    ASSERT_TRUE(ring.TryPop(item));
+    ASSERT_EQ(0, item);
+    ASSERT_TRUE(ring.TryPush(6));
+}
+
+TEST(LockFreeRingBufferTest, CheckConcurrentProducerAndConsumer)
+{
+    constexpr int ItemsCount = 100000;
+    LockFreeRingBuffer<int, 64> ring;
+
+    std::thread producer([&ring]() {
+        for (int i = 0; i < ItemsCount; i++)
+        {
+            while (!ring.TryPush(i))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    int item;
+    while (expected < ItemsCount)
+    {
+        if (ring.TryPop(item))
+        {
+            ASSERT_EQ(expected, item);
+            expected++;
+        }
+    }
+
+    producer.join();
+    ASSERT_FALSE(ring.TryPop(item));
+}
@@ -0,0 +1,146 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+// the threads of the process are only enumerated on Linux
+#ifndef _WINDOWS
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <pthread.h>
+#include <thread>
+
+#include "ManagedThreadList.h"
+#include "NativeThreadList.h"
+#include "OpSysTools.h"
+
+class NamedThread
+{
+public:
+    NamedThread(const char* name)
+    {
+        std::promise<DWORD> started;
+        auto osThreadId = started.get_future();
+
+        _thread = std::thread([this, name, &started]() {
+            pthread_setname_np(pthread_self(), name);
+            started.set_value(OpSysTools::GetThreadId());
+
+            std::unique_lock<std::mutex> lock(_lock);
+            _stopped.wait(lock, [this]() { return _mustStop; });
+        });
+
+        _osThreadId = osThreadId.get();
+    }
+
+    ~NamedThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _mustStop = true;
+        }
+        _stopped.notify_one();
+        _thread.join();
+    }
+
+    DWORD GetOsThreadId() const
+    {
+        return _osThreadId;
+    }
+
+    void Rename(const char* name)
+    {
+        pthread_setname_np(_thread.native_handle(), name);
+    }
+
+private:
+    std::thread _thread;
+    std::mutex _lock;
+    std::condition_variable _stopped;
+    bool _mustStop = false;
+    DWORD _osThreadId = 0;
+};
+
+ManagedThreadInfo* FindThread(NativeThreadList& threads, DWORD osThreadId)
+{
+    ManagedThreadInfo* pFoundThread = nullptr;
+    for (std::uint32_t i = 0; i < threads.Count(); i++)
+    {
+        auto* pThreadInfo = threads.LoopNext();
+        if ((pThreadInfo->GetOsThreadId() == osThreadId) && (pFoundThread == nullptr))
+        {
+            pFoundThread = pThreadInfo;
+            continue;
+        }
+        pThreadInfo->Release();
+    }
+
+    return pFoundThread;
+}
+
+TEST(NativeThreadListTest, CheckNativeThreadIsFoundWithItsName)
+{
+    NamedThread nativeThread("dd-native-test");
+
+    ManagedThreadList managedThreads(nullptr);
+    NativeThreadList threads(&managedThreads);
+    threads.Refresh(0);
+
+    auto* pThreadInfo = FindThread(threads, nativeThread.GetOsThreadId());
+    ASSERT_NE(nullptr, pThreadInfo);
+    ASSERT_EQ(0, pThreadInfo->GetClrThreadId());
+    ASSERT_EQ(WStr("dd-native-test"), pThreadInfo->GetThreadName());
+    ASSERT_NE(static_cast<HANDLE>(0), pThreadInfo->GetOsThreadHandle());
+    pThreadInfo->Release();
+}
+
+TEST(NativeThreadListTest, CheckRenamedThreadKeepsItsCpuConsumption)
+{
+    NamedThread nativeThread("dd-before-test");
+
+    ManagedThreadList managedThreads(nullptr);
+    NativeThreadList threads(&managedThreads);
+    threads.Refresh(0);
+
+    auto* pThreadInfo = FindThread(threads, nativeThread.GetOsThreadId());
+    ASSERT_NE(nullptr, pThreadInfo);
+    pThreadInfo->SetCpuConsumptionMilliseconds(1234);
+
+    // the next enumeration happens after the refresh period
+    nativeThread.Rename("dd-after-test");
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    threads.Refresh(0);
+
+    auto* pRenamedThreadInfo = FindThread(threads, nativeThread.GetOsThreadId());
+    ASSERT_EQ(pThreadInfo, pRenamedThreadInfo);
+    ASSERT_EQ(WStr("dd-after-test"), pRenamedThreadInfo->GetThreadName());
+    ASSERT_EQ(1234, pRenamedThreadInfo->GetCpuConsumptionMilliseconds());
+
+    pRenamedThreadInfo->Release();
+    pThreadInfo->Release();
+}
+
+TEST(NativeThreadListTest, CheckManagedAndExcludedThreadsAreIgnored)
+{
+    NamedThread managedThread("dd-managed-test");
+    NamedThread nativeThread("dd-native-test");
+
+    ManagedThreadList managedThreads(nullptr);
+    managedThreads.GetOrCreateThread(1);
+    managedThreads.SetThreadOsInfo(1, managedThread.GetOsThreadId(), reinterpret_cast<HANDLE>(1));
+
+    NativeThreadList threads(&managedThreads);
+    threads.Refresh(OpSysTools::GetThreadId());
+
+    ASSERT_EQ(nullptr, FindThread(threads, managedThread.GetOsThreadId()));
+    ASSERT_EQ(nullptr, FindThread(threads, OpSysTools::GetThreadId()));
+
+    auto* pThreadInfo = FindThread(threads, nativeThread.GetOsThreadId());
+    ASSERT_NE(nullptr, pThreadInfo);
+    pThreadInfo->Release();
+}
+
+#endif
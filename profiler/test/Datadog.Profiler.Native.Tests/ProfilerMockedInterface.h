@@ -39,6 +39,19 @@ public:
     MOCK_METHOD(bool, IsCpuProfilingEnabled, (), (const override));
     MOCK_METHOD(bool, IsExceptionProfilingEnabled, (), (const override));
     MOCK_METHOD(int, ExceptionSampleLimit, (), (const override));
+    MOCK_METHOD(bool, IsTimelineEnabled, (), (const override));
+    MOCK_METHOD(int, ExceptionMessageMaxLength, (), (const override));
+    MOCK_METHOD(bool, IsExceptionMessageNormalizationEnabled, (), (const override));
+    MOCK_METHOD(bool, IsAllocationProfilingEnabled, (), (const override));
+    MOCK_METHOD(int, AllocationSampleLimit, (), (const override));
+    MOCK_METHOD(bool, IsContentionProfilingEnabled, (), (const override));
+    MOCK_METHOD(int, ContentionSampleLimit, (), (const override));
+    MOCK_METHOD(bool, IsGarbageCollectionProfilingEnabled, (), (const override));
+    MOCK_METHOD(bool, IsHeapProfilingEnabled, (), (const override));
+    MOCK_METHOD(bool, IsNativeThreadsProfilingEnabled, (), (const override));
+    MOCK_METHOD(bool, IsJitProfilingEnabled, (), (const override));
+    MOCK_METHOD(std::chrono::milliseconds, GetBurstSamplingThreshold, (), (const override));
+    MOCK_METHOD(std::chrono::milliseconds, GetBurstSamplingDuration, (), (const override));
 };
 
 class MockExporter : public IExporter
@@ -18,6 +18,8 @@
 #include "RawCpuSample.h"
 #include "RawWallTimeSample.h"
 #include "ThreadsCpuManagerHelper.h"
+#include "EndpointStore.h"
+#include "ThreadLabelsStore.h"
 
 using namespace std::chrono_literals;
 
@@ -90,7 +92,7 @@ TEST(WallTimeProviderTest, CheckNoMissingSample)
     std::string expectedRuntimeId = "MyRid";
     EXPECT_CALL(runtimeIdStore, GetId(::testing::_)).WillRepeatedly(::testing::Return(expectedRuntimeId.c_str()));
 
-    WallTimeProvider provider(threadscpuManager, frameStore, appDomainStore, &runtimeIdStore);
+    WallTimeProvider provider(threadscpuManager, frameStore, appDomainStore, &runtimeIdStore, nullptr, nullptr);
     provider.Start();
 
     // check the number of samples: 3 here
@@ -123,7 +125,7 @@ TEST(WallTimeProviderTest, CheckAppDomainInfoAndRuntimeId)
     std::string secondExpectedRuntimeId = "OtherRid";
     EXPECT_CALL(runtimeIdStore, GetId(static_cast<AppDomainID>(2))).WillRepeatedly(::testing::Return(secondExpectedRuntimeId.c_str()));
 
-    WallTimeProvider provider(threadscpuManager, frameStore, appDomainStore, &runtimeIdStore);
+    WallTimeProvider provider(threadscpuManager, frameStore, appDomainStore, &runtimeIdStore, nullptr, nullptr);
     provider.Start();
 
     std::vector<size_t> expectedAppDomainId { 1, 2, 2, 1};
@@ -202,7 +204,7 @@ TEST(WallTimeProviderTest, CheckFrames)
     std::string expectedRuntimeId = "MyRid";
     EXPECT_CALL(runtimeIdStore, GetId(static_cast<AppDomainID>(1))).WillRepeatedly(::testing::Return(expectedRuntimeId.c_str()));
 
-    WallTimeProvider provider(threadscpuManager, frameStore, appDomainStore, &runtimeIdStore);
+    WallTimeProvider provider(threadscpuManager, frameStore, appDomainStore, &runtimeIdStore, nullptr, nullptr);
     provider.Start();
 
     //                                                                 V-- check the frames are correct
@@ -259,7 +261,7 @@ TEST(WallTimeProviderTest, CheckValuesAndTimestamp)
     std::string expectedRuntimeId = "MyRid";
     EXPECT_CALL(runtimeIdStore, GetId(::testing::_)).WillRepeatedly(::testing::Return(expectedRuntimeId.c_str()));
 
-    WallTimeProvider provider(threadscpuManager, frameStore, appDomainStore, &runtimeIdStore);
+    WallTimeProvider provider(threadscpuManager, frameStore, appDomainStore, &runtimeIdStore, nullptr, nullptr);
     provider.Start();
 
     //                                V-----V-- check these values are correct
@@ -296,6 +298,226 @@ TEST(WallTimeProviderTest, CheckValuesAndTimestamp)
     }
 }
 
+TEST(WallTimeProviderTest, CheckRuntimeSuspensionLabel)
+{
+    auto frameStore = new FrameStoreHelper(true, "Frame", 1);
+    auto appDomainStore = new AppDomainStoreHelper(1);
+    auto threadscpuManager = new ThreadsCpuManagerHelper();
+    MockRuntimeIdStore runtimeIdStore;
+
+    std::string expectedRuntimeId = "MyRid";
+    EXPECT_CALL(runtimeIdStore, GetId(::testing::_)).WillRepeatedly(::testing::Return(expectedRuntimeId.c_str()));
+
+    WallTimeProvider provider(threadscpuManager, frameStore, appDomainStore, &runtimeIdStore, nullptr, nullptr);
+    provider.Start();
+
+    provider.Add(GetWallTimeRawSample(1000, 10, static_cast<AppDomainID>(1), 0, 0, 1));
+    auto rawSample = GetWallTimeRawSample(2000, 20, static_cast<AppDomainID>(1), 0, 0, 1);
+    rawSample.RuntimeSuspensionReason = "gc";
+    provider.Add(std::move(rawSample));
+
+    // wait for the provider to collect raw samples
+    std::this_thread::sleep_for(200ms);
+
+    auto samples = provider.GetSamples();
+    provider.Stop();
+
+    ASSERT_EQ(2, samples.size());
+    for (const Sample& sample : samples)
+    {
+        size_t suspensionLabelsCount = 0;
+        for (auto const& label : sample.GetLabels())
+        {
+            if (label.first == Sample::RuntimeSuspensionLabel)
+            {
+                ASSERT_EQ("gc", label.second);
+                suspensionLabelsCount++;
+            }
+        }
+
+        // only the sample taken during the suspension is tagged
+        ASSERT_EQ((sample.GetTimeStamp() == 2000) ? 1 : 0, suspensionLabelsCount);
+    }
+}
+
+TEST(WallTimeProviderTest, CheckThreadStateLabel)
+{
+    auto frameStore = new FrameStoreHelper(true, "Frame", 1);
+    auto appDomainStore = new AppDomainStoreHelper(1);
+    auto threadscpuManager = new ThreadsCpuManagerHelper();
+    MockRuntimeIdStore runtimeIdStore;
+
+    std::string expectedRuntimeId = "MyRid";
+    EXPECT_CALL(runtimeIdStore, GetId(::testing::_)).WillRepeatedly(::testing::Return(expectedRuntimeId.c_str()));
+
+    WallTimeProvider provider(threadscpuManager, frameStore, appDomainStore, &runtimeIdStore, nullptr, nullptr);
+    provider.Start();
+
+    provider.Add(GetWallTimeRawSample(1000, 10, static_cast<AppDomainID>(1), 0, 0, 1));
+    auto rawSample = GetWallTimeRawSample(2000, 20, static_cast<AppDomainID>(1), 0, 0, 1);
+    rawSample.State = ThreadState::LockWait;
+    provider.Add(std::move(rawSample));
+
+    // wait for the provider to collect raw samples
+    std::this_thread::sleep_for(200ms);
+
+    auto samples = provider.GetSamples();
+    provider.Stop();
+
+    ASSERT_EQ(2, samples.size());
+    for (const Sample& sample : samples)
+    {
+        size_t stateLabelsCount = 0;
+        for (auto const& label : sample.GetLabels())
+        {
+            if (label.first == Sample::ThreadStateLabel)
+            {
+                ASSERT_EQ("lock-wait", label.second);
+                stateLabelsCount++;
+            }
+        }
+
+        // no label when the state is unknown
+        ASSERT_EQ((sample.GetTimeStamp() == 2000) ? 1 : 0, stateLabelsCount);
+    }
+}
+
+TEST(WallTimeProviderTest, CheckEndpointLabel)
+{
+    auto frameStore = new FrameStoreHelper(true, "Frame", 1);
+    auto appDomainStore = new AppDomainStoreHelper(1);
+    auto threadscpuManager = new ThreadsCpuManagerHelper();
+    MockRuntimeIdStore runtimeIdStore;
+    EndpointStore endpointStore;
+
+    std::string expectedRuntimeId = "MyRid";
+    EXPECT_CALL(runtimeIdStore, GetId(::testing::_)).WillRepeatedly(::testing::Return(expectedRuntimeId.c_str()));
+
+    WallTimeProvider provider(threadscpuManager, frameStore, appDomainStore, &runtimeIdStore, &endpointStore, nullptr);
+    provider.Start();
+
+    provider.Add(GetWallTimeRawSample(1000, 10, static_cast<AppDomainID>(1), 0, 0, 1));
+    auto rawSample = GetWallTimeRawSample(2000, 20, static_cast<AppDomainID>(1), 0, 0, 1);
+    rawSample.EndpointId = endpointStore.Register("GET /api/values");
+    provider.Add(std::move(rawSample));
+
+    // wait for the provider to collect raw samples
+    std::this_thread::sleep_for(200ms);
+
+    auto samples = provider.GetSamples();
+    provider.Stop();
+
+    ASSERT_EQ(2, samples.size());
+    for (const Sample& sample : samples)
+    {
+        size_t endpointLabelsCount = 0;
+        for (auto const& label : sample.GetLabels())
+        {
+            if (label.first == "endpoint")
+            {
+                ASSERT_EQ("GET /api/values", label.second);
+                endpointLabelsCount++;
+            }
+        }
+
+        // no label when the tracer did not provide the endpoint
+        ASSERT_EQ((sample.GetTimeStamp() == 2000) ? 1 : 0, endpointLabelsCount);
+    }
+}
+
+TEST(WallTimeProviderTest, CheckThreadLabels)
+{
+    auto frameStore = new FrameStoreHelper(true, "Frame", 1);
+    auto appDomainStore = new AppDomainStoreHelper(1);
+    auto threadscpuManager = new ThreadsCpuManagerHelper();
+    MockRuntimeIdStore runtimeIdStore;
+    ThreadLabelsStore threadLabelsStore;
+
+    std::string expectedRuntimeId = "MyRid";
+    EXPECT_CALL(runtimeIdStore, GetId(::testing::_)).WillRepeatedly(::testing::Return(expectedRuntimeId.c_str()));
+
+    WallTimeProvider provider(threadscpuManager, frameStore, appDomainStore, &runtimeIdStore, nullptr, &threadLabelsStore);
+    provider.Start();
+
+    provider.Add(GetWallTimeRawSample(1000, 10, static_cast<AppDomainID>(1), 0, 0, 1));
+    auto rawSample = GetWallTimeRawSample(2000, 20, static_cast<AppDomainID>(1), 0, 0, 1);
+    rawSample.ThreadLabels[0] = {threadLabelsStore.Intern("tenant tier"), threadLabelsStore.Intern("gold")};
+    rawSample.ThreadLabels[3] = {threadLabelsStore.Intern("queue"), threadLabelsStore.Intern("orders")};
+    provider.Add(std::move(rawSample));
+
+    // wait for the provider to collect raw samples
+    std::this_thread::sleep_for(200ms);
+
+    auto samples = provider.GetSamples();
+    provider.Stop();
+
+    ASSERT_EQ(2, samples.size());
+    for (const Sample& sample : samples)
+    {
+        std::unordered_map<std::string, std::string> customLabels;
+        for (auto const& label : sample.GetLabels())
+        {
+            if ((label.first == "tenant tier") || (label.first == "queue"))
+            {
+                customLabels[label.first] = label.second;
+            }
+        }
+
+        if (sample.GetTimeStamp() == 2000)
+        {
+            ASSERT_EQ(2, customLabels.size());
+            ASSERT_EQ("gold", customLabels["tenant tier"]);
+            ASSERT_EQ("orders", customLabels["queue"]);
+        }
+        else
+        {
+            ASSERT_EQ(0, customLabels.size());
+        }
+    }
+}
+
+TEST(WallTimeProviderTest, CheckBurstSpanIdLabel)
+{
+    auto frameStore = new FrameStoreHelper(true, "Frame", 1);
+    auto appDomainStore = new AppDomainStoreHelper(1);
+    auto threadscpuManager = new ThreadsCpuManagerHelper();
+    MockRuntimeIdStore runtimeIdStore;
+
+    std::string expectedRuntimeId = "MyRid";
+    EXPECT_CALL(runtimeIdStore, GetId(::testing::_)).WillRepeatedly(::testing::Return(expectedRuntimeId.c_str()));
+
+    WallTimeProvider provider(threadscpuManager, frameStore, appDomainStore, &runtimeIdStore, nullptr, nullptr);
+    provider.Start();
+
+    provider.Add(GetWallTimeRawSample(1000, 10, static_cast<AppDomainID>(1), 0, 0, 1));
+    auto rawSample = GetWallTimeRawSample(2000, 20, static_cast<AppDomainID>(1), 0, 0, 1);
+    rawSample.BurstSpanId = 42;
+    provider.Add(std::move(rawSample));
+
+    // wait for the provider to collect raw samples
+    std::this_thread::sleep_for(200ms);
+
+    auto samples = provider.GetSamples();
+    provider.Stop();
+
+    ASSERT_EQ(2, samples.size());
+    for (const Sample& sample : samples)
+    {
+        size_t burstLabelsCount = 0;
+        for (auto const& label : sample.GetLabels())
+        {
+            if (label.first == Sample::BurstSpanIdLabel)
+            {
+                ASSERT_EQ("42", label.second);
+                burstLabelsCount++;
+            }
+        }
+
+        // only the samples collected during a burst are tagged
+        ASSERT_EQ((sample.GetTimeStamp() == 2000) ? 1 : 0, burstLabelsCount);
+    }
+}
+
 TEST(CpuTimeProviderTest, CheckValuesAndTimestamp)
 {
     // add samples and check their frames
@@ -304,7 +526,7 @@ TEST(CpuTimeProviderTest, CheckValuesAndTimestamp)
     auto threadscpuManager = new ThreadsCpuManagerHelper();
     RuntimeIdStoreHelper runtimeIdStore;
 
-    CpuTimeProvider provider(threadscpuManager, frameStore, appDomainStore, &runtimeIdStore);
+    CpuTimeProvider provider(threadscpuManager, frameStore, appDomainStore, &runtimeIdStore, nullptr, nullptr);
     provider.Start();
 
     //                           V-----V-- check these values are correct
@@ -5,6 +5,7 @@
 #include "gtest/gtest.h"
 
 #include "Configuration.h"
+#include "ExceptionsProvider.h"
 #include "IExporter.h"
 #include "ISamplesProvider.h"
 #include "ProfilerMockedInterface.h"
@@ -18,6 +19,7 @@
 
 using ::testing::_;
 using ::testing::ByMove;
+using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::Throw;
 
@@ -182,6 +184,42 @@ TEST(SamplesAggregatorTest, MustExportAfterStop)
     ASSERT_TRUE(metricsSender.WasCounterCalled());
 }
 
+TEST(SamplesAggregatorTest, MustCollectSnapshotSamplesOnlyBeforeExport)
+{
+    auto [configuration, mockConfiguration] = CreateConfiguration();
+    EXPECT_CALL(mockConfiguration, GetUploadInterval()).Times(1).WillOnce(Return(2s));
+
+    std::string runtimeId = "MyRid";
+    FakeSamplesProvider samplesProvider(runtimeId, 1);
+
+    std::string runtimeId2 = "MyRid2";
+    FakeSamplesProvider snapshotProvider(runtimeId2, 2);
+
+    auto [exporter, mockExporter] = CreateExporter();
+    EXPECT_CALL(mockExporter, Add(_)).Times(2 + 1 * 2); // snapshot samples are added once, the others twice
+    EXPECT_CALL(mockExporter, Export()).Times(1).WillRepeatedly(Return(true));
+
+    auto metricsSender = MockMetricsSender();
+    auto threadsCpuManagerHelper = ThreadsCpuManagerHelper();
+
+    auto aggregator = SamplesAggregator(&mockConfiguration, &threadsCpuManagerHelper, &mockExporter, &metricsSender);
+    aggregator.Register(&samplesProvider);
+    aggregator.RegisterSnapshotProvider(&snapshotProvider);
+
+    aggregator.Start();
+
+    // ProcessSamples() runs once but the upload interval is not reached
+    std::this_thread::sleep_for(1500ms);
+    ASSERT_EQ(1, samplesProvider.GetNbCalls());
+    ASSERT_EQ(0, snapshotProvider.GetNbCalls());
+
+    aggregator.Stop();
+    ASSERT_EQ(2, samplesProvider.GetNbCalls());
+    ASSERT_EQ(1, snapshotProvider.GetNbCalls());
+
+    ASSERT_TRUE(metricsSender.WasCounterCalled());
+}
+
 TEST(SamplesAggregatorTest, MustNotFailWhenSendingProfileThrows)
 {
     auto [configuration, mockConfiguration] = CreateConfiguration();
@@ -297,4 +335,37 @@ TEST(SamplesAggregatorTest, MustdNotAddSampleInExporterIfEmptyCallstack)
     aggregator.Start();
     std::this_thread::sleep_for(100ms);
     aggregator.Stop();
-}
\ No newline at end of file
+}
+TEST(SamplesAggregatorTest, MustAddThrownExceptionsCountsInExporter)
+{
+    auto [configuration, mockConfiguration] = CreateConfiguration();
+    EXPECT_CALL(mockConfiguration, GetUploadInterval()).Times(1).WillOnce(Return(10s));
+
+    std::string runtimeId = "MyRid";
+
+    // same samples as the ones returned by ExceptionsProvider for the unsampled counts
+    std::list<Sample> samples;
+    samples.push_back(ExceptionsProvider::CreateThrownExceptionsSample(0, runtimeId, "System.InvalidOperationException", 42));
+
+    auto [samplesProvider, mockSamplesProvider] = CreateSamplesProvider();
+    EXPECT_CALL(mockSamplesProvider, GetSamples()).Times(1).WillOnce(Return(ByMove(std::move(samples))));
+
+    std::int64_t exportedCount = 0;
+    auto [exporter, mockExporter] = CreateExporter();
+    EXPECT_CALL(mockExporter, Add(_)).Times(1).WillOnce(Invoke([&exportedCount](Sample const& sample) {
+        exportedCount = sample.GetValues()[static_cast<size_t>(SampleValue::ExceptionThrownCount)];
+    }));
+    EXPECT_CALL(mockExporter, Export()).Times(1).WillRepeatedly(Return(true));
+
+    auto metricsSender = MockMetricsSender();
+    auto threadsCpuManagerHelper = ThreadsCpuManagerHelper();
+
+    auto aggregator = SamplesAggregator(&mockConfiguration, &threadsCpuManagerHelper, &mockExporter, &metricsSender);
+    aggregator.Register(&mockSamplesProvider);
+
+    aggregator.Start();
+    std::this_thread::sleep_for(100ms);
+    aggregator.Stop();
+
+    ASSERT_EQ(42, exportedCount);
+}
@@ -38,6 +38,38 @@ Sample GetTestSample(std::string_view runtimeId, const std::string& framePrefix,
     sample.AddValue(4, SampleValue::ExceptionCount);
     sample.AddValue(5, SampleValue::ExceptionCount);
     sample.AddValue(6, SampleValue::ExceptionCount);
+    sample.AddValue(70, SampleValue::ExceptionUpscaledCount);
+    sample.AddValue(80, SampleValue::ExceptionUpscaledCount);
+    sample.AddValue(900, SampleValue::ExceptionThrownCount);
+    sample.AddValue(1000, SampleValue::ExceptionThrownCount);
+    // allocation values
+    sample.AddValue(10, SampleValue::AllocationCount);
+    sample.AddValue(11, SampleValue::AllocationCount);
+    sample.AddValue(102400, SampleValue::AllocationSize);
+    sample.AddValue(204800, SampleValue::AllocationSize);
+    // contention values
+    sample.AddValue(12, SampleValue::ContentionCount);
+    sample.AddValue(13, SampleValue::ContentionCount);
+    sample.AddValue(1400, SampleValue::ContentionDuration);
+    sample.AddValue(1500, SampleValue::ContentionDuration);
+    // garbage collection values
+    sample.AddValue(16, SampleValue::GarbageCollectionCount);
+    sample.AddValue(17, SampleValue::GarbageCollectionCount);
+    sample.AddValue(1800, SampleValue::RuntimeSuspensionDuration);
+    sample.AddValue(1900, SampleValue::RuntimeSuspensionDuration);
+    // live heap values
+    sample.AddValue(20, SampleValue::LiveObjectCount);
+    sample.AddValue(21, SampleValue::LiveObjectCount);
+    sample.AddValue(2200, SampleValue::LiveObjectSize);
+    sample.AddValue(2300, SampleValue::LiveObjectSize);
+    // jit values
+    sample.AddValue(24, SampleValue::JitCompilationCount);
+    sample.AddValue(25, SampleValue::JitCompilationCount);
+    sample.AddValue(2600, SampleValue::JitCompilationDuration);
+    sample.AddValue(2700, SampleValue::JitCompilationDuration);
+    // garbage collection pause values
+    sample.AddValue(2800, SampleValue::GarbageCollectionPauseDuration);
+    sample.AddValue(2900, SampleValue::GarbageCollectionPauseDuration);
     // --> only the last one should be kept
 
     Label l;
@@ -55,16 +87,29 @@ Sample GetTestSample(std::string_view runtimeId, const std::string& framePrefix,
 void ValidateTestSample(const Sample& sample, const std::string& framePrefix, const std::string& labelId, const std::string& labelValue)
 {
     // Check values
-    // Today, only 3 values in the array
+    // Today, only 16 values in the array
     //    WallTime
     //    CpuTime
     //    ExceptionCount
+    //    ExceptionUpscaledCount
+    //    ExceptionThrownCount
+    //    AllocationCount
+    //    AllocationSize
+    //    ContentionCount
+    //    ContentionDuration
+    //    GarbageCollectionCount
+    //    RuntimeSuspensionDuration
+    //    LiveObjectCount
+    //    LiveObjectSize
+    //    JitCompilationCount
+    //    JitCompilationDuration
+    //    GarbageCollectionPauseDuration
     // --> should be increased when a new profiler is added
     //     this is a good reminder to add dedicated tests  :^)
     auto values = sample.GetValues();
-    ASSERT_EQ(3, values.size());
+    ASSERT_EQ(16, values.size());
 
-    for (size_t current = 0; current < 3; current++)
+    for (size_t current = 0; current < 16; current++)
     {
         // for the same SampleValue, only the last "added" value is kept
         // update GetTestSample() for new profilers
@@ -80,6 +125,58 @@ void ValidateTestSample(const Sample& sample, const std::string& framePrefix, co
         {
             ASSERT_EQ(6, values[current]);
         }
+        else if (current == (size_t)SampleValue::ExceptionUpscaledCount)
+        {
+            ASSERT_EQ(80, values[current]);
+        }
+        else if (current == (size_t)SampleValue::ExceptionThrownCount)
+        {
+            ASSERT_EQ(1000, values[current]);
+        }
+        else if (current == (size_t)SampleValue::AllocationCount)
+        {
+            ASSERT_EQ(11, values[current]);
+        }
+        else if (current == (size_t)SampleValue::AllocationSize)
+        {
+            ASSERT_EQ(204800, values[current]);
+        }
+        else if (current == (size_t)SampleValue::ContentionCount)
+        {
+            ASSERT_EQ(13, values[current]);
+        }
+        else if (current == (size_t)SampleValue::ContentionDuration)
+        {
+            ASSERT_EQ(1500, values[current]);
+        }
+        else if (current == (size_t)SampleValue::GarbageCollectionCount)
+        {
+            ASSERT_EQ(17, values[current]);
+        }
+        else if (current == (size_t)SampleValue::RuntimeSuspensionDuration)
+        {
+            ASSERT_EQ(1900, values[current]);
+        }
+        else if (current == (size_t)SampleValue::LiveObjectCount)
+        {
+            ASSERT_EQ(21, values[current]);
+        }
+        else if (current == (size_t)SampleValue::LiveObjectSize)
+        {
+            ASSERT_EQ(2300, values[current]);
+        }
+        else if (current == (size_t)SampleValue::JitCompilationCount)
+        {
+            ASSERT_EQ(25, values[current]);
+        }
+        else if (current == (size_t)SampleValue::JitCompilationDuration)
+        {
+            ASSERT_EQ(2700, values[current]);
+        }
+        else if (current == (size_t)SampleValue::GarbageCollectionPauseDuration)
+        {
+            ASSERT_EQ(2900, values[current]);
+        }
         else
         {
             FAIL();
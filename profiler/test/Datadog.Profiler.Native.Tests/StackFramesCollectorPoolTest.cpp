@@ -0,0 +1,86 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "gtest/gtest.h"
+
+#include "StackFramesCollectorPool.h"
+
+#include <atomic>
+#include <vector>
+
+class TestStackFramesCollector : public StackFramesCollectorBase
+{
+public:
+    TestStackFramesCollector(std::atomic<int>& destroyedCount) :
+        _destroyedCount{destroyedCount}
+    {
+    }
+
+    ~TestStackFramesCollector() override
+    {
+        _destroyedCount++;
+    }
+
+private:
+    std::atomic<int>& _destroyedCount;
+};
+
+TEST(StackFramesCollectorPoolTest, CheckCollectorIsCreatedOnceForSuccessiveCollections)
+{
+    std::atomic<int> destroyedCount = 0;
+    StackFramesCollectorPool pool([&destroyedCount]() { return std::make_unique<TestStackFramesCollector>(destroyedCount); });
+
+    StackFramesCollectorBase* pFirstCollector;
+    {
+        auto lease = pool.Acquire();
+        pFirstCollector = lease.Get();
+    }
+
+    // each sampled exception used to create and destroy its own collector
+    for (int i = 0; i < 1000; i++)
+    {
+        auto lease = pool.Acquire();
+        ASSERT_EQ(pFirstCollector, lease.Get());
+    }
+
+    ASSERT_EQ(1, pool.GetCreatedCollectorsCount());
+    ASSERT_EQ(0, destroyedCount);
+}
+
+TEST(StackFramesCollectorPoolTest, CheckConcurrentLeasesGetDifferentCollectors)
+{
+    std::atomic<int> destroyedCount = 0;
+    {
+        StackFramesCollectorPool pool([&destroyedCount]() { return std::make_unique<TestStackFramesCollector>(destroyedCount); });
+
+        // more threads throwing at the same time than pooled collectors
+        {
+            std::vector<StackFramesCollectorPool::Lease> leases;
+            for (int i = 0; i < 20; i++)
+            {
+                leases.push_back(pool.Acquire());
+                for (int j = 0; j < i; j++)
+                {
+                    ASSERT_NE(leases[j].Get(), leases[i].Get());
+                }
+            }
+        }
+
+        // only 16 collectors are kept when they are released
+        ASSERT_EQ(20, pool.GetCreatedCollectorsCount());
+        ASSERT_EQ(4, destroyedCount);
+
+        {
+            std::vector<StackFramesCollectorPool::Lease> leases;
+            for (int i = 0; i < 16; i++)
+            {
+                leases.push_back(pool.Acquire());
+            }
+        }
+
+        ASSERT_EQ(20, pool.GetCreatedCollectorsCount());
+        ASSERT_EQ(4, destroyedCount);
+    }
+
+    ASSERT_EQ(20, destroyedCount);
+}
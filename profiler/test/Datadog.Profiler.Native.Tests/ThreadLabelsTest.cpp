@@ -0,0 +1,249 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+#include "ThreadLabels.h"
+#include "ThreadLabelsStore.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::size_t CountLabels(const ThreadLabelsArray& labels)
+{
+    std::size_t count = 0;
+    for (auto const& label : labels)
+    {
+        if (label.KeyId != 0)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+TEST(ThreadLabelsTest, CheckSetUpdateAndRemove)
+{
+    ThreadLabels threadLabels;
+    ThreadLabelsArray labels;
+
+    ASSERT_TRUE(threadLabels.TryCopy(labels));
+    ASSERT_EQ(0, CountLabels(labels));
+
+    ASSERT_TRUE(threadLabels.Set(1, 10));
+    ASSERT_TRUE(threadLabels.Set(2, 20));
+    ASSERT_TRUE(threadLabels.Set(1, 11));
+
+    ASSERT_TRUE(threadLabels.TryCopy(labels));
+    ASSERT_EQ(2, CountLabels(labels));
+    ASSERT_EQ(1, labels[0].KeyId);
+    ASSERT_EQ(11, labels[0].ValueId);
+    ASSERT_EQ(2, labels[1].KeyId);
+    ASSERT_EQ(20, labels[1].ValueId);
+
+    // removing a label frees its slot for the next key
+    ASSERT_TRUE(threadLabels.Set(1, 0));
+    ASSERT_TRUE(threadLabels.Set(3, 30));
+    ASSERT_TRUE(threadLabels.TryCopy(labels));
+    ASSERT_EQ(2, CountLabels(labels));
+    ASSERT_EQ(3, labels[0].KeyId);
+    ASSERT_EQ(30, labels[0].ValueId);
+
+    // key 0 is reserved for empty slots
+    ASSERT_FALSE(threadLabels.Set(0, 1));
+}
+
+TEST(ThreadLabelsTest, CheckSlotsAreBounded)
+{
+    ThreadLabels threadLabels;
+
+    for (std::uint32_t keyId = 1; keyId <= MaxThreadLabels; keyId++)
+    {
+        ASSERT_TRUE(threadLabels.Set(keyId, keyId * 10));
+    }
+
+    ASSERT_FALSE(threadLabels.Set(MaxThreadLabels + 1, 1));
+
+    // existing keys can still be updated or removed
+    ASSERT_TRUE(threadLabels.Set(1, 42));
+    ASSERT_TRUE(threadLabels.Set(2, 0));
+    ASSERT_TRUE(threadLabels.Set(MaxThreadLabels + 1, 1));
+
+    threadLabels.Reset(nullptr, 0);
+
+    ThreadLabelsArray labels;
+    ASSERT_TRUE(threadLabels.TryCopy(labels));
+    ASSERT_EQ(0, CountLabels(labels));
+}
+
+// One thread keeps on replacing all the slots with values of the same generation while other
+// threads copy them: a successful copy must never mix slots from different generations.
+TEST(ThreadLabelsTest, CheckNoTornReads)
+{
+    static constexpr int ReadsCount = 100000;
+    static constexpr int ReadersCount = 3;
+
+    ThreadLabels threadLabels;
+    std::atomic<int> doneReadersCount = 0;
+    std::atomic<std::uint64_t> tornReadsCount = 0;
+    std::atomic<std::uint64_t> goingBackwardCount = 0;
+    std::uint32_t lastWrittenGeneration = 0;
+
+    // the writer keeps on writing as long as the readers are reading
+    std::thread writer([&threadLabels, &doneReadersCount, &lastWrittenGeneration]() {
+        ThreadLabel labels[MaxThreadLabels];
+        std::uint32_t generation = 0;
+        while (doneReadersCount < ReadersCount)
+        {
+            generation++;
+            for (std::uint32_t i = 0; i < MaxThreadLabels; i++)
+            {
+                labels[i] = {i + 1, generation};
+            }
+
+            threadLabels.Reset(labels, MaxThreadLabels);
+        }
+
+        lastWrittenGeneration = generation;
+    });
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < ReadersCount; i++)
+    {
+        readers.emplace_back([&]() {
+            std::uint32_t lastGeneration = 0;
+            ThreadLabelsArray labels;
+            int read = 0;
+            while (read < ReadsCount)
+            {
+                // a copy fails when the writer is in the middle of an update
+                if (!threadLabels.TryCopy(labels))
+                {
+                    continue;
+                }
+
+                read++;
+
+                auto generation = labels[0].ValueId;
+                for (std::uint32_t slot = 0; slot < MaxThreadLabels; slot++)
+                {
+                    auto expectedKeyId = (generation == 0) ? 0 : slot + 1;
+                    if ((labels[slot].KeyId != expectedKeyId) || (labels[slot].ValueId != generation))
+                    {
+                        tornReadsCount++;
+                        break;
+                    }
+                }
+
+                if (generation < lastGeneration)
+                {
+                    goingBackwardCount++;
+                }
+                lastGeneration = generation;
+            }
+
+            doneReadersCount++;
+        });
+    }
+
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+    writer.join();
+
+    ASSERT_EQ(0, tornReadsCount);
+    ASSERT_EQ(0, goingBackwardCount);
+
+    // once the writer is done, the last generation is always read
+    ThreadLabelsArray labels;
+    ASSERT_TRUE(threadLabels.TryCopy(labels));
+    ASSERT_EQ(lastWrittenGeneration, labels[MaxThreadLabels - 1].ValueId);
+}
+
+// Same with a writer updating and removing single labels: a slot is never read half written.
+TEST(ThreadLabelsTest, CheckNoTornSlots)
+{
+    static constexpr int ReadsCount = 100000;
+
+    ThreadLabels threadLabels;
+    std::atomic<bool> isReaderDone = false;
+    std::atomic<std::uint64_t> tornSlotsCount = 0;
+
+    std::thread writer([&threadLabels, &isReaderDone]() {
+        std::uint32_t i = 0;
+        while (!isReaderDone)
+        {
+            // the value of a label is always 1000 times its key
+            i++;
+            auto keyId = (i % MaxThreadLabels) + 1;
+            threadLabels.Set(keyId, ((i % 3) == 0) ? 0 : keyId * 1000);
+        }
+    });
+
+    std::thread reader([&threadLabels, &isReaderDone, &tornSlotsCount]() {
+        ThreadLabelsArray labels;
+        int read = 0;
+        while (read < ReadsCount)
+        {
+            if (!threadLabels.TryCopy(labels))
+            {
+                continue;
+            }
+
+            read++;
+
+            for (auto const& label : labels)
+            {
+                if (label.ValueId != label.KeyId * 1000)
+                {
+                    tornSlotsCount++;
+                }
+            }
+        }
+
+        isReaderDone = true;
+    });
+
+    reader.join();
+    writer.join();
+
+    ASSERT_EQ(0, tornSlotsCount);
+}
+
+TEST(ThreadLabelsStoreTest, CheckTextsAreInterned)
+{
+    ThreadLabelsStore threadLabelsStore;
+
+    auto keyId = threadLabelsStore.Intern("tenant tier");
+    auto valueId = threadLabelsStore.Intern("gold");
+
+    ASSERT_NE(0, keyId);
+    ASSERT_NE(0, valueId);
+    ASSERT_NE(keyId, valueId);
+    ASSERT_EQ(keyId, threadLabelsStore.Intern("tenant tier"));
+
+    std::string text;
+    ASSERT_TRUE(threadLabelsStore.GetText(valueId, text));
+    ASSERT_EQ("gold", text);
+    ASSERT_FALSE(threadLabelsStore.GetText(0, text));
+    ASSERT_FALSE(threadLabelsStore.GetText(valueId + 1, text));
+}
+
+TEST(ThreadLabelsStoreTest, CheckTextsCountIsBounded)
+{
+    ThreadLabelsStore threadLabelsStore;
+
+    for (std::size_t i = 0; i < ThreadLabelsStore::MaxTexts; i++)
+    {
+        ASSERT_NE(0, threadLabelsStore.Intern("text #" + std::to_string(i)));
+    }
+
+    ASSERT_EQ(0, threadLabelsStore.Intern("one too many"));
+
+    // already interned texts are still available
+    ASSERT_NE(0, threadLabelsStore.Intern("text #0"));
+}
@@ -0,0 +1,86 @@
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2022 Datadog, Inc.
+
+// the Windows implementation needs a thread handle provided by the CLR
+#ifndef _WINDOWS
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include "ManagedThreadInfo.h"
+#include "OpSysTools.h"
+#include "OsSpecificApi.h"
+
+using namespace std::chrono_literals;
+
+ThreadState GetThreadState(DWORD osThreadId)
+{
+    ManagedThreadInfo threadInfo(0);
+    threadInfo.SetOsInfo(osThreadId, reinterpret_cast<HANDLE>(static_cast<std::uintptr_t>(osThreadId)));
+    return OsSpecificApi::GetThreadState(&threadInfo);
+}
+
+TEST(ThreadStateTest, CheckCurrentThreadIsRunning)
+{
+    ASSERT_EQ(ThreadState::Running, GetThreadState(OpSysTools::GetThreadId()));
+}
+
+TEST(ThreadStateTest, CheckUnknownThread)
+{
+    ASSERT_EQ(ThreadState::Unknown, GetThreadState(0));
+}
+
+TEST(ThreadStateTest, CheckSleepingThread)
+{
+    std::atomic<bool> mustStop = false;
+
+    std::promise<DWORD> started;
+    auto osThreadId = started.get_future();
+
+    std::thread sleepingThread([&started, &mustStop]() {
+        started.set_value(OpSysTools::GetThreadId());
+        while (!mustStop)
+        {
+            std::this_thread::sleep_for(20ms);
+        }
+    });
+
+    auto tid = osThreadId.get();
+    std::this_thread::sleep_for(50ms);
+    auto state = GetThreadState(tid);
+
+    mustStop = true;
+    sleepingThread.join();
+
+    ASSERT_EQ(ThreadState::Sleeping, state);
+}
+
+TEST(ThreadStateTest, CheckLockWaitThread)
+{
+    std::mutex lock;
+    lock.lock();
+
+    std::promise<DWORD> started;
+    auto osThreadId = started.get_future();
+
+    std::thread waitingThread([&started, &lock]() {
+        started.set_value(OpSysTools::GetThreadId());
+        std::lock_guard<std::mutex> guard(lock);
+    });
+
+    auto tid = osThreadId.get();
+    std::this_thread::sleep_for(100ms);
+    auto state = GetThreadState(tid);
+
+    lock.unlock();
+    waitingThread.join();
+
+    ASSERT_EQ(ThreadState::LockWait, state);
+}
+
+#endif
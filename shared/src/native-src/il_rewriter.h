@@ -7,6 +7,7 @@
 
 #include <corhlpr.h>
 #include <corprof.h>
+#include <vector>
 
 typedef enum {
 #define OPDEF(c, s, pop, push, args, type, l, s1, s2, ctrl) c,
@@ -46,6 +47,38 @@ struct EHClause {
 	};
 };
 
+// Bump allocator for the ILInstr and EHClause of a rewriter: the nodes are never freed one by one,
+// all the blocks are released when the rewriter is destroyed.
+class ILRewriterArena {
+private:
+	static const size_t Alignment = 8;
+	static const size_t FirstBlockSize = 4 * 1024;
+	static const size_t MaxBlockSize = 64 * 1024;
+
+	struct Block {
+		BYTE* m_pData;
+		size_t m_size;
+	};
+
+	std::vector<Block> m_blocks;
+	BYTE* m_pCurrent;
+	size_t m_remaining;
+	size_t m_nextBlockSize;
+
+public:
+	ILRewriterArena();
+	~ILRewriterArena();
+
+	ILRewriterArena(const ILRewriterArena&) = delete;
+	ILRewriterArena& operator=(const ILRewriterArena&) = delete;
+
+	void* Allocate(size_t size);
+
+	bool Owns(const void* p) const;
+
+	size_t GetBlockCount() const;
+};
+
 class ILRewriter {
 private:
 	ICorProfilerInfo* m_pICorProfilerInfo;
@@ -77,6 +110,8 @@ private:
 
 	IMethodMalloc* m_pIMethodMalloc;
 
+	ILRewriterArena m_arena;
+
 public:
 	ILRewriter(ICorProfilerInfo* pICorProfilerInfo,
 		ICorProfilerFunctionControl* pICorProfilerFunctionControl,
@@ -96,6 +131,9 @@ public:
 
 	void SetEHClause(EHClause* ehPointer, unsigned ehLength);
 
+	// Zero initialized array of EH clauses, released with the rewriter (to be used with SetEHClause)
+	EHClause* NewEHClauses(unsigned count);
+
 	/////////////////////////////////////////////////////////////////////////////////////////////////
 	//
 	// I M P O R T
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
@@ -184,6 +185,18 @@ namespace shared
             queue_.pop();
             return value;
         }
+        // Same as pop, but returns nullptr if the queue is still empty at the deadline
+        std::unique_ptr<T> pop_until(const std::chrono::steady_clock::time_point& deadline)
+        {
+            std::unique_lock<std::mutex> mlock(mutex_);
+            if (!condition_.wait_until(mlock, deadline, [this]() { return !queue_.empty(); }))
+            {
+                return nullptr;
+            }
+            std::unique_ptr<T> value = std::move(queue_.front());
+            queue_.pop();
+            return value;
+        }
         void push(std::unique_ptr<T>&& item)
         {
             {
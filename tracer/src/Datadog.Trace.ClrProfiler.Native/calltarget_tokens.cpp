@@ -4,6 +4,7 @@
 #include "il_rewriter_wrapper.h"
 #include "logger.h"
 #include "module_metadata.h"
+#include "stats.h"
 
 namespace trace
 {
@@ -234,8 +235,6 @@ mdMemberRef CallTargetTokens::GetCallTargetReturnValueDefaultMemberRef(mdTypeSpe
     mdMemberRef callTargetReturnTypeGetDefault = mdMemberRefNil;
 
     // *** Ensure CallTargetReturn<T>.GetDefault() member ref
-    ModuleMetadata* module_metadata = GetMetadata();
-
     unsigned callTargetReturnTypeRefBuffer;
     auto callTargetReturnTypeRefSize = CorSigCompressToken(callTargetReturnTypeRef, &callTargetReturnTypeRefBuffer);
 
@@ -253,9 +252,8 @@ mdMemberRef CallTargetTokens::GetCallTargetReturnValueDefaultMemberRef(mdTypeSpe
     signature[offset++] = ELEMENT_TYPE_VAR;
     signature[offset++] = 0x00;
 
-    hr = module_metadata->metadata_emit->DefineMemberRef(callTargetReturnTypeSpec,
-                                                         managed_profiler_calltarget_returntype_getdefault_name.data(),
-                                                         signature, signatureLength, &callTargetReturnTypeGetDefault);
+    hr = DefineMemberRef(callTargetReturnTypeSpec, managed_profiler_calltarget_returntype_getdefault_name.data(),
+                         signature, signatureLength, &callTargetReturnTypeGetDefault);
     if (FAILED(hr))
     {
         Logger::Warn("Wrapper callTargetReturnTypeGetDefault could not be defined.");
@@ -316,8 +314,7 @@ mdMethodSpec CallTargetTokens::GetCallTargetDefaultValueMethodSpec(TypeSignature
     memcpy(&signature[offset], methodArgumentSignature, methodArgumentSignatureSize);
     offset += methodArgumentSignatureSize;
 
-    hr = module_metadata->metadata_emit->DefineMethodSpec(getDefaultMemberRef, signature, signatureLength,
-                                                          &getDefaultMethodSpec);
+    hr = DefineMethodSpec(getDefaultMemberRef, signature, signatureLength, &getDefaultMethodSpec);
     if (FAILED(hr))
     {
         Logger::Warn("Error creating getDefaultMethodSpec.");
@@ -666,7 +663,7 @@ mdTypeSpec CallTargetTokens::GetTargetReturnValueTypeRef(TypeSignature* returnAr
     memcpy(&signature[offset], returnSignatureBuffer, returnSignatureLength);
     offset += returnSignatureLength;
 
-    hr = module_metadata->metadata_emit->GetTokenFromTypeSpec(signature, signatureLength, &returnValueTypeSpec);
+    hr = GetTokenFromTypeSpec(signature, signatureLength, &returnValueTypeSpec);
     if (FAILED(hr))
     {
         Logger::Warn("Error creating return value type spec");
@@ -676,6 +673,36 @@ mdTypeSpec CallTargetTokens::GetTargetReturnValueTypeRef(TypeSignature* returnAr
     return returnValueTypeSpec;
 }
 
+HRESULT CallTargetTokens::GetTokenFromTypeSpec(PCCOR_SIGNATURE signature, ULONG signatureLength,
+                                               mdTypeSpec* typeSpec)
+{
+    return signatureTokens.GetOrDefine(SignatureTokenKind::TypeSpec, mdTokenNil, nullptr, signature, signatureLength,
+                                       typeSpec, [&](mdToken* token) {
+                                           return GetMetadata()->metadata_emit->GetTokenFromTypeSpec(
+                                               signature, signatureLength, token);
+                                       });
+}
+
+HRESULT CallTargetTokens::DefineMemberRef(mdToken parent, const WCHAR* name, PCCOR_SIGNATURE signature,
+                                          ULONG signatureLength, mdMemberRef* memberRef)
+{
+    return signatureTokens.GetOrDefine(SignatureTokenKind::MemberRef, parent, name, signature, signatureLength,
+                                       memberRef, [&](mdToken* token) {
+                                           return GetMetadata()->metadata_emit->DefineMemberRef(
+                                               parent, name, signature, signatureLength, token);
+                                       });
+}
+
+HRESULT CallTargetTokens::DefineMethodSpec(mdToken parent, PCCOR_SIGNATURE signature, ULONG signatureLength,
+                                           mdMethodSpec* methodSpec)
+{
+    return signatureTokens.GetOrDefine(SignatureTokenKind::MethodSpec, parent, nullptr, signature, signatureLength,
+                                       methodSpec, [&](mdToken* token) {
+                                           return GetMetadata()->metadata_emit->DefineMethodSpec(
+                                               parent, signature, signatureLength, token);
+                                       });
+}
+
 mdToken CallTargetTokens::GetCurrentTypeRef(const TypeInfo* currentType, bool& isValueType)
 {
     isValueType = currentType->valueType;
@@ -825,7 +852,6 @@ HRESULT CallTargetTokens::WriteCallTargetReturnGetReturnValue(void* rewriterWrap
         return mdMemberRefNil;
     }
     ILRewriterWrapper* rewriterWrapper = (ILRewriterWrapper*) rewriterWrapperPtr;
-    ModuleMetadata* module_metadata = GetMetadata();
 
     // Ensure T CallTargetReturn<T>.GetReturnValue() member ref
     mdMemberRef callTargetReturnGetValueMemberRef = mdMemberRefNil;
@@ -838,9 +864,8 @@ HRESULT CallTargetTokens::WriteCallTargetReturnGetReturnValue(void* rewriterWrap
     signature[offset++] = 0x00;
     signature[offset++] = ELEMENT_TYPE_VAR;
     signature[offset++] = 0x00;
-    hr = module_metadata->metadata_emit->DefineMemberRef(
-        callTargetReturnTypeSpec, managed_profiler_calltarget_returntype_getreturnvalue_name.data(), signature,
-        signatureLength, &callTargetReturnGetValueMemberRef);
+    hr = DefineMemberRef(callTargetReturnTypeSpec, managed_profiler_calltarget_returntype_getreturnvalue_name.data(),
+                         signature, signatureLength, &callTargetReturnGetValueMemberRef);
     if (FAILED(hr))
     {
         Logger::Warn("Wrapper callTargetReturnGetValueMemberRef could not be defined.");
@@ -10,6 +10,7 @@
 #include "clr_helpers.h"
 #include "il_rewriter.h"
 #include "integration.h"
+#include "signature_token_cache.h"
 #include "../../../shared/src/native-src/string.h" // NOLINT
 #include "../../../shared/src/native-src/com_ptr.h"
 
@@ -40,6 +41,9 @@ private:
     mdMemberRef callTargetReturnVoidTypeGetDefault = mdMemberRefNil;
     mdMemberRef getDefaultMemberRef = mdMemberRefNil;
 
+    // Type specs, member refs and method specs already defined by the previous rewrites of the module
+    SignatureTokenCache signatureTokens;
+
     HRESULT EnsureCorLibTokens();
     mdTypeRef GetTargetStateTypeRef();
     mdTypeRef GetTargetVoidReturnTypeRef();
@@ -65,6 +69,13 @@ protected:
     HRESULT EnsureBaseCalltargetTokens();
     mdTypeSpec GetTargetReturnValueTypeRef(TypeSignature* returnArgument);
 
+    // IMetaDataEmit calls going through the signature token cache
+    HRESULT GetTokenFromTypeSpec(PCCOR_SIGNATURE signature, ULONG signatureLength, mdTypeSpec* typeSpec);
+    HRESULT DefineMemberRef(mdToken parent, const WCHAR* name, PCCOR_SIGNATURE signature, ULONG signatureLength,
+                            mdMemberRef* memberRef);
+    HRESULT DefineMethodSpec(mdToken parent, PCCOR_SIGNATURE signature, ULONG signatureLength,
+                             mdMethodSpec* methodSpec);
+
     virtual const shared::WSTRING& GetCallTargetType() = 0;
     virtual const shared::WSTRING& GetCallTargetStateType() = 0;
     virtual const shared::WSTRING& GetCallTargetReturnType() = 0;
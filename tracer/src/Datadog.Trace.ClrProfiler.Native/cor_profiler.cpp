@@ -2,6 +2,7 @@
 
 #include "corhlpr.h"
 #include <corprof.h>
+#include <algorithm>
 #include <string>
 #include <typeinfo>
 
@@ -175,6 +176,8 @@ HRESULT STDMETHODCALLTYPE CorProfiler::Initialize(IUnknown* cor_profiler_info_un
 
     rejit_handler = info10 != nullptr ? std::make_shared<RejitHandler>(info10, work_offloader)
                                       : std::make_shared<RejitHandler>(this->info_, work_offloader);
+    rejit_handler->SetRejitBatching(std::chrono::milliseconds(GetRejitBatchWindow()),
+                                    static_cast<size_t>(GetRejitBatchMaxSize()));
     tracer_integration_preprocessor = std::make_unique<TracerRejitPreprocessor>(rejit_handler, work_offloader);
 
     DWORD event_mask = COR_PRF_MONITOR_JIT_COMPILATION | COR_PRF_DISABLE_TRANSPARENCY_CHECKS_UNDER_FULL_TRUST |
@@ -479,41 +482,43 @@ HRESULT STDMETHODCALLTYPE CorProfiler::ModuleLoadFinished(ModuleID module_id, HR
 
     auto hr = TryRejitModule(module_id);
 
-    // Push integration definitions from past modules that were unable to be added
-    auto rejit_size = rejit_module_method_pairs.size();
-    if (rejit_size > 0 && trace_annotation_integration_type != nullptr)
+    // Request the ReJIT of the [Trace] methods of past modules that were unable to be added
+    if (!rejit_module_method_pairs.empty() && trace_annotation_integration_type != nullptr)
     {
-        std::vector<ModuleID> rejitModuleIds;
-        for (size_t i = 0; i < rejit_size; i++)
+        for (const auto& rejit_module_method_pair : rejit_module_method_pairs)
         {
-            auto rejit_module_method_pair = rejit_module_method_pairs.front();
-            rejitModuleIds.push_back(rejit_module_method_pair.first);
+            Logger::Debug("ModuleLoadFinished requesting ReJIT now for ModuleId=", rejit_module_method_pair.first,
+                          ", methodReferences.size()=", rejit_module_method_pair.second.size());
 
-            const auto& methodReferences = rejit_module_method_pair.second;
-            integration_definitions_.reserve(integration_definitions_.size() + methodReferences.size());
+            EnqueueTraceAnnotationsRejit(rejit_module_method_pair.first, rejit_module_method_pair.second);
+        }
 
-            Logger::Debug("ModuleLoadFinished requesting ReJIT now for ModuleId=", module_id,
-                          ", methodReferences.size()=", methodReferences.size());
+        rejit_module_method_pairs.clear();
+    }
 
-            // Push integration definitions from the given module
-            for (const auto& methodReference : methodReferences)
-            {
-                integration_definitions_.push_back(
-                    IntegrationDefinition(methodReference, *trace_annotation_integration_type.get(), false, false));
-            }
+    return hr;
+}
 
-            rejit_module_method_pairs.pop_front();
-        }
+void CorProfiler::EnqueueTraceAnnotationsRejit(ModuleID module_id, const std::vector<MethodReference>& methodReferences)
+{
+    if (tracer_integration_preprocessor == nullptr || methodReferences.empty())
+    {
+        return;
+    }
 
-        // We call the function to analyze the module and request the ReJIT of integrations defined in this module.
-        if (tracer_integration_preprocessor != nullptr && !integration_definitions_.empty())
-        {
-            const auto numReJITs = tracer_integration_preprocessor->RequestRejitForLoadedModules(rejitModuleIds, integration_definitions_);
-            Logger::Debug("Total number of ReJIT Requested: ", numReJITs);
-        }
+    // The [Trace] methods of a module can only be found in that module: they are kept out of integration_definitions_
+    // (which is evaluated for every module load) and only evaluated against their module, on the offloader thread so
+    // the module_ids_lock_ is not held while scanning the module.
+    std::vector<IntegrationDefinition> definitions;
+    definitions.reserve(methodReferences.size());
+    for (const auto& methodReference : methodReferences)
+    {
+        definitions.push_back(
+            IntegrationDefinition(methodReference, *trace_annotation_integration_type.get(), false, false));
     }
 
-    return hr;
+    tracer_integration_preprocessor->EnqueueRequestRejitForLoadedModules(std::vector<ModuleID>{module_id},
+                                                                         definitions, nullptr);
 }
 
 bool ShouldRewriteProfilerMaps()
@@ -625,7 +630,7 @@ HRESULT CorProfiler::TryRejitModule(ModuleID module_id)
     {
         Logger::Info("ModuleLoadFinished: Datadog.Trace.ClrProfiler.Managed.Loader loaded into AppDomain ",
                      app_domain_id, " ", module_info.assembly.app_domain_name);
-        first_jit_compilation_app_domains.insert(app_domain_id);
+        SetStartupHookInjected(app_domain_id);
         return S_OK;
     }
 
@@ -748,7 +753,7 @@ HRESULT CorProfiler::TryRejitModule(ModuleID module_id)
     }
     else
     {
-        module_ids_.push_back(module_id);
+        AddInstrumentedModule(module_id, module_info);
 
         bool searchForTraceAttribute = trace_annotations_enabled;
         if (searchForTraceAttribute)
@@ -765,6 +770,9 @@ HRESULT CorProfiler::TryRejitModule(ModuleID module_id)
             }
         }
 
+        // [Trace] methods of this module, their ReJIT is requested after the one of the integrations
+        std::vector<MethodReference> traceAnnotationMethodReferences;
+
         // Scan module for [Trace] methods
         if (searchForTraceAttribute)
         {
@@ -965,14 +973,7 @@ HRESULT CorProfiler::TryRejitModule(ModuleID module_id)
                                  ", ModuleName=", module_info.assembly.name,
                                  ", methodReferences.size()=", methodReferences.size());
 
-                    integration_definitions_.reserve(integration_definitions_.size() + methodReferences.size());
-
-                    // Push integration definitions from this module
-                    for (const auto& methodReference : methodReferences)
-                    {
-                        integration_definitions_.push_back(IntegrationDefinition(
-                            methodReference, *trace_annotation_integration_type.get(), false, false));
-                    }
+                    traceAnnotationMethodReferences = std::move(methodReferences);
                 }
             }
         }
@@ -980,9 +981,14 @@ HRESULT CorProfiler::TryRejitModule(ModuleID module_id)
         // We call the function to analyze the module and request the ReJIT of integrations defined in this module.
         if (tracer_integration_preprocessor != nullptr && !integration_definitions_.empty())
         {
-            const auto numReJITs = tracer_integration_preprocessor->RequestRejitForLoadedModules(std::vector<ModuleID>{module_id}, integration_definitions_);
+            tracer_integration_preprocessor->IndexDefinitions(integration_definitions_, integration_definitions_index_);
+            const auto numReJITs = tracer_integration_preprocessor->RequestRejitForLoadedModules(
+                std::vector<ModuleID>{module_id}, integration_definitions_, integration_definitions_index_);
             Logger::Debug("Total number of ReJIT Requested: ", numReJITs);
         }
+
+        // Enqueued after the integrations so they still take precedence on the [Trace] methods they also target
+        EnqueueTraceAnnotationsRejit(module_id, traceAnnotationMethodReferences);
     }
 
     return S_OK;
@@ -1012,6 +1018,8 @@ HRESULT STDMETHODCALLTYPE CorProfiler::ModuleUnloadStarted(ModuleID module_id)
         rejit_handler->RemoveModule(module_id);
     }
 
+    RemoveInstrumentedModule(module_id);
+
     const auto& moduleInfo = GetModuleInfo(this->info_, module_id);
     if (!moduleInfo.IsValid())
     {
@@ -1099,13 +1107,11 @@ HRESULT STDMETHODCALLTYPE CorProfiler::JITCompilationStarted(FunctionID function
         return S_OK;
     }
 
-    // keep this lock until we are done using the module,
-    // to prevent it from unloading while in use
-    std::lock_guard<std::mutex> guard(module_ids_lock_);
-
-    // double check if is_attached_ has changed to avoid possible race condition with shutdown function
-    if (!is_attached_)
+    // The only job of this callback is to inject the startup hook: once it has been injected
+    // in every AppDomain containing an instrumented module, there is nothing left to do.
+    if (startup_hook_pending_app_domains_count == 0)
     {
+        trace::Stats::Instance()->JITCompilationStartedSkipped();
         return S_OK;
     }
 
@@ -1121,12 +1127,31 @@ HRESULT STDMETHODCALLTYPE CorProfiler::JITCompilationStarted(FunctionID function
 
     // we have to check if the Id is in the module_ids_ vector.
     // In case is True we create a local ModuleMetadata to inject the loader.
-    if (!shared::Contains(module_ids_, module_id))
+    // This lookup does not need the lock so most of the calls return here without any contention.
+    if (!module_id_set_.Contains(module_id))
     {
+        trace::Stats::Instance()->JITCompilationStartedSkipped();
         return S_OK;
     }
 
-    const auto& module_info = GetModuleInfo(this->info_, module_id);
+    // keep this lock until we are done using the module,
+    // to prevent it from unloading while in use
+    std::lock_guard<std::mutex> guard(module_ids_lock_);
+
+    // double check if is_attached_ has changed to avoid possible race condition with shutdown function
+    if (!is_attached_)
+    {
+        return S_OK;
+    }
+
+    // the module could have been unloaded before we got the lock
+    const auto& module_info_entry = module_infos_.find(module_id);
+    if (module_info_entry == module_infos_.end())
+    {
+        return S_OK;
+    }
+
+    const auto& module_info = module_info_entry->second;
 
     bool has_loader_injected_in_appdomain =
         first_jit_compilation_app_domains.find(module_info.assembly.app_domain_id) !=
@@ -1211,7 +1236,7 @@ HRESULT STDMETHODCALLTYPE CorProfiler::JITCompilationStarted(FunctionID function
                      "(), assembly_name=", module_metadata->assemblyName,
                      " app_domain_id=", module_metadata->app_domain_id, " domain_neutral=", domain_neutral_assembly);
 
-        first_jit_compilation_app_domains.insert(module_metadata->app_domain_id);
+        SetStartupHookInjected(module_metadata->app_domain_id);
 
         hr = RunILStartupHook(module_metadata->metadata_emit, module_id, function_token, caller, *module_metadata);
         if (FAILED(hr))
@@ -1257,6 +1282,8 @@ HRESULT STDMETHODCALLTYPE CorProfiler::AppDomainShutdownFinished(AppDomainID app
 
     // remove appdomain metadata from map
     const auto& count = first_jit_compilation_app_domains.erase(appDomainId);
+    startup_hook_pending_app_domains.erase(appDomainId);
+    startup_hook_pending_app_domains_count = startup_hook_pending_app_domains.size();
 
     Logger::Debug("AppDomainShutdownFinished: AppDomain: ", appDomainId, ", removed ", count, " elements");
 
@@ -1425,6 +1452,12 @@ void CorProfiler::InternalAddInstrumentation(WCHAR* id, CallTargetDefinition* it
             integration_definitions_.push_back(integration);
         }
 
+        // index the new definitions now instead of during the next module load
+        if (tracer_integration_preprocessor != nullptr)
+        {
+            tracer_integration_preprocessor->IndexDefinitions(integration_definitions_, integration_definitions_index_);
+        }
+
         Logger::Info("InitializeProfiler: Total integrations in profiler: ", integration_definitions_.size());
     }
 }
@@ -1524,6 +1557,12 @@ void CorProfiler::InitializeTraceMethods(WCHAR* id, WCHAR* integration_assembly_
                 integration_definitions_.push_back(integration);
             }
 
+            // index the new definitions now instead of during the next module load
+            if (tracer_integration_preprocessor != nullptr)
+            {
+                tracer_integration_preprocessor->IndexDefinitions(integration_definitions_, integration_definitions_index_);
+            }
+
             Logger::Info("InitializeTraceMethods: Total integrations in profiler: ", integration_definitions_.size());
         }
     }
@@ -1956,6 +1995,48 @@ HRESULT CorProfiler::RewriteForDistributedTracing(const ModuleMetadata& module_m
     return hr;
 }
 
+void CorProfiler::AddInstrumentedModule(ModuleID module_id, const ModuleInfo& module_info)
+{
+    // must be called under module_ids_lock_
+    module_ids_.push_back(module_id);
+    module_infos_.emplace(module_id, module_info);
+
+    const auto app_domain_id = module_info.assembly.app_domain_id;
+    if (first_jit_compilation_app_domains.find(app_domain_id) == first_jit_compilation_app_domains.end())
+    {
+        startup_hook_pending_app_domains.insert(app_domain_id);
+        startup_hook_pending_app_domains_count = startup_hook_pending_app_domains.size();
+    }
+
+    // publish the module last: once it is visible to JITCompilationStarted, its ModuleInfo is available
+    module_id_set_.Add(module_id);
+}
+
+void CorProfiler::RemoveInstrumentedModule(ModuleID module_id)
+{
+    // must be called under module_ids_lock_
+    if (!module_id_set_.Remove(module_id))
+    {
+        return;
+    }
+
+    module_infos_.erase(module_id);
+
+    const auto& it = std::find(module_ids_.begin(), module_ids_.end(), module_id);
+    if (it != module_ids_.end())
+    {
+        module_ids_.erase(it);
+    }
+}
+
+void CorProfiler::SetStartupHookInjected(AppDomainID app_domain_id)
+{
+    // must be called under module_ids_lock_
+    first_jit_compilation_app_domains.insert(app_domain_id);
+    startup_hook_pending_app_domains.erase(app_domain_id);
+    startup_hook_pending_app_domains_count = startup_hook_pending_app_domains.size();
+}
+
 bool CorProfiler::TypeNameMatchesTraceAttribute(WCHAR type_name[], DWORD type_name_len)
 {
     static size_t traceAttributeLength = traceattribute_typename.length();
@@ -3205,7 +3286,8 @@ HRESULT STDMETHODCALLTYPE CorProfiler::JITCachedFunctionSearchStarted(FunctionID
     }
 
     // Verify that we have the metadata for this module
-    if (!shared::Contains(module_ids_, module_id))
+    const auto& module_info_entry = module_infos_.find(module_id);
+    if (module_info_entry == module_infos_.end())
     {
         // we haven't stored a ModuleMetadata for this module,
         // so there's nothing to do here, we accept the NGEN image.
@@ -3213,8 +3295,7 @@ HRESULT STDMETHODCALLTYPE CorProfiler::JITCachedFunctionSearchStarted(FunctionID
         return S_OK;
     }
 
-    const auto& module_info = GetModuleInfo(this->info_, module_id);
-    const auto& appDomainId = module_info.assembly.app_domain_id;
+    const auto& appDomainId = module_info_entry->second.assembly.app_domain_id;
 
     const bool has_loader_injected_in_appdomain =
         first_jit_compilation_app_domains.find(appDomainId) != first_jit_compilation_app_domains.end();
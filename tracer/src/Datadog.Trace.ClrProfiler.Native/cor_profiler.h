@@ -19,6 +19,7 @@
 #include <unordered_set>
 #include "clr_helpers.h"
 #include "debugger_probes_instrumentation_requester.h"
+#include "module_id_set.h"
 
 #include "../../../shared/src/native-src/pal.h"
 
@@ -37,6 +38,8 @@ private:
     std::atomic_bool is_attached_ = {false};
     RuntimeInformation runtime_information_;
     std::vector<IntegrationDefinition> integration_definitions_;
+    RejitDefinitionIndex integration_definitions_index_;
+    // [Trace] methods of the modules loaded before the trace annotation integration type is known
     std::deque<std::pair<ModuleID, std::vector<MethodReference>>> rejit_module_method_pairs;
 
     std::unordered_set<shared::WSTRING> definitions_ids_;
@@ -50,6 +53,11 @@ private:
     bool managed_profiler_loaded_domain_neutral = false;
     std::unordered_set<AppDomainID> managed_profiler_loaded_app_domains;
     std::unordered_set<AppDomainID> first_jit_compilation_app_domains;
+
+    // AppDomains containing modules from module_ids_ where the startup hook is not injected yet:
+    // JITCompilationStarted has nothing to do as long as this set is empty
+    std::unordered_set<AppDomainID> startup_hook_pending_app_domains;
+    std::atomic_size_t startup_hook_pending_app_domains_count = {0};
     bool is_desktop_iis = false;
 
     //
@@ -77,6 +85,12 @@ private:
     std::mutex module_ids_lock_;
     std::vector<ModuleID> module_ids_;
 
+    // same ModuleIDs as module_ids_ but the lookups don't need module_ids_lock_
+    ModuleIdSet module_id_set_;
+
+    // ModuleInfo of the modules in module_ids_, computed once in ModuleLoadFinished
+    std::unordered_map<ModuleID, ModuleInfo> module_infos_;
+
     //
     // Helper methods
     //
@@ -89,7 +103,11 @@ private:
     HRESULT RewriteForDistributedTracing(const ModuleMetadata& module_metadata, ModuleID module_id);
     HRESULT EmitDistributedTracerTargetMethod(const ModuleMetadata& module_metadata, ModuleID module_id);
     HRESULT TryRejitModule(ModuleID module_id);
+    void EnqueueTraceAnnotationsRejit(ModuleID module_id, const std::vector<MethodReference>& methodReferences);
     bool TypeNameMatchesTraceAttribute(WCHAR type_name[], DWORD type_name_len);
+    void AddInstrumentedModule(ModuleID module_id, const ModuleInfo& module_info);
+    void RemoveInstrumentedModule(ModuleID module_id);
+    void SetStartupHookInjected(AppDomainID app_domain_id);
     //
     // Startup methods
     //
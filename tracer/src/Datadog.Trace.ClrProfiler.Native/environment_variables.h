@@ -112,6 +112,14 @@ namespace environment
     // Sets whether to enable NGEN images.
     const shared::WSTRING clr_enable_ngen = WStr("DD_CLR_ENABLE_NGEN");
 
+    // Sets the time, in milliseconds, the ReJIT requests are accumulated before calling RequestReJIT.
+    // Default is 10ms, 0 only coalesces the requests already enqueued.
+    const shared::WSTRING clr_rejit_batch_window = WStr("DD_CLR_REJIT_BATCH_WINDOW");
+
+    // Sets the number of methods after which the accumulated ReJIT requests are requested without waiting
+    // for the end of the window. Default is 2000.
+    const shared::WSTRING clr_rejit_batch_max_size = WStr("DD_CLR_REJIT_BATCH_MAX_SIZE");
+
 } // namespace environment
 } // namespace trace
 
@@ -63,4 +63,26 @@ bool IsVersionCompatibilityEnabled()
     ToBooleanWithDefault(shared::GetEnvironmentValue(environment::internal_version_compatibility), true);
 }
 
+int GetRejitBatchWindow()
+{
+    int value;
+    if (shared::TryParse(shared::GetEnvironmentValue(environment::clr_rejit_batch_window), value) && value >= 0)
+    {
+        return value;
+    }
+
+    return 10;
+}
+
+int GetRejitBatchMaxSize()
+{
+    int value;
+    if (shared::TryParse(shared::GetEnvironmentValue(environment::clr_rejit_batch_max_size), value) && value > 0)
+    {
+        return value;
+    }
+
+    return 2000;
+}
+
 } // namespace trace
\ No newline at end of file
@@ -58,6 +58,8 @@ bool NeedsDogstatsdInAAS();
 bool IsTraceAnnotationEnabled();
 bool IsAzureFunctionsEnabled();
 bool IsVersionCompatibilityEnabled();
+int GetRejitBatchWindow();
+int GetRejitBatchMaxSize();
 
 } // namespace trace
 
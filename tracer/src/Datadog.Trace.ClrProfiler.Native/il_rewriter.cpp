@@ -6,6 +6,8 @@
 
 #include "il_rewriter.h"
 
+#include <new>
+
 #undef IfFailRet
 #define IfFailRet(EXPR)                                                                                                \
     do                                                                                                                 \
@@ -106,6 +108,75 @@ static int k_rgnStackPushes[] = {
     0  // CEE_SWITCH_ARG
 };
 
+ILRewriterArena::ILRewriterArena() :
+    m_pCurrent(nullptr), m_remaining(0), m_nextBlockSize(FirstBlockSize), m_allocationCount(0)
+{
+}
+
+ILRewriterArena::~ILRewriterArena()
+{
+    for (const auto& block : m_blocks)
+    {
+        delete[] block.m_pData;
+    }
+}
+
+void* ILRewriterArena::Allocate(size_t size)
+{
+    size = (size + Alignment - 1) & ~(Alignment - 1);
+    m_allocationCount++;
+
+    if (size > m_remaining)
+    {
+        if (size > m_nextBlockSize / 4)
+        {
+            // Large arrays get their own block so the remaining space of the current one is not wasted
+            BYTE* pData = new BYTE[size];
+            m_blocks.push_back({pData, size});
+            return pData;
+        }
+
+        // Most methods are small: start with a small block and double the size of the next ones
+        BYTE* pData = new BYTE[m_nextBlockSize];
+        m_blocks.push_back({pData, m_nextBlockSize});
+        m_pCurrent = pData;
+        m_remaining = m_nextBlockSize;
+
+        if (m_nextBlockSize < MaxBlockSize)
+        {
+            m_nextBlockSize *= 2;
+        }
+    }
+
+    void* p = m_pCurrent;
+    m_pCurrent += size;
+    m_remaining -= size;
+    return p;
+}
+
+bool ILRewriterArena::Owns(const void* p) const
+{
+    for (const auto& block : m_blocks)
+    {
+        if (p >= block.m_pData && p < block.m_pData + block.m_size)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+size_t ILRewriterArena::GetBlockCount() const
+{
+    return m_blocks.size();
+}
+
+size_t ILRewriterArena::GetAllocationCount() const
+{
+    return m_allocationCount;
+}
+
 ILRewriter::ILRewriter(ICorProfilerInfo* pICorProfilerInfo, ICorProfilerFunctionControl* pICorProfilerFunctionControl,
                        ModuleID moduleID, mdToken tkMethod) :
     m_pICorProfilerInfo(pICorProfilerInfo),
@@ -126,14 +197,11 @@ ILRewriter::ILRewriter(ICorProfilerInfo* pICorProfilerInfo, ICorProfilerFunction
 
 ILRewriter::~ILRewriter()
 {
-    ILInstr* p = m_IL.m_pNext;
-    while (p != &m_IL)
+    // The instructions are released with the arena
+    if (!m_arena.Owns(m_pEH))
     {
-        ILInstr* t = p->m_pNext;
-        delete p;
-        p = t;
+        delete[] m_pEH;
     }
-    delete[] m_pEH;
     delete[] m_pOffsetToInstr;
     delete[] m_pOutputBuffer;
 
@@ -176,7 +244,7 @@ EHClause* ILRewriter::GetEHPointer()
 
 void ILRewriter::SetEHClause(EHClause* ehPointer, unsigned ehLength)
 {
-    if (m_pEH != nullptr)
+    if (m_pEH != nullptr && !m_arena.Owns(m_pEH))
     {
         // Delete previous array
         m_nEH = 0;
@@ -187,6 +255,22 @@ void ILRewriter::SetEHClause(EHClause* ehPointer, unsigned ehLength)
     m_pEH = ehPointer;
 }
 
+EHClause* ILRewriter::NewEHClauses(unsigned count)
+{
+    if (count == 0)
+    {
+        return nullptr;
+    }
+
+    EHClause* pEH = static_cast<EHClause*>(m_arena.Allocate(sizeof(EHClause) * count));
+    for (unsigned i = 0; i < count; i++)
+    {
+        new (&pEH[i]) EHClause();
+    }
+
+    return pEH;
+}
+
 HRESULT ILRewriter::Import()
 {
     LPCBYTE pMethodBytes;
@@ -358,7 +442,7 @@ HRESULT ILRewriter::ImportEH(const COR_ILMETHOD_SECT_EH* pILEH, unsigned nEH)
 
     if (nEH == 0) return S_OK;
 
-    IfNullRet(m_pEH = new EHClause[m_nEH]);
+    IfNullRet(m_pEH = NewEHClauses(m_nEH));
     for (unsigned iEH = 0; iEH < m_nEH; iEH++)
     {
         // If the EH clause is in tiny form, the call to pILEH->EHClause() below
@@ -402,7 +486,7 @@ HRESULT ILRewriter::ImportEH(const COR_ILMETHOD_SECT_EH* pILEH, unsigned nEH)
 ILInstr* ILRewriter::NewILInstr()
 {
     m_nInstrs++;
-    return new ILInstr();
+    return new (m_arena.Allocate(sizeof(ILInstr))) ILInstr();
 }
 
 HRESULT ILRewriter::GetInstrFromOffset(unsigned offset, ILInstr** ppInstr)
@@ -453,6 +537,11 @@ ILInstr* ILRewriter::GetILList()
     return &m_IL;
 }
 
+const ILRewriterArena& ILRewriter::GetArena() const
+{
+    return m_arena;
+}
+
 HRESULT ILRewriter::Export()
 {
     // One instruction produces 2 + sizeof(native int) bytes in the worst case
@@ -0,0 +1,238 @@
+#ifndef DD_CLR_PROFILER_INSTRUMENTED_METHOD_SET_H_
+#define DD_CLR_PROFILER_INSTRUMENTED_METHOD_SET_H_
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cor.h"
+#include "corprof.h"
+
+namespace trace
+{
+
+/// <summary>
+/// Read-optimized set of the (ModuleID, mdMethodDef) pairs requested for ReJIT.
+/// Contains is called by JITInlining for every inlining decision: it reads an immutable snapshot without taking
+/// any lock and a per-module bloom filter rejects most of the methods that are not instrumented.
+/// Writers add methods to a pending state and Publish replaces the snapshot (read-copy-update). The readers announce
+/// themselves in one of two counters selected by the current epoch: once a new snapshot is published, the writer flips
+/// the epoch and waits for each counter to drain (grace period) before freeing the replaced snapshot and module
+/// entries. The snapshots only change once per batch of ReJIT requests, so the writers barely wait.
+/// </summary>
+class InstrumentedMethodSet
+{
+private:
+    struct ModuleEntry
+    {
+        ModuleID moduleId;
+        std::vector<uint64_t> bloomFilter;
+        std::vector<mdMethodDef> methodDefs; // sorted
+    };
+
+    struct Snapshot
+    {
+        std::vector<const ModuleEntry*> modules; // sorted by ModuleID
+    };
+
+    std::atomic<const Snapshot*> m_snapshot;
+
+    // readers inside Contains, indexed by the parity of the epoch they started in
+    mutable std::atomic<uint64_t> m_epoch = {0};
+    mutable std::atomic<uint32_t> m_readers[2] = {{0}, {0}};
+
+    // writers state
+    std::mutex m_lock;
+    std::unordered_map<ModuleID, std::unordered_set<mdMethodDef>> m_methods;
+    std::map<ModuleID, std::unique_ptr<const ModuleEntry>> m_entries;
+    std::unordered_set<ModuleID> m_dirtyModules;
+    std::unique_ptr<const Snapshot> m_currentSnapshot;
+
+    static uint64_t Hash(mdMethodDef methodDef)
+    {
+        return static_cast<uint64_t>(methodDef) * 0x9E3779B97F4A7C15ull;
+    }
+
+    static bool BloomFilterMayContain(const std::vector<uint64_t>& bloomFilter, mdMethodDef methodDef)
+    {
+        // two bit indexes taken from the same hash
+        const auto hash = Hash(methodDef);
+        const auto bitsMask = bloomFilter.size() * 64 - 1;
+        const auto first = (hash >> 32) & bitsMask;
+        const auto second = (hash >> 16) & bitsMask;
+        return (bloomFilter[first / 64] & (1ull << (first % 64))) != 0 &&
+               (bloomFilter[second / 64] & (1ull << (second % 64))) != 0;
+    }
+
+    static std::unique_ptr<const ModuleEntry> CreateEntry(ModuleID moduleId,
+                                                          const std::unordered_set<mdMethodDef>& methodDefs)
+    {
+        auto entry = std::make_unique<ModuleEntry>();
+        entry->moduleId = moduleId;
+        entry->methodDefs.assign(methodDefs.begin(), methodDefs.end());
+        std::sort(entry->methodDefs.begin(), entry->methodDefs.end());
+
+        // ~16 bits per method keeps the false positive rate around 1%
+        size_t words = 1;
+        while (words * 64 < methodDefs.size() * 16)
+        {
+            words *= 2;
+        }
+
+        entry->bloomFilter.resize(words, 0);
+        const auto bitsMask = words * 64 - 1;
+        for (const auto methodDef : methodDefs)
+        {
+            const auto hash = Hash(methodDef);
+            const auto first = (hash >> 32) & bitsMask;
+            const auto second = (hash >> 16) & bitsMask;
+            entry->bloomFilter[first / 64] |= 1ull << (first % 64);
+            entry->bloomFilter[second / 64] |= 1ull << (second % 64);
+        }
+
+        return entry;
+    }
+
+    // Wait until every reader that may still use a replaced snapshot has left Contains.
+    // The epoch is flipped before waiting for each counter so new readers do not delay the grace period.
+    void WaitForReaders() const
+    {
+        for (int i = 0; i < 2; i++)
+        {
+            const auto previous = m_epoch.fetch_add(1) & 1;
+            while (m_readers[previous].load() != 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // The retired entries are freed with the replaced snapshot, after the grace period
+    void PublishSnapshot(std::vector<std::unique_ptr<const ModuleEntry>>& retiredEntries)
+    {
+        auto snapshot = std::make_unique<Snapshot>();
+        snapshot->modules.reserve(m_entries.size());
+        for (const auto& entry : m_entries)
+        {
+            snapshot->modules.push_back(entry.second.get());
+        }
+
+        m_snapshot.store(snapshot.get());
+
+        // freed when leaving, after the grace period
+        const auto retiredSnapshot = std::move(m_currentSnapshot);
+        m_currentSnapshot = std::move(snapshot);
+
+        WaitForReaders();
+        retiredEntries.clear();
+    }
+
+public:
+    InstrumentedMethodSet() : m_currentSnapshot(std::make_unique<Snapshot>())
+    {
+        m_snapshot.store(m_currentSnapshot.get());
+    }
+
+    InstrumentedMethodSet(const InstrumentedMethodSet&) = delete;
+    InstrumentedMethodSet& operator=(const InstrumentedMethodSet&) = delete;
+
+    bool Contains(ModuleID moduleId, mdMethodDef methodDef) const
+    {
+        auto& readers = m_readers[m_epoch.load() & 1];
+        readers++;
+
+        const auto snapshot = m_snapshot.load();
+        const auto& modules = snapshot->modules;
+        bool found = false;
+
+        const auto module = std::lower_bound(modules.begin(), modules.end(), moduleId,
+                                             [](const ModuleEntry* entry, ModuleID id) { return entry->moduleId < id; });
+        if (module != modules.end() && (*module)->moduleId == moduleId)
+        {
+            const auto entry = *module;
+            found = BloomFilterMayContain(entry->bloomFilter, methodDef) &&
+                    std::binary_search(entry->methodDefs.begin(), entry->methodDefs.end(), methodDef);
+        }
+
+        readers.fetch_sub(1, std::memory_order_release);
+        return found;
+    }
+
+    // The method is only visible to Contains after the next call to Publish
+    void Add(ModuleID moduleId, mdMethodDef methodDef)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        if (m_methods[moduleId].insert(methodDef).second)
+        {
+            m_dirtyModules.insert(moduleId);
+        }
+    }
+
+    void Publish()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        if (m_dirtyModules.empty())
+        {
+            return;
+        }
+
+        std::vector<std::unique_ptr<const ModuleEntry>> retiredEntries;
+        for (const auto moduleId : m_dirtyModules)
+        {
+            auto& entry = m_entries[moduleId];
+            if (entry != nullptr)
+            {
+                retiredEntries.push_back(std::move(entry));
+            }
+            entry = CreateEntry(moduleId, m_methods[moduleId]);
+        }
+        m_dirtyModules.clear();
+
+        PublishSnapshot(retiredEntries);
+    }
+
+    void RemoveModule(ModuleID moduleId)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        m_methods.erase(moduleId);
+        m_dirtyModules.erase(moduleId);
+
+        const auto entry = m_entries.find(moduleId);
+        if (entry != m_entries.end())
+        {
+            std::vector<std::unique_ptr<const ModuleEntry>> retiredEntries;
+            retiredEntries.push_back(std::move(entry->second));
+            m_entries.erase(entry);
+            PublishSnapshot(retiredEntries);
+        }
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        std::vector<std::unique_ptr<const ModuleEntry>> retiredEntries;
+        for (auto& entry : m_entries)
+        {
+            retiredEntries.push_back(std::move(entry.second));
+        }
+
+        m_methods.clear();
+        m_dirtyModules.clear();
+        m_entries.clear();
+        PublishSnapshot(retiredEntries);
+    }
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_INSTRUMENTED_METHOD_SET_H_
@@ -599,7 +599,7 @@ HRESULT TracerMethodRewriter::Rewrite(RejitHandlerModule* moduleHandler, RejitHa
     // ***
     auto ehCount = rewriter.GetEHCount();
     auto ehPointer = rewriter.GetEHPointer();
-    auto newEHClauses = new EHClause[ehCount + 4];
+    auto newEHClauses = rewriter.NewEHClauses(ehCount + 4);
     for (unsigned i = 0; i < ehCount; i++)
     {
         newEHClauses[i] = ehPointer[i];
@@ -0,0 +1,248 @@
+#ifndef DD_CLR_PROFILER_MODULE_ID_SET_H_
+#define DD_CLR_PROFILER_MODULE_ID_SET_H_
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "corprof.h"
+
+namespace trace
+{
+
+/// <summary>
+/// Open addressing hash set of ModuleIDs where lookups are lock-free.
+/// Add and Remove must be serialized by the caller (i.e. under module_ids_lock_) while Contains can be
+/// called from any thread at any time: it is used by the JIT callbacks to reject the modules we don't
+/// care about without taking a lock.
+/// The readers announce themselves in one of two counters selected by the current epoch (as InstrumentedMethodSet
+/// does): after a resize the epoch is flipped and each counter drained (grace period) before the replaced table is
+/// freed, so load/unload churn does not accumulate tables.
+/// </summary>
+class ModuleIdSet
+{
+private:
+    static constexpr ModuleID EmptySlot = 0;
+    static constexpr ModuleID RemovedSlot = static_cast<ModuleID>(-1);
+    static constexpr size_t InitialCapacity = 256;
+
+    struct Table
+    {
+        const size_t capacity;
+        std::unique_ptr<std::atomic<ModuleID>[]> slots;
+
+        Table(size_t capacity) : capacity(capacity), slots(new std::atomic<ModuleID>[capacity])
+        {
+            for (size_t i = 0; i < capacity; i++)
+            {
+                slots[i].store(EmptySlot, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    std::atomic<Table*> m_table;
+    std::unique_ptr<Table> m_currentTable;
+
+    // readers inside Contains, indexed by the parity of the epoch they started in
+    mutable std::atomic<uint64_t> m_epoch = {0};
+    mutable std::atomic<uint32_t> m_readers[2] = {{0}, {0}};
+
+    size_t m_count = 0;
+    size_t m_usedSlots = 0;
+
+    static size_t GetFirstSlot(ModuleID moduleId, size_t capacity)
+    {
+        // ModuleIDs are pointers: drop the always-zero low bits and mix the rest
+        auto hash = static_cast<uint64_t>(moduleId >> 3) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(hash >> 32) & (capacity - 1);
+    }
+
+    static void Insert(Table* table, ModuleID moduleId)
+    {
+        auto slot = GetFirstSlot(moduleId, table->capacity);
+        while (true)
+        {
+            const auto current = table->slots[slot].load(std::memory_order_relaxed);
+            if (current == EmptySlot || current == RemovedSlot)
+            {
+                table->slots[slot].store(moduleId, std::memory_order_release);
+                return;
+            }
+
+            slot = (slot + 1) & (table->capacity - 1);
+        }
+    }
+
+    // Wait until every reader that may still probe a replaced table has left Contains.
+    // The epoch is flipped before waiting for each counter so new readers do not delay the grace period.
+    void WaitForReaders() const
+    {
+        for (int i = 0; i < 2; i++)
+        {
+            const auto previous = m_epoch.fetch_add(1) & 1;
+            while (m_readers[previous].load() != 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void Resize()
+    {
+        auto oldTable = m_table.load(std::memory_order_relaxed);
+
+        // Removed slots are dropped while rehashing so the capacity only grows with live entries:
+        // when the table is mostly made of removed slots, it is rehashed into a table of the same size
+        auto capacity = oldTable->capacity;
+        while ((m_count + 1) * 2 > capacity)
+        {
+            capacity *= 2;
+        }
+
+        auto newTable = std::make_unique<Table>(capacity);
+        for (size_t i = 0; i < oldTable->capacity; i++)
+        {
+            const auto current = oldTable->slots[i].load(std::memory_order_relaxed);
+            if (current != EmptySlot && current != RemovedSlot)
+            {
+                Insert(newTable.get(), current);
+            }
+        }
+
+        m_usedSlots = m_count;
+        m_table.store(newTable.get(), std::memory_order_release);
+
+        // freed when leaving, after the grace period
+        const auto retiredTable = std::move(m_currentTable);
+        m_currentTable = std::move(newTable);
+
+        WaitForReaders();
+    }
+
+public:
+    ModuleIdSet() : m_currentTable(std::make_unique<Table>(InitialCapacity))
+    {
+        m_table.store(m_currentTable.get(), std::memory_order_release);
+    }
+
+    ModuleIdSet(const ModuleIdSet&) = delete;
+    ModuleIdSet& operator=(const ModuleIdSet&) = delete;
+
+    bool Contains(ModuleID moduleId) const
+    {
+        if (moduleId == EmptySlot || moduleId == RemovedSlot)
+        {
+            return false;
+        }
+
+        auto& readers = m_readers[m_epoch.load() & 1];
+        readers++;
+
+        const auto table = m_table.load(std::memory_order_acquire);
+        auto slot = GetFirstSlot(moduleId, table->capacity);
+        bool found = false;
+
+        // The load factor is kept below 3/4 so there is always an empty slot to stop the probing
+        for (size_t i = 0; i < table->capacity; i++)
+        {
+            const auto current = table->slots[slot].load(std::memory_order_acquire);
+            if (current == moduleId)
+            {
+                found = true;
+                break;
+            }
+
+            if (current == EmptySlot)
+            {
+                break;
+            }
+
+            slot = (slot + 1) & (table->capacity - 1);
+        }
+
+        readers.fetch_sub(1, std::memory_order_release);
+        return found;
+    }
+
+    bool Add(ModuleID moduleId)
+    {
+        if (moduleId == EmptySlot || moduleId == RemovedSlot || Contains(moduleId))
+        {
+            return false;
+        }
+
+        if ((m_usedSlots + 1) * 4 > m_table.load(std::memory_order_relaxed)->capacity * 3)
+        {
+            Resize();
+        }
+
+        auto table = m_table.load(std::memory_order_relaxed);
+        auto slot = GetFirstSlot(moduleId, table->capacity);
+        while (true)
+        {
+            const auto current = table->slots[slot].load(std::memory_order_relaxed);
+            if (current == RemovedSlot)
+            {
+                // reuse the slot: the number of used slots does not change
+                break;
+            }
+
+            if (current == EmptySlot)
+            {
+                m_usedSlots++;
+                break;
+            }
+
+            slot = (slot + 1) & (table->capacity - 1);
+        }
+
+        table->slots[slot].store(moduleId, std::memory_order_release);
+        m_count++;
+        return true;
+    }
+
+    bool Remove(ModuleID moduleId)
+    {
+        if (moduleId == EmptySlot || moduleId == RemovedSlot)
+        {
+            return false;
+        }
+
+        auto table = m_table.load(std::memory_order_relaxed);
+        auto slot = GetFirstSlot(moduleId, table->capacity);
+        for (size_t i = 0; i < table->capacity; i++)
+        {
+            const auto current = table->slots[slot].load(std::memory_order_relaxed);
+            if (current == moduleId)
+            {
+                // keep the probing chain of the other entries intact
+                table->slots[slot].store(RemovedSlot, std::memory_order_release);
+                m_count--;
+                return true;
+            }
+
+            if (current == EmptySlot)
+            {
+                return false;
+            }
+
+            slot = (slot + 1) & (table->capacity - 1);
+        }
+
+        return false;
+    }
+
+    size_t Size() const
+    {
+        return m_count;
+    }
+
+    size_t Capacity() const
+    {
+        return m_table.load(std::memory_order_relaxed)->capacity;
+    }
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_MODULE_ID_SET_H_
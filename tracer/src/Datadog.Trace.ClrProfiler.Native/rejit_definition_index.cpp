@@ -0,0 +1,98 @@
+#include "rejit_definition_index.h"
+
+#include <algorithm>
+
+namespace trace
+{
+
+uint64_t RejitDefinitionIndex::ToKey(const Version& version)
+{
+    // like the Version comparison operators, the revision is ignored
+    return (static_cast<uint64_t>(version.major) << 32) | (static_cast<uint64_t>(version.minor) << 16) |
+           static_cast<uint64_t>(version.build);
+}
+
+void RejitDefinitionIndex::AddToBucket(Bucket& bucket, const Entry& entry)
+{
+    // keep the insertion order of the entries with the same min_version
+    const auto position = std::upper_bound(bucket.begin(), bucket.end(), entry, [](const Entry& a, const Entry& b) {
+        return a.min_version < b.min_version;
+    });
+    bucket.insert(position, entry);
+}
+
+void RejitDefinitionIndex::GetFromBucket(const Bucket& bucket, const Version& version, std::vector<size_t>& positions)
+{
+    const auto key = ToKey(version);
+    for (const auto& entry : bucket)
+    {
+        if (entry.min_version > key)
+        {
+            break;
+        }
+
+        if (entry.max_version >= key)
+        {
+            positions.push_back(entry.position);
+        }
+    }
+}
+
+void RejitDefinitionIndex::Add(const shared::WSTRING& assembly_name, const Version& min_version,
+                               const Version& max_version, bool is_derived)
+{
+    const Entry entry = {ToKey(min_version), ToKey(max_version), m_size++};
+
+    if (is_derived)
+    {
+        AddToBucket(m_derived_definitions[assembly_name], entry);
+    }
+    else if (assembly_name == tracemethodintegration_assemblyname)
+    {
+        AddToBucket(m_trace_method_definitions, entry);
+    }
+    else
+    {
+        AddToBucket(m_definitions[assembly_name], entry);
+    }
+}
+
+size_t RejitDefinitionIndex::Size() const
+{
+    return m_size;
+}
+
+bool RejitDefinitionIndex::HasDerivedDefinitions() const
+{
+    return !m_derived_definitions.empty();
+}
+
+bool RejitDefinitionIndex::MayMatch(const shared::WSTRING& assembly_name) const
+{
+    return HasDerivedDefinitions() || !m_trace_method_definitions.empty() ||
+           m_definitions.find(assembly_name) != m_definitions.end();
+}
+
+void RejitDefinitionIndex::GetDefinitions(const shared::WSTRING& assembly_name, const Version& version,
+                                          std::vector<size_t>& positions) const
+{
+    const auto bucket = m_definitions.find(assembly_name);
+    if (bucket != m_definitions.end())
+    {
+        GetFromBucket(bucket->second, version, positions);
+    }
+
+    GetFromBucket(m_trace_method_definitions, version, positions);
+}
+
+void RejitDefinitionIndex::GetDerivedDefinitions(const shared::WSTRING& assembly_name, const Version& version,
+                                                 std::vector<size_t>& positions) const
+{
+    const auto bucket = m_derived_definitions.find(assembly_name);
+    if (bucket != m_derived_definitions.end())
+    {
+        GetFromBucket(bucket->second, version, positions);
+    }
+}
+
+} // namespace trace
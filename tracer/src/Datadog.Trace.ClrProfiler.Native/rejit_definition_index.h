@@ -0,0 +1,64 @@
+#ifndef DD_CLR_PROFILER_REJIT_DEFINITION_INDEX_H_
+#define DD_CLR_PROFILER_REJIT_DEFINITION_INDEX_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "integration.h"
+
+namespace trace
+{
+
+/// <summary>
+/// Index of rejit request definitions by target assembly name, so RequestRejitForLoadedModules only visits
+/// the definitions that can match a module instead of comparing every definition with every module.
+/// The index stores the positions of the definitions in the vector they come from: definitions must be added
+/// in the same order, and the positions are returned in ascending order so the definitions are processed
+/// in the same order as before.
+/// </summary>
+class RejitDefinitionIndex
+{
+private:
+    // Versions are packed into integers: Version is not assignable and integers are faster to compare
+    struct Entry
+    {
+        uint64_t min_version;
+        uint64_t max_version;
+        size_t position;
+    };
+
+    // Entries are sorted by min_version so a lookup stops at the first entry above the version
+    using Bucket = std::vector<Entry>;
+
+    std::unordered_map<shared::WSTRING, Bucket> m_definitions;
+    std::unordered_map<shared::WSTRING, Bucket> m_derived_definitions;
+    Bucket m_trace_method_definitions;
+    size_t m_size = 0;
+
+    static uint64_t ToKey(const Version& version);
+    static void AddToBucket(Bucket& bucket, const Entry& entry);
+    static void GetFromBucket(const Bucket& bucket, const Version& version, std::vector<size_t>& positions);
+
+public:
+    void Add(const shared::WSTRING& assembly_name, const Version& min_version, const Version& max_version,
+             bool is_derived);
+
+    size_t Size() const;
+    bool HasDerivedDefinitions() const;
+
+    // Return false if no definition can match the module: its metadata does not need to be loaded
+    bool MayMatch(const shared::WSTRING& assembly_name) const;
+
+    // Positions of the non derived definitions targeting this assembly version (including the trace methods)
+    void GetDefinitions(const shared::WSTRING& assembly_name, const Version& version,
+                        std::vector<size_t>& positions) const;
+
+    // Positions of the derived definitions whose target type is in this assembly version; a module must be
+    // checked with its own assembly and with each assembly it references.
+    void GetDerivedDefinitions(const shared::WSTRING& assembly_name, const Version& version,
+                               std::vector<size_t>& positions) const;
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_REJIT_DEFINITION_INDEX_H_
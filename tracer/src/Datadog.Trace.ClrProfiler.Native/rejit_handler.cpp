@@ -193,6 +193,9 @@ bool RejitHandlerModule::CreateMethodIfNotExists(const mdMethodDef methodDef,
     }
 
     m_methods[methodDef] = creator(methodDef, this);
+
+    // Inlining of this method is blocked once the ReJIT is requested
+    m_handler->AddInstrumentedMethod(m_moduleId, methodDef);
     return true;
 }
 
@@ -258,11 +261,65 @@ void RejitHandler::RequestRejit(std::vector<ModuleID>& modulesVector,
         return;
     }
 
+    // Same as EnqueueForRejit: one batch per non-empty request, coalesced or not
+    if (!modulesVector.empty() && !modulesMethodDef.empty())
+    {
+        Stats::Instance()->RejitBatchRequested();
+    }
+
+    // The methods waiting in the coalescing stage are requested with this batch
+    AppendPendingRejit(modulesVector, modulesMethodDef);
+    RequestRejitNow(modulesVector, modulesMethodDef);
+}
+
+void RejitHandler::AppendPendingRejit(std::vector<ModuleID>& modulesVector, std::vector<mdMethodDef>& modulesMethodDef)
+{
+    std::lock_guard<std::mutex> guard(m_pending_rejit_lock);
+    if (m_pending_rejit_modules.empty())
+    {
+        return;
+    }
+
+    modulesVector.insert(modulesVector.end(), m_pending_rejit_modules.begin(), m_pending_rejit_modules.end());
+    modulesMethodDef.insert(modulesMethodDef.end(), m_pending_rejit_methodDefs.begin(),
+                            m_pending_rejit_methodDefs.end());
+    m_pending_rejit_modules.clear();
+    m_pending_rejit_methodDefs.clear();
+}
+
+void RejitHandler::FlushPendingRejit()
+{
+    std::vector<ModuleID> modules;
+    std::vector<mdMethodDef> methods;
+
+    {
+        std::lock_guard<std::mutex> guard(m_pending_rejit_lock);
+        modules = std::move(m_pending_rejit_modules);
+        methods = std::move(m_pending_rejit_methodDefs);
+        m_pending_rejit_modules.clear();
+        m_pending_rejit_methodDefs.clear();
+        m_pending_rejit_flush_enqueued = false;
+    }
+
+    // Already requested by a full batch or by RequestRejit
+    if (modules.empty() || IsShutdownRequested())
+    {
+        return;
+    }
+
+    RequestRejitNow(modules, methods);
+}
+
+void RejitHandler::RequestRejitNow(std::vector<ModuleID>& modulesVector, std::vector<mdMethodDef>& modulesMethodDef)
+{
     // Request the ReJIT for all integrations found in the module.
     HRESULT hr;
 
     if (!modulesVector.empty())
     {
+        // Make the new methods visible to JITInlining before their ReJIT is requested
+        m_instrumentedMethods.Publish();
+
         // *************************************
         // Request ReJIT
         // *************************************
@@ -287,6 +344,8 @@ void RejitHandler::RequestRejit(std::vector<ModuleID>& modulesVector,
         {
             hr = m_profilerInfo->RequestReJIT((ULONG) modulesVector.size(), &modulesVector[0], &modulesMethodDef[0]);
         }
+        Stats::Instance()->RejitRuntimeSuspension();
+
         if (SUCCEEDED(hr))
         {
             Logger::Info("Request ReJIT done for ", modulesVector.size(), " methods");
@@ -333,20 +392,14 @@ RejitHandlerModule* RejitHandler::GetOrAddModule(ModuleID moduleId)
 
 bool RejitHandler::HasModuleAndMethod(ModuleID moduleId, mdMethodDef methodDef)
 {
-    if (IsShutdownRequested())
-    {
-        return false;
-    }
-
-    std::lock_guard<std::mutex> guard(m_modules_lock);
-    auto find_res = m_modules.find(moduleId);
-    if (find_res != m_modules.end())
-    {
-        auto moduleHandler = find_res->second.get();
-        return moduleHandler->ContainsMethod(methodDef);
-    }
+    // Called for each JITInlining callback: no lock is taken here, not even the shutdown one
+    // (the set is cleared on shutdown).
+    return m_instrumentedMethods.Contains(moduleId, methodDef);
+}
 
-    return false;
+void RejitHandler::AddInstrumentedMethod(ModuleID moduleId, mdMethodDef methodDef)
+{
+    m_instrumentedMethods.Add(moduleId, methodDef);
 }
 
 void RejitHandler::RemoveModule(ModuleID moduleId)
@@ -356,9 +409,27 @@ void RejitHandler::RemoveModule(ModuleID moduleId)
         return;
     }
 
+    // Drops the methods of the module still waiting in the coalescing stage: the ModuleID is not valid anymore
+    {
+        std::lock_guard<std::mutex> pendingGuard(m_pending_rejit_lock);
+        size_t kept = 0;
+        for (size_t i = 0; i < m_pending_rejit_modules.size(); i++)
+        {
+            if (m_pending_rejit_modules[i] != moduleId)
+            {
+                m_pending_rejit_modules[kept] = m_pending_rejit_modules[i];
+                m_pending_rejit_methodDefs[kept] = m_pending_rejit_methodDefs[i];
+                kept++;
+            }
+        }
+        m_pending_rejit_modules.resize(kept);
+        m_pending_rejit_methodDefs.resize(kept);
+    }
+
     // Removes the RejitHandlerModule instance
     std::lock_guard<std::mutex> modulesGuard(m_modules_lock);
     m_modules.erase(moduleId);
+    m_instrumentedMethods.RemoveModule(moduleId);
 
     // Removes the moduleID from the inliners vector
     std::lock_guard<std::mutex> inlinersGuard(m_ngenInlinersModules_lock);
@@ -422,14 +493,47 @@ void RejitHandler::EnqueueForRejit(std::vector<ModuleID>& modulesVector, std::ve
 
     Logger::Debug("RejitHandler::EnqueueForRejit");
 
-    std::function<void()> action = [=, modules = std::move(modulesVector),
-                                    methods = std::move(modulesMethodDef)]() mutable {
+    // Make the new methods visible to JITInlining before their ReJIT is requested
+    m_instrumentedMethods.Publish();
+
+    // Same as RequestRejit: one batch per non-empty request, coalesced or not
+    Stats::Instance()->RejitBatchRequested();
+
+    std::function<void()> action = [this]() {
         // Request ReJIT
-        RequestRejit(modules, methods);
+        FlushPendingRejit();
     };
 
-    // Enqueue
-    m_work_offloader->Enqueue(std::make_unique<RejitWorkItem>(std::move(action)));
+    std::lock_guard<std::mutex> guard(m_pending_rejit_lock);
+    const bool wasFull = m_pending_rejit_modules.size() >= m_rejit_batch_max_size;
+    m_pending_rejit_modules.insert(m_pending_rejit_modules.end(), modulesVector.begin(), modulesVector.end());
+    m_pending_rejit_methodDefs.insert(m_pending_rejit_methodDefs.end(), modulesMethodDef.begin(),
+                                      modulesMethodDef.end());
+
+    if (!wasFull && m_pending_rejit_modules.size() >= m_rejit_batch_max_size)
+    {
+        // A full batch is requested without waiting for the end of the window
+        m_work_offloader->Enqueue(std::make_unique<RejitWorkItem>(std::move(action)));
+        return;
+    }
+
+    if (m_pending_rejit_flush_enqueued)
+    {
+        return;
+    }
+
+    m_pending_rejit_flush_enqueued = true;
+
+    // Enqueue the flush at the end of the window: the offloader thread keeps running the other items until then
+    const auto deadline = std::chrono::steady_clock::now() + m_rejit_batch_window;
+    m_work_offloader->Enqueue(std::make_unique<RejitWorkItem>(std::move(action), deadline));
+}
+
+void RejitHandler::SetRejitBatching(std::chrono::milliseconds window, size_t maxSize)
+{
+    std::lock_guard<std::mutex> guard(m_pending_rejit_lock);
+    m_rejit_batch_window = window;
+    m_rejit_batch_max_size = maxSize;
 }
 
 void RejitHandler::Shutdown()
@@ -447,6 +551,7 @@ void RejitHandler::Shutdown()
     m_shutdown.store(true);
 
     m_modules.clear();
+    m_instrumentedMethods.Clear();
     m_profilerInfo = nullptr;
     m_profilerInfo10 = nullptr;
 }
@@ -2,6 +2,7 @@
 #define DD_CLR_PROFILER_REJIT_HANDLER_H_
 
 #include <atomic>
+#include <chrono>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
@@ -11,6 +12,7 @@
 
 #include "cor.h"
 #include "corprof.h"
+#include "instrumented_method_set.h"
 #include "module_metadata.h"
 #include "rejit_work_offloader.h"
 #include "method_rewriter.h"
@@ -132,6 +134,23 @@ private:
     std::mutex m_ngenInlinersModules_lock;
     std::vector<ModuleID> m_ngenInlinersModules;
 
+    // Copy of the methods of m_modules for the lock-free lookups of HasModuleAndMethod
+    InstrumentedMethodSet m_instrumentedMethods;
+
+    // Methods enqueued by EnqueueForRejit and not requested yet: every RequestReJIT suspends the runtime, so the
+    // batches enqueued within m_rejit_batch_window (or until m_rejit_batch_max_size methods) are requested together
+    // by a work item whose deadline is the end of the window.
+    std::mutex m_pending_rejit_lock;
+    std::vector<ModuleID> m_pending_rejit_modules;
+    std::vector<mdMethodDef> m_pending_rejit_methodDefs;
+    bool m_pending_rejit_flush_enqueued = false;
+    std::chrono::milliseconds m_rejit_batch_window = std::chrono::milliseconds(10);
+    size_t m_rejit_batch_max_size = 2000;
+
+    void FlushPendingRejit();
+    void AppendPendingRejit(std::vector<ModuleID>& modulesVector, std::vector<mdMethodDef>& modulesMethodDef);
+    void RequestRejitNow(std::vector<ModuleID>& modulesVector, std::vector<mdMethodDef>& modulesMethodDef);
+
 public:
     RejitHandler(ICorProfilerInfo7* pInfo, std::shared_ptr<RejitWorkOffloader> work_offloader);
     RejitHandler(ICorProfilerInfo10* pInfo, std::shared_ptr<RejitWorkOffloader> work_offloader);
@@ -141,9 +160,11 @@ public:
     void SetEnableCallTargetStateByRef(bool enableCallTargetStateByRef);
     bool GetEnableCallTargetStateByRef();
     bool GetEnableByRefInstrumentation();
+    void SetRejitBatching(std::chrono::milliseconds window, size_t maxSize);
 
     void RemoveModule(ModuleID moduleId);
     bool HasModuleAndMethod(ModuleID moduleId, mdMethodDef methodDef);
+    void AddInstrumentedMethod(ModuleID moduleId, mdMethodDef methodDef);
 
     void AddNGenInlinerModule(ModuleID moduleId);
 
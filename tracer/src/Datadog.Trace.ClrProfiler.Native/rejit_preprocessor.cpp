@@ -1,8 +1,11 @@
 #include "rejit_preprocessor.h"
+#include <algorithm>
+#include <unordered_map>
 #include "stats.h"
 #include "integration.h"
 #include "logger.h"
 #include "debugger_members.h"
+#include "rejit_work_offloader.h"
 
 namespace trace
 {
@@ -21,12 +24,20 @@ void RejitPreprocessor<RejitRequestDefinition>::ProcessTypeDefForRejit(const Rej
                                           ComPtr<IMetaDataEmit2>& metadataEmit,
                                           ComPtr<IMetaDataAssemblyImport>& assemblyImport,
                                           ComPtr<IMetaDataAssemblyEmit>& assemblyEmit, const ModuleInfo& moduleInfo,
-                                          const mdTypeDef typeDef, std::vector<ModuleID>& vtModules,
-                                          std::vector<mdMethodDef>& vtMethodDefs)
+                                          const mdTypeDef typeDef, SignatureMatcher& signatureMatcher,
+                                          std::vector<ModuleID>& vtModules, std::vector<mdMethodDef>& vtMethodDefs)
 {
     auto target_method = GetTargetMethod(definition);
     const bool wildcard_enabled = target_method.method_name == tracemethodintegration_wildcardmethodname;
 
+    // The expected argument types are compiled once per module, the names are only compared as a fallback
+    const auto is_exact_signature_match = GetIsExactSignatureMatch(definition);
+    const SignatureMatcher::CompiledSignature* compiledSignature = nullptr;
+    if (is_exact_signature_match)
+    {
+        compiledSignature = &signatureMatcher.Compile(GetTargetMethod(definition).signature_types);
+    }
+
     Logger::Debug("  Looking for '", target_method.type.name, ".", target_method.method_name,
                   "(", (target_method.signature_types.size() - 1), " params)' method implementation.");
 
@@ -87,7 +98,6 @@ void RejitPreprocessor<RejitRequestDefinition>::ProcessTypeDefForRejit(const Rej
             }
         }
 
-        auto is_exact_signature_match = GetIsExactSignatureMatch(definition);
         if (is_exact_signature_match)
         {
             // Compare if the current mdMethodDef contains the same number of arguments as the
@@ -99,12 +109,28 @@ void RejitPreprocessor<RejitRequestDefinition>::ProcessTypeDefForRejit(const Rej
                 continue;
             }
 
-            // Compare each mdMethodDef argument type to the instrumentation target
-            bool argumentsMismatch = false;
+            // Compare each mdMethodDef argument type to the compiled instrumentation target
             const auto& methodArguments = functionInfo.method_signature.GetMethodArguments();
+            auto signatureMatch = SignatureMatch::Match;
+            for (unsigned int i = 0; i < numOfArgs && signatureMatch == SignatureMatch::Match; i++)
+            {
+                PCCOR_SIGNATURE argumentSignature = nullptr;
+                methodArguments[i].GetSignature(argumentSignature);
+                signatureMatch = signatureMatcher.MatchArgument(*compiledSignature, i, argumentSignature);
+            }
+
+            if (signatureMatch == SignatureMatch::Mismatch)
+            {
+                Logger::Debug("    * The caller for the methoddef: ", target_method.method_name,
+                            " doesn't have the right type of arguments.");
+                continue;
+            }
+
+            // Fallback for the element types that are not compiled: compare each argument type name
+            bool argumentsMismatch = false;
 
             Logger::Debug("    * Comparing signature for method: ", caller.type.name, ".", caller.name);
-            for (unsigned int i = 0; i < numOfArgs; i++)
+            for (unsigned int i = 0; i < numOfArgs && signatureMatch == SignatureMatch::Unknown; i++)
             {
                 const auto argumentTypeName = methodArguments[i].GetTypeTokName(metadataImport);
                 const auto integrationArgumentTypeName = target_method.signature_types[i + 1];
@@ -165,239 +191,265 @@ void RejitPreprocessor<RejitRequestDefinition>::ProcessTypeDefForRejit(const Rej
 }
 
 template <class RejitRequestDefinition>
-ULONG RejitPreprocessor<RejitRequestDefinition>::RequestRejitForLoadedModules(
-                                                        const std::vector<ModuleID>& modules,
-                                                        const std::vector<RejitRequestDefinition>& definitions,
-                                                        bool enqueueInSameThread)
+void RejitPreprocessor<RejitRequestDefinition>::FindDerivedTypeDefs(
+    const std::vector<RejitRequestDefinition>& definitions, const std::vector<size_t>& positions,
+    ComPtr<IMetaDataImport2>& metadataImport, ComPtr<IMetaDataAssemblyImport>& assemblyImport,
+    const ModuleInfo& moduleInfo, const AssemblyMetadata& assemblyMetadata,
+    std::unordered_map<size_t, std::vector<mdTypeDef>>& derivedTypeDefs)
 {
-    if (m_rejit_handler->IsShutdownRequested())
+    // Abstract methods handling: derived definitions by target type name
+    std::unordered_map<shared::WSTRING, std::vector<size_t>> targetTypes;
+    for (const auto position : positions)
     {
-        return 0;
+        const auto& definition = definitions[position];
+        if (GetIsDerived(definition))
+        {
+            targetTypes[GetTargetMethod(definition).type.name].push_back(position);
+        }
     }
 
-    auto corProfilerInfo = m_rejit_handler->GetCorProfilerInfo();
-
-    std::vector<ModuleID> vtModules;
-    std::vector<mdMethodDef> vtMethodDefs;
+    if (targetTypes.empty())
+    {
+        return;
+    }
 
-    // Preallocate with size => 15 due this is the current max of method interceptions in a single module
-    // (see InstrumentationDefinitions.Generated.cs)
-    vtModules.reserve(15);
-    vtMethodDefs.reserve(15);
+    // Most of the types share a few base types: their TypeInfo is only resolved once per module scan
+    std::unordered_map<mdToken, std::shared_ptr<TypeInfo>> baseTypes;
 
-    for (const auto& module : modules)
+    // Enumerate the types of the module in search of types implementing the integrations
+    auto typeDefEnum = EnumTypeDefs(metadataImport);
+    auto typeDefIterator = typeDefEnum.begin();
+    for (; typeDefIterator != typeDefEnum.end(); typeDefIterator = ++typeDefIterator)
     {
-        auto _ = trace::Stats::Instance()->CallTargetRequestRejitMeasure();
-        const ModuleInfo& moduleInfo = GetModuleInfo(corProfilerInfo, module);
-        Logger::Debug("Requesting Rejit for Module: ", moduleInfo.assembly.name);
-
-        ComPtr<IUnknown> metadataInterfaces;
-        ComPtr<IMetaDataImport2> metadataImport;
-        ComPtr<IMetaDataEmit2> metadataEmit;
-        ComPtr<IMetaDataAssemblyImport> assemblyImport;
-        ComPtr<IMetaDataAssemblyEmit> assemblyEmit;
-        std::unique_ptr<AssemblyMetadata> assemblyMetadata = nullptr;
-
-        for (const RejitRequestDefinition& definition : definitions)
+        auto typeDef = *typeDefIterator;
+
+        // Only the direct ancestor of the type is checked
+        mdToken typeExtends = mdTokenNil;
+        auto hr = metadataImport->GetTypeDefProps(typeDef, nullptr, 0, nullptr, nullptr, &typeExtends);
+        if (FAILED(hr) || typeExtends == mdTokenNil)
         {
-            const auto target_method = GetTargetMethod(definition);
-            const auto is_derived = GetIsDerived(definition);
+            continue;
+        }
 
-            if (is_derived)
+        auto& ancestorTypeInfo = baseTypes[typeExtends];
+        if (ancestorTypeInfo == nullptr)
+        {
+            ancestorTypeInfo = std::make_shared<TypeInfo>(GetTypeInfo(metadataImport, typeExtends));
+        }
+
+        const auto targetType = targetTypes.find(ancestorTypeInfo->name);
+        if (targetType == targetTypes.end())
+        {
+            continue;
+        }
+
+        for (const auto position : targetType->second)
+        {
+            const auto& target_method = GetTargetMethod(definitions[position]);
+            bool rewriteType = false;
+
+            // Validate assembly data (scopeToken has the assemblyRef of the ancestor type)
+            if (ancestorTypeInfo->scopeToken != mdTokenNil)
             {
-                // Abstract methods handling.
-                if (assemblyMetadata == nullptr)
-                {
-                    Logger::Debug("  Loading Assembly Metadata...");
-                    auto hr = corProfilerInfo->GetModuleMetaData(moduleInfo.id, ofRead | ofWrite, IID_IMetaDataImport2,
-                                                                metadataInterfaces.GetAddressOf());
-                    if (FAILED(hr))
-                    {
-                        Logger::Warn("CallTarget_RequestRejitForModule failed to get metadata interface for ",
-                                     moduleInfo.id, " ", moduleInfo.assembly.name);
-                        break;
-                    }
-
-                    metadataImport = metadataInterfaces.As<IMetaDataImport2>(IID_IMetaDataImport);
-                    metadataEmit = metadataInterfaces.As<IMetaDataEmit2>(IID_IMetaDataEmit);
-                    assemblyImport = metadataInterfaces.As<IMetaDataAssemblyImport>(IID_IMetaDataAssemblyImport);
-                    assemblyEmit = metadataInterfaces.As<IMetaDataAssemblyEmit>(IID_IMetaDataAssemblyEmit);
-                    assemblyMetadata = std::make_unique<AssemblyMetadata>(GetAssemblyImportMetadata(assemblyImport));
-                    Logger::Debug("  Assembly Metadata loaded for: ", assemblyMetadata->name, "(",
-                                  assemblyMetadata->version.str(), ").");
-                }
+                const auto tokenType = TypeFromToken(ancestorTypeInfo->scopeToken);
 
-                // If the integration is in a different assembly than the target method
-                if (assemblyMetadata->name != target_method.type.assembly.name)
+                if (tokenType == mdtAssemblyRef)
                 {
-                    // Check if the current module contains a reference to the assembly of the integration
-                    auto assemblyRefEnum = EnumAssemblyRefs(assemblyImport);
-                    auto assemblyRefIterator = assemblyRefEnum.begin();
-                    bool assemblyRefFound = false;
-                    for (; assemblyRefIterator != assemblyRefEnum.end(); assemblyRefIterator = ++assemblyRefIterator)
-                    {
-                        auto assemblyRef = *assemblyRefIterator;
-                        const auto& assemblyRefMetadata = GetReferencedAssemblyMetadata(assemblyImport, assemblyRef);
-
-                        if (assemblyRefMetadata.name == target_method.type.assembly.name &&
-                            target_method.type.min_version <= assemblyRefMetadata.version &&
-                            target_method.type.max_version >= assemblyRefMetadata.version)
-                        {
-                            assemblyRefFound = true;
-                            break;
-                        }
-                    }
-
-                    // If the assembly reference was not found we skip the integration
-                    if (!assemblyRefFound)
-                    {
-                        continue;
-                    }
-                }
+                    const auto& ancestorAssemblyMetadata =
+                        GetReferencedAssemblyMetadata(assemblyImport, ancestorTypeInfo->scopeToken);
 
-                // Enumerate the types of the module in search of types implementing the integration
-                auto typeDefEnum = EnumTypeDefs(metadataImport);
-                auto typeDefIterator = typeDefEnum.begin();
-                for (; typeDefIterator != typeDefEnum.end(); typeDefIterator = ++typeDefIterator)
+                    // We check the assembly name and version
+                    rewriteType = ancestorAssemblyMetadata.name == target_method.type.assembly.name &&
+                                  target_method.type.min_version <= ancestorAssemblyMetadata.version &&
+                                  target_method.type.max_version >= ancestorAssemblyMetadata.version;
+                }
+                else
                 {
-                    auto typeDef = *typeDefIterator;
-                    const auto typeInfo = GetTypeInfo(metadataImport, typeDef);
-                    bool rewriteType = false;
-                    auto ancestorTypeInfo = typeInfo.extend_from.get();
-
-                    // Check if the type has ancestors
-                    int maxDepth = 1;
-                    while (ancestorTypeInfo != nullptr && maxDepth > 0)
-                    {
-                        // Validate the type name we already have
-                        if (ancestorTypeInfo->name == target_method.type.name)
-                        {
-                            // Validate assembly data (scopeToken has the assemblyRef of the ancestor type)
-                            if (ancestorTypeInfo->scopeToken != mdTokenNil)
-                            {
-                                const auto tokenType = TypeFromToken(ancestorTypeInfo->scopeToken);
-
-                                if (tokenType == mdtAssemblyRef)
-                                {
-                                    const auto& ancestorAssemblyMetadata =
-                                        GetReferencedAssemblyMetadata(assemblyImport, ancestorTypeInfo->scopeToken);
-
-                                    // We check the assembly name and version
-                                    if (ancestorAssemblyMetadata.name == target_method.type.assembly.name &&
-                                        target_method.type.min_version <=
-                                            ancestorAssemblyMetadata.version &&
-                                        target_method.type.max_version >= ancestorAssemblyMetadata.version)
-                                    {
-                                        rewriteType = true;
-                                        break;
-                                    }
-                                }
-                                else
-                                {
-                                    Logger::Warn("Unknown token type (Not supported)");
-                                }
-                            }
-                            else
-                            {
-                                // Check module name and version
-                                if (moduleInfo.assembly.name == target_method.type.assembly.name &&
-                                    target_method.type.min_version <= assemblyMetadata->version &&
-                                    target_method.type.max_version >= assemblyMetadata->version)
-                                {
-                                    rewriteType = true;
-                                    break;
-                                }
-                            }
-                        }
-
-                        // Go up
-                        ancestorTypeInfo = ancestorTypeInfo->extend_from.get();
-                        if (ancestorTypeInfo != nullptr)
-                        {
-                            if (ancestorTypeInfo->name == WStr("System.ValueType") ||
-                                ancestorTypeInfo->name == WStr("System.Object") ||
-                                ancestorTypeInfo->name == WStr("System.Enum"))
-                            {
-                                ancestorTypeInfo = nullptr;
-                            }
-                        }
-
-                        maxDepth--;
-                    }
-
-                    if (rewriteType)
-                    {
-                        //
-                        // Looking for the method to rewrite
-                        //
-                        ProcessTypeDefForRejit(definition, metadataImport, metadataEmit, assemblyImport, assemblyEmit,
-                                               moduleInfo, typeDef, vtModules, vtMethodDefs);
-                    }
+                    Logger::Warn("Unknown token type (Not supported)");
                 }
             }
             else
             {
-                // If the integration is not for the current assembly we skip.
-                if (target_method.type.assembly.name != tracemethodintegration_assemblyname &&
-                    target_method.type.assembly.name != moduleInfo.assembly.name)
-                {
-                    continue;
-                }
+                // Check module name and version
+                rewriteType = moduleInfo.assembly.name == target_method.type.assembly.name &&
+                              target_method.type.min_version <= assemblyMetadata.version &&
+                              target_method.type.max_version >= assemblyMetadata.version;
+            }
 
-                if (assemblyMetadata == nullptr)
-                {
-                    Logger::Debug("  Loading Assembly Metadata...");
-                    auto hr = corProfilerInfo->GetModuleMetaData(moduleInfo.id, ofRead | ofWrite, IID_IMetaDataImport2,
-                                                                metadataInterfaces.GetAddressOf());
-                    if (FAILED(hr))
-                    {
-                        Logger::Warn("CallTarget_RequestRejitForModule failed to get metadata interface for ",
-                                     moduleInfo.id, " ", moduleInfo.assembly.name);
-                        break;
-                    }
-
-                    metadataImport = metadataInterfaces.As<IMetaDataImport2>(IID_IMetaDataImport);
-                    metadataEmit = metadataInterfaces.As<IMetaDataEmit2>(IID_IMetaDataEmit);
-                    assemblyImport = metadataInterfaces.As<IMetaDataAssemblyImport>(IID_IMetaDataAssemblyImport);
-                    assemblyEmit = metadataInterfaces.As<IMetaDataAssemblyEmit>(IID_IMetaDataAssemblyEmit);
-                    assemblyMetadata = std::make_unique<AssemblyMetadata>(GetAssemblyImportMetadata(assemblyImport));
-                    Logger::Debug("  Assembly Metadata loaded for: ", assemblyMetadata->name, "(",
-                                  assemblyMetadata->version.str(), ").");
-                }
+            if (rewriteType)
+            {
+                derivedTypeDefs[position].push_back(typeDef);
+            }
+        }
+    }
+}
 
-                // Check min version
-                if (target_method.type.min_version > assemblyMetadata->version)
-                {
-                    continue;
-                }
+template <class RejitRequestDefinition>
+void RejitPreprocessor<RejitRequestDefinition>::IndexDefinitions(const std::vector<RejitRequestDefinition>& definitions,
+                                                                 RejitDefinitionIndex& index)
+{
+    // Only the definitions added since the last call are indexed
+    for (auto position = index.Size(); position < definitions.size(); position++)
+    {
+        const auto& definition = definitions[position];
+        const auto& target_method = GetTargetMethod(definition);
+        index.Add(target_method.type.assembly.name, target_method.type.min_version, target_method.type.max_version,
+                  GetIsDerived(definition));
+    }
+}
 
-                // Check max version
-                if (target_method.type.max_version < assemblyMetadata->version)
-                {
-                    continue;
-                }
+template <class RejitRequestDefinition>
+ULONG RejitPreprocessor<RejitRequestDefinition>::RequestRejitForLoadedModules(
+                                                        const std::vector<ModuleID>& modules,
+                                                        const std::vector<RejitRequestDefinition>& definitions,
+                                                        bool enqueueInSameThread)
+{
+    RejitDefinitionIndex index;
+    IndexDefinitions(definitions, index);
 
-                // We are in the right module, so we try to load the mdTypeDef from the integration target type name.
-                mdTypeDef typeDef = mdTypeDefNil;
-                auto foundType = FindTypeDefByName(target_method.type.name, moduleInfo.assembly.name,
-                                                   metadataImport, typeDef);
-                if (!foundType)
-                {
-                    continue;
-                }
+    return RequestRejitForLoadedModules(modules, definitions, index, enqueueInSameThread);
+}
+
+template <class RejitRequestDefinition>
+void RejitPreprocessor<RejitRequestDefinition>::ScanModuleForRejit(const ModuleID module,
+                                                                   const std::vector<RejitRequestDefinition>& definitions,
+                                                                   const RejitDefinitionIndex& index,
+                                                                   std::vector<ModuleID>& vtModules,
+                                                                   std::vector<mdMethodDef>& vtMethodDefs)
+{
+    auto _ = trace::Stats::Instance()->CallTargetRequestRejitMeasure();
+    auto corProfilerInfo = m_rejit_handler->GetCorProfilerInfo();
+    const ModuleInfo& moduleInfo = GetModuleInfo(corProfilerInfo, module);
+    Logger::Debug("Requesting Rejit for Module: ", moduleInfo.assembly.name);
+
+    if (!index.MayMatch(moduleInfo.assembly.name))
+    {
+        return;
+    }
+
+    Logger::Debug("  Loading Assembly Metadata...");
+    ComPtr<IUnknown> metadataInterfaces;
+    auto hr = corProfilerInfo->GetModuleMetaData(moduleInfo.id, ofRead | ofWrite, IID_IMetaDataImport2,
+                                                metadataInterfaces.GetAddressOf());
+    if (FAILED(hr))
+    {
+        Logger::Warn("CallTarget_RequestRejitForModule failed to get metadata interface for ", moduleInfo.id, " ",
+                     moduleInfo.assembly.name);
+        return;
+    }
+
+    auto metadataImport = metadataInterfaces.As<IMetaDataImport2>(IID_IMetaDataImport);
+    auto metadataEmit = metadataInterfaces.As<IMetaDataEmit2>(IID_IMetaDataEmit);
+    auto assemblyImport = metadataInterfaces.As<IMetaDataAssemblyImport>(IID_IMetaDataAssemblyImport);
+    auto assemblyEmit = metadataInterfaces.As<IMetaDataAssemblyEmit>(IID_IMetaDataAssemblyEmit);
+    const auto assemblyMetadata = GetAssemblyImportMetadata(assemblyImport);
+    Logger::Debug("  Assembly Metadata loaded for: ", assemblyMetadata.name, "(", assemblyMetadata.version.str(),
+                  ").");
+
+    // Only the definitions targeting this assembly version, or an assembly version it references
+    // in the case of derived types, are processed.
+    std::vector<size_t> positions;
+    index.GetDefinitions(moduleInfo.assembly.name, assemblyMetadata.version, positions);
+
+    if (index.HasDerivedDefinitions())
+    {
+        index.GetDerivedDefinitions(moduleInfo.assembly.name, assemblyMetadata.version, positions);
+
+        auto assemblyRefEnum = EnumAssemblyRefs(assemblyImport);
+        auto assemblyRefIterator = assemblyRefEnum.begin();
+        for (; assemblyRefIterator != assemblyRefEnum.end(); assemblyRefIterator = ++assemblyRefIterator)
+        {
+            const auto& assemblyRefMetadata = GetReferencedAssemblyMetadata(assemblyImport, *assemblyRefIterator);
+            index.GetDerivedDefinitions(assemblyRefMetadata.name, assemblyRefMetadata.version, positions);
+        }
+    }
+
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+    // Types implementing the derived definitions are searched in a single pass over the TypeDefs of the module
+    std::unordered_map<size_t, std::vector<mdTypeDef>> derivedTypeDefs;
+    FindDerivedTypeDefs(definitions, positions, metadataImport, assemblyImport, moduleInfo, assemblyMetadata,
+                        derivedTypeDefs);
+
+    SignatureMatcher signatureMatcher(
+        [&metadataImport](mdToken token) { return GetTypeInfo(metadataImport, token).name; });
+
+    for (const auto position : positions)
+    {
+        const RejitRequestDefinition& definition = definitions[position];
+        const auto& target_method = GetTargetMethod(definition);
+        const auto is_derived = GetIsDerived(definition);
+
+        if (is_derived)
+        {
+            const auto typeDefs = derivedTypeDefs.find(position);
+            if (typeDefs == derivedTypeDefs.end())
+            {
+                continue;
+            }
 
+            for (const auto typeDef : typeDefs->second)
+            {
                 //
                 // Looking for the method to rewrite
                 //
                 ProcessTypeDefForRejit(definition, metadataImport, metadataEmit, assemblyImport, assemblyEmit,
-                                       moduleInfo, typeDef, vtModules, vtMethodDefs);
+                                       moduleInfo, typeDef, signatureMatcher, vtModules, vtMethodDefs);
             }
         }
+        else
+        {
+            // The assembly name and version have already been checked by the index.
+            // We are in the right module, so we try to load the mdTypeDef from the integration target type name.
+            mdTypeDef typeDef = mdTypeDefNil;
+            auto foundType = FindTypeDefByName(target_method.type.name, moduleInfo.assembly.name,
+                                               metadataImport, typeDef);
+            if (!foundType)
+            {
+                continue;
+            }
+
+            //
+            // Looking for the method to rewrite
+            //
+            ProcessTypeDefForRejit(definition, metadataImport, metadataEmit, assemblyImport, assemblyEmit,
+                                   moduleInfo, typeDef, signatureMatcher, vtModules, vtMethodDefs);
+        }
+    }
+}
+
+template <class RejitRequestDefinition>
+ULONG RejitPreprocessor<RejitRequestDefinition>::RequestRejitForLoadedModules(
+                                                        const std::vector<ModuleID>& modules,
+                                                        const std::vector<RejitRequestDefinition>& definitions,
+                                                        const RejitDefinitionIndex& index,
+                                                        bool enqueueInSameThread)
+{
+    if (m_rejit_handler->IsShutdownRequested())
+    {
+        return 0;
     }
 
+    std::vector<ModuleID> vtModules;
+    std::vector<mdMethodDef> vtMethodDefs;
+
+    // Preallocate with size => 15 due this is the current max of method interceptions in a single module
+    // (see InstrumentationDefinitions.Generated.cs)
+    vtModules.reserve(15);
+    vtMethodDefs.reserve(15);
+
+    m_work_offloader->ScanModules(
+        modules,
+        [this, &definitions, &index](ModuleID module, std::vector<ModuleID>& moduleIds,
+                                     std::vector<mdMethodDef>& methodDefs) {
+            ScanModuleForRejit(module, definitions, index, moduleIds, methodDefs);
+        },
+        vtModules, vtMethodDefs);
+
     const auto rejitCount = (ULONG) vtMethodDefs.size();
 
-    // Request the ReJIT for all integrations found in the module.
+    // Request the ReJIT for all integrations found in the modules in a single batch.
     if (rejitCount > 0)
     {
         if (enqueueInSameThread)
@@ -3,9 +3,12 @@
 
 #include "integration.h"
 #include <future>
+#include <unordered_map>
 #include "cor.h"
 #include "corprof.h"
 #include "module_metadata.h"
+#include "rejit_definition_index.h"
+#include "signature_matcher.h"
 
 namespace trace
 {
@@ -25,8 +28,18 @@ private:
     void ProcessTypeDefForRejit(const RejitRequestDefinition& definition, ComPtr<IMetaDataImport2>& metadataImport,
                            ComPtr<IMetaDataEmit2>& metadataEmit, ComPtr<IMetaDataAssemblyImport>& assemblyImport,
                            ComPtr<IMetaDataAssemblyEmit>& assemblyEmit, const ModuleInfo& moduleInfo,
-                           const mdTypeDef typeDef, std::vector<ModuleID>& vtModules,
-                           std::vector<mdMethodDef>& vtMethodDefs);
+                           const mdTypeDef typeDef, SignatureMatcher& signatureMatcher,
+                           std::vector<ModuleID>& vtModules, std::vector<mdMethodDef>& vtMethodDefs);
+
+    void FindDerivedTypeDefs(const std::vector<RejitRequestDefinition>& definitions,
+                             const std::vector<size_t>& positions, ComPtr<IMetaDataImport2>& metadataImport,
+                             ComPtr<IMetaDataAssemblyImport>& assemblyImport, const ModuleInfo& moduleInfo,
+                             const AssemblyMetadata& assemblyMetadata,
+                             std::unordered_map<size_t, std::vector<mdTypeDef>>& derivedTypeDefs);
+
+    void ScanModuleForRejit(const ModuleID module, const std::vector<RejitRequestDefinition>& definitions,
+                            const RejitDefinitionIndex& index, std::vector<ModuleID>& vtModules,
+                            std::vector<mdMethodDef>& vtMethodDefs);
 
 protected:
     std::shared_ptr<RejitHandler> m_rejit_handler = nullptr;
@@ -43,8 +56,16 @@ protected:
 public:
     RejitPreprocessor(std::shared_ptr<RejitHandler> rejit_handler, std::shared_ptr<RejitWorkOffloader> work_offloader);
 
+    // Add the definitions that are not indexed yet (i.e. the ones appended to the vector since the last call)
+    void IndexDefinitions(const std::vector<RejitRequestDefinition>& definitions, RejitDefinitionIndex& index);
+
+    ULONG RequestRejitForLoadedModules(const std::vector<ModuleID>& modules,
+                                       const std::vector<RejitRequestDefinition>& requests,
+                                       bool enqueueInSameThread = false);
+
     ULONG RequestRejitForLoadedModules(const std::vector<ModuleID>& modules,
                                        const std::vector<RejitRequestDefinition>& requests,
+                                       const RejitDefinitionIndex& index,
                                        bool enqueueInSameThread = false);
 
     void EnqueueRequestRejitForLoadedModules(const std::vector<ModuleID>& modulesVector,
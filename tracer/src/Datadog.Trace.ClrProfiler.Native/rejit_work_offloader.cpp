@@ -1,6 +1,8 @@
 #include "rejit_work_offloader.h"
 #include "logger.h"
 
+#include <algorithm>
+
 namespace trace
 {
 
@@ -17,6 +19,11 @@ RejitWorkItem::RejitWorkItem(std::function<void()>&& func) :
 {
 }
 
+RejitWorkItem::RejitWorkItem(std::function<void()>&& func, std::chrono::steady_clock::time_point deadline) :
+    terminating(false), func(std::forward<std::function<void()>>(func)), deadline(deadline)
+{
+}
+
 std::unique_ptr<RejitWorkItem> RejitWorkItem::CreateTerminatingWorkItem()
 {
     return std::make_unique<RejitWorkItem>();
@@ -26,10 +33,29 @@ std::unique_ptr<RejitWorkItem> RejitWorkItem::CreateTerminatingWorkItem()
 // RejitWorkOffloader
 //
 
-RejitWorkOffloader::RejitWorkOffloader(ICorProfilerInfo7* pInfo)
+static size_t GetDefaultScanningThreadsCount()
+{
+    // keep at least one core for the application while it is starting
+    const size_t cores = std::thread::hardware_concurrency();
+    if (cores <= 2)
+    {
+        return 0;
+    }
+
+    return std::min(cores - 1, RejitWorkOffloader::MaxScanningThreads);
+}
+
+RejitWorkOffloader::RejitWorkOffloader(ICorProfilerInfo7* pInfo) :
+    RejitWorkOffloader(pInfo, GetDefaultScanningThreadsCount())
+{
+}
+
+RejitWorkOffloader::RejitWorkOffloader(ICorProfilerInfo7* pInfo, size_t scanningThreadsCount)
 {
     m_profilerInfo = pInfo;
+    m_scanning_threads_count = std::min(scanningThreadsCount, MaxScanningThreads);
     m_offloader_queue = std::make_unique<shared::UniqueBlockingQueue<RejitWorkItem>>();
+    m_scanning_queue = std::make_unique<shared::UniqueBlockingQueue<RejitWorkItem>>();
     m_offloader_queue_thread = std::make_unique<std::thread>(EnqueueThreadLoop, this);
 }
 
@@ -43,38 +69,236 @@ bool RejitWorkOffloader::WaitForTermination()
     if (m_offloader_queue_thread->joinable())
     {
         m_offloader_queue_thread->join();
+        StopScanningThreads();
         return true;
     }
 
+    StopScanningThreads();
     return false;
 }
 
-void RejitWorkOffloader::EnqueueThreadLoop(RejitWorkOffloader* offloader)
+size_t RejitWorkOffloader::GetScanningThreadsCount() const
 {
-    auto queue = offloader->m_offloader_queue.get();
-    auto profilerInfo = offloader->m_profilerInfo;
+    return m_scanning_threads_count;
+}
+
+void RejitWorkOffloader::RunOnScanningThreads(std::vector<std::function<void()>>& funcs)
+{
+    std::mutex remainingLock;
+    std::condition_variable remainingCondition;
+    size_t remaining = funcs.size();
+    bool runInline = true;
+
+    {
+        std::lock_guard<std::mutex> guard(m_scanning_threads_lock);
+        if (!m_scanning_threads_stopped && m_scanning_threads_count > 0 && m_scanning_threads.empty())
+        {
+            Logger::Info("Starting ", m_scanning_threads_count, " ReJIT scanning threads.");
+            for (size_t i = 0; i < m_scanning_threads_count; i++)
+            {
+                m_scanning_threads.emplace_back(ScanningThreadLoop, this);
+            }
+        }
+
+        if (!m_scanning_threads.empty() && !m_scanning_threads_stopped)
+        {
+            runInline = false;
+
+            // the items are pushed under the lock: StopScanningThreads enqueues the terminating items after them,
+            // so the scanning threads always run them before exiting
+            for (auto& func : funcs)
+            {
+                std::function<void()> action = [&func, &remainingLock, &remainingCondition, &remaining]() {
+                    func();
+
+                    std::lock_guard<std::mutex> guard(remainingLock);
+                    remaining--;
+                    if (remaining == 0)
+                    {
+                        remainingCondition.notify_one();
+                    }
+                };
+
+                m_scanning_queue->push(std::make_unique<RejitWorkItem>(std::move(action)));
+            }
+        }
+    }
+
+    if (runInline)
+    {
+        for (auto& func : funcs)
+        {
+            func();
+        }
+
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(remainingLock);
+    remainingCondition.wait(lock, [&remaining]() { return remaining == 0; });
+}
+
+void RejitWorkOffloader::ScanModules(
+    const std::vector<ModuleID>& modules,
+    const std::function<void(ModuleID, std::vector<ModuleID>&, std::vector<mdMethodDef>&)>& scan,
+    std::vector<ModuleID>& vtModules, std::vector<mdMethodDef>& vtMethodDefs)
+{
+    if (modules.size() < MinModulesForParallelScan || m_scanning_threads_count < 2)
+    {
+        for (const auto& module : modules)
+        {
+            scan(module, vtModules, vtMethodDefs);
+        }
+
+        return;
+    }
+
+    // Scanning the metadata is independent for each module: the modules are split in contiguous chunks scanned
+    // by the scanning threads, and the results are concatenated in the chunks order so the ReJIT requests are the
+    // same as with a sequential scan.
+    const auto chunksCount = std::min(modules.size(), m_scanning_threads_count * 2);
+    const auto chunkSize = (modules.size() + chunksCount - 1) / chunksCount;
+
+    std::vector<std::vector<ModuleID>> chunksModules(chunksCount);
+    std::vector<std::vector<mdMethodDef>> chunksMethodDefs(chunksCount);
+    std::vector<std::function<void()>> scans;
+    scans.reserve(chunksCount);
+
+    for (size_t chunk = 0; chunk < chunksCount; chunk++)
+    {
+        const auto first = chunk * chunkSize;
+        const auto last = std::min(first + chunkSize, modules.size());
+        if (first >= last)
+        {
+            break;
+        }
+
+        auto& chunkModules = chunksModules[chunk];
+        auto& chunkMethodDefs = chunksMethodDefs[chunk];
+        scans.push_back([&modules, &scan, &chunkModules, &chunkMethodDefs, first, last]() {
+            for (auto i = first; i < last; i++)
+            {
+                scan(modules[i], chunkModules, chunkMethodDefs);
+            }
+        });
+    }
+
+    Logger::Debug("Scanning ", modules.size(), " modules for ReJIT on ", m_scanning_threads_count, " threads.");
+    RunOnScanningThreads(scans);
+
+    for (size_t chunk = 0; chunk < chunksCount; chunk++)
+    {
+        vtModules.insert(vtModules.end(), chunksModules[chunk].begin(), chunksModules[chunk].end());
+        vtMethodDefs.insert(vtMethodDefs.end(), chunksMethodDefs[chunk].begin(), chunksMethodDefs[chunk].end());
+    }
+}
+
+void RejitWorkOffloader::StopScanningThreads()
+{
+    std::lock_guard<std::mutex> guard(m_scanning_threads_lock);
+    m_scanning_threads_stopped = true;
+
+    for (size_t i = 0; i < m_scanning_threads.size(); i++)
+    {
+        m_scanning_queue->push(RejitWorkItem::CreateTerminatingWorkItem());
+    }
+
+    for (auto& thread : m_scanning_threads)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+
+    m_scanning_threads.clear();
+}
+
+void RejitWorkOffloader::InitializeCurrentThread(ICorProfilerInfo7* profilerInfo)
+{
+    if (profilerInfo == nullptr)
+    {
+        return;
+    }
 
-    Logger::Info("Initializing ReJIT request thread.");
     HRESULT hr = profilerInfo->InitializeCurrentThread();
     if (FAILED(hr))
     {
         Logger::Warn("Call to InitializeCurrentThread fail.");
     }
+}
+
+void RejitWorkOffloader::ScanningThreadLoop(RejitWorkOffloader* offloader)
+{
+    auto queue = offloader->m_scanning_queue.get();
+    InitializeCurrentThread(offloader->m_profilerInfo);
 
     while (true)
     {
         const auto item = queue->pop();
 
         if (item->terminating)
+        {
+            break;
+        }
+        else if (item->func != nullptr)
+        {
+            item->func();
+        }
+    }
+}
+
+void RejitWorkOffloader::EnqueueThreadLoop(RejitWorkOffloader* offloader)
+{
+    auto queue = offloader->m_offloader_queue.get();
+
+    // Items waiting for their deadline, sorted by deadline
+    std::vector<std::unique_ptr<RejitWorkItem>> delayedItems;
+
+    Logger::Info("Initializing ReJIT request thread.");
+    InitializeCurrentThread(offloader->m_profilerInfo);
+
+    while (true)
+    {
+        while (!delayedItems.empty() && delayedItems.front()->deadline <= std::chrono::steady_clock::now())
+        {
+            const auto delayedItem = std::move(delayedItems.front());
+            delayedItems.erase(delayedItems.begin());
+            delayedItem->func();
+        }
+
+        auto item = delayedItems.empty() ? queue->pop() : queue->pop_until(delayedItems.front()->deadline);
+
+        if (item == nullptr)
+        {
+            // a deadline is reached
+            continue;
+        }
+        else if (item->terminating)
         {
             // *************************************
             // Exit ReJIT thread
             // *************************************
 
+            // the work enqueued before the termination is not dropped
+            for (const auto& delayedItem : delayedItems)
+            {
+                delayedItem->func();
+            }
+
             break;
         }
         else if (item->func != nullptr)
         {
+            if (item->deadline > std::chrono::steady_clock::now())
+            {
+                const auto position =
+                    std::upper_bound(delayedItems.begin(), delayedItems.end(), item->deadline,
+                                     [](const auto& deadline, const auto& other) { return deadline < other->deadline; });
+                delayedItems.insert(position, std::move(item));
+                continue;
+            }
+
             // *************************************
             // Execute given work
             // *************************************
@@ -85,4 +309,4 @@ void RejitWorkOffloader::EnqueueThreadLoop(RejitWorkOffloader* offloader)
     Logger::Info("Exiting ReJIT request thread.");
 }
 
-} // namespace trace
\ No newline at end of file
+} // namespace trace
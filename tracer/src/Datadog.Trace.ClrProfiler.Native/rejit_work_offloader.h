@@ -2,6 +2,8 @@
 #define DD_CLR_PROFILER_REJIT_WORK_OFFLOADER_H_
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <future>
 #include <mutex>
 #include <shared_mutex>
@@ -21,10 +23,15 @@ struct RejitWorkItem
     const bool terminating = false;
     const std::function<void()> func = nullptr;
 
+    // The offloader thread keeps running the other items until this time is reached
+    const std::chrono::steady_clock::time_point deadline = {};
+
     RejitWorkItem();
 
     RejitWorkItem(std::function<void()>&& func);
 
+    RejitWorkItem(std::function<void()>&& func, std::chrono::steady_clock::time_point deadline);
+
     static std::unique_ptr<RejitWorkItem> CreateTerminatingWorkItem();
 };
 
@@ -37,13 +44,45 @@ private:
     std::unique_ptr<shared::UniqueBlockingQueue<RejitWorkItem>> m_offloader_queue;
     std::unique_ptr<std::thread> m_offloader_queue_thread;
 
+    // Bounded pool used to scan the metadata of several modules in parallel (see RunOnScanningThreads).
+    // The threads are only created the first time they are needed.
+    std::mutex m_scanning_threads_lock;
+    bool m_scanning_threads_stopped = false;
+    size_t m_scanning_threads_count;
+    std::unique_ptr<shared::UniqueBlockingQueue<RejitWorkItem>> m_scanning_queue;
+    std::vector<std::thread> m_scanning_threads;
+
     static void EnqueueThreadLoop(RejitWorkOffloader* offloader);
+    static void ScanningThreadLoop(RejitWorkOffloader* offloader);
+    static void InitializeCurrentThread(ICorProfilerInfo7* profilerInfo);
+
+    void StopScanningThreads();
 
 public:
+    static const size_t MaxScanningThreads = 4;
+
+    // Below this number of modules the scan is done on the calling thread
+    static const size_t MinModulesForParallelScan = 8;
+
     RejitWorkOffloader(ICorProfilerInfo7* pInfo);
+    RejitWorkOffloader(ICorProfilerInfo7* pInfo, size_t scanningThreadsCount);
 
     void Enqueue(std::unique_ptr<RejitWorkItem>&& item);
     bool WaitForTermination();
+
+    size_t GetScanningThreadsCount() const;
+
+    // Run the given functions on the scanning threads and wait for all of them to complete. They must not share
+    // anything without synchronization and must not call RunOnScanningThreads themselves.
+    // The functions are run on the calling thread when there is no scanning thread.
+    void RunOnScanningThreads(std::vector<std::function<void()>>& funcs);
+
+    // Call scan for each module and append the methods it finds to vtModules and vtMethodDefs, in the order of the
+    // modules. The modules are split in contiguous chunks scanned on the scanning threads when there are enough of
+    // them, so the result is the same as with a sequential scan.
+    void ScanModules(const std::vector<ModuleID>& modules,
+                     const std::function<void(ModuleID, std::vector<ModuleID>&, std::vector<mdMethodDef>&)>& scan,
+                     std::vector<ModuleID>& vtModules, std::vector<mdMethodDef>& vtMethodDefs);
 };
 
 } // namespace trace
@@ -0,0 +1,341 @@
+#include "signature_matcher.h"
+
+#include <string>
+
+#include "clr_helpers.h"
+
+namespace trace
+{
+
+// Canonical form of a type: a sequence of operations, every named type is an OpName followed by its id
+static const ULONG OpName = 1;
+static const ULONG OpByRef = 2;
+static const ULONG OpSzArray = 3;
+static const ULONG OpGenericInst = 4;
+static const ULONG OpMVar = 5;
+static const ULONG OpVar = 6;
+
+static const auto WildcardTypeName = WStr("_");
+
+SignatureMatcher::SignatureMatcher(TypeNameResolver resolver) : m_resolver(std::move(resolver))
+{
+}
+
+ULONG SignatureMatcher::GetNameId(const shared::WSTRING& name)
+{
+    const auto id = static_cast<ULONG>(m_names.size());
+    return m_names.emplace(name, id).first->second;
+}
+
+ULONG SignatureMatcher::GetElementNameId(CorElementType elementType, const shared::WSTRING& name)
+{
+    // ids are stored + 1: 0 means the name of the element type is not interned yet
+    auto& id = m_elementNames[elementType];
+    if (id == 0)
+    {
+        id = GetNameId(name) + 1;
+    }
+
+    return id - 1;
+}
+
+ULONG SignatureMatcher::GetTokenNameId(mdToken token)
+{
+    const auto found = m_tokens.find(token);
+    if (found != m_tokens.end())
+    {
+        return found->second;
+    }
+
+    const auto id = GetNameId(m_resolver(token));
+    m_tokens.emplace(token, id);
+    return id;
+}
+
+// Inverse of GetSigTypeTokName: "T&", "T[]", "T[A,B]", "!!0", "!0" or a type name
+void SignatureMatcher::CompileType(const shared::WSTRING& name, std::vector<ULONG>& output)
+{
+    const auto length = name.size();
+
+    if (length > 1 && name[length - 1] == WStr('&'))
+    {
+        output.push_back(OpByRef);
+        CompileType(name.substr(0, length - 1), output);
+        return;
+    }
+
+    if (length > 2 && name[length - 2] == WStr('[') && name[length - 1] == WStr(']'))
+    {
+        output.push_back(OpSzArray);
+        CompileType(name.substr(0, length - 2), output);
+        return;
+    }
+
+    if (length > 2 && name[length - 1] == WStr(']'))
+    {
+        // search the '[' opening the generic arguments
+        size_t depth = 0;
+        size_t start = length - 1;
+        for (; start > 0; start--)
+        {
+            if (name[start] == WStr(']'))
+            {
+                depth++;
+            }
+            else if (name[start] == WStr('[') && --depth == 0)
+            {
+                break;
+            }
+        }
+
+        if (start > 0)
+        {
+            std::vector<shared::WSTRING> arguments;
+            size_t argumentStart = start + 1;
+            depth = 0;
+            for (size_t i = start + 1; i < length - 1; i++)
+            {
+                if (name[i] == WStr('['))
+                {
+                    depth++;
+                }
+                else if (name[i] == WStr(']'))
+                {
+                    depth--;
+                }
+                else if (name[i] == WStr(',') && depth == 0)
+                {
+                    arguments.push_back(name.substr(argumentStart, i - argumentStart));
+                    argumentStart = i + 1;
+                }
+            }
+            arguments.push_back(name.substr(argumentStart, length - 1 - argumentStart));
+
+            output.push_back(OpGenericInst);
+            CompileType(name.substr(0, start), output);
+            output.push_back(static_cast<ULONG>(arguments.size()));
+            for (const auto& argument : arguments)
+            {
+                CompileType(argument, output);
+            }
+            return;
+        }
+    }
+
+    if (length > 1 && name[0] == WStr('!'))
+    {
+        const bool isMethodVar = length > 2 && name[1] == WStr('!');
+        const auto number = shared::ToString(name.substr(isMethodVar ? 2 : 1));
+
+        // only the numbers written by GetSigTypeTokName, any other name is compared as a type name
+        if (!number.empty() && number.find_first_not_of("0123456789") == std::string::npos && number.size() < 10 &&
+            std::to_string(std::stoul(number)) == number)
+        {
+            output.push_back(isMethodVar ? OpMVar : OpVar);
+            output.push_back(static_cast<ULONG>(std::stoul(number)));
+            return;
+        }
+    }
+
+    output.push_back(OpName);
+    output.push_back(GetNameId(name));
+}
+
+// Same walk as GetSigTypeTokName
+bool SignatureMatcher::EncodeType(PCCOR_SIGNATURE& pbCur, std::vector<ULONG>& output)
+{
+    if (*pbCur == ELEMENT_TYPE_BYREF)
+    {
+        pbCur++;
+        output.push_back(OpByRef);
+    }
+
+    const auto elementType = static_cast<CorElementType>(*pbCur);
+    switch (elementType)
+    {
+        case ELEMENT_TYPE_BOOLEAN:
+            output.push_back(OpName);
+            output.push_back(GetElementNameId(elementType, SystemBoolean));
+            pbCur++;
+            break;
+        case ELEMENT_TYPE_CHAR:
+            output.push_back(OpName);
+            output.push_back(GetElementNameId(elementType, SystemChar));
+            pbCur++;
+            break;
+        case ELEMENT_TYPE_I1:
+            output.push_back(OpName);
+            output.push_back(GetElementNameId(elementType, SystemSByte));
+            pbCur++;
+            break;
+        case ELEMENT_TYPE_U1:
+            output.push_back(OpName);
+            output.push_back(GetElementNameId(elementType, SystemByte));
+            pbCur++;
+            break;
+        case ELEMENT_TYPE_U2:
+            output.push_back(OpName);
+            output.push_back(GetElementNameId(elementType, SystemUInt16));
+            pbCur++;
+            break;
+        case ELEMENT_TYPE_I2:
+            output.push_back(OpName);
+            output.push_back(GetElementNameId(elementType, SystemInt16));
+            pbCur++;
+            break;
+        case ELEMENT_TYPE_I4:
+            output.push_back(OpName);
+            output.push_back(GetElementNameId(elementType, SystemInt32));
+            pbCur++;
+            break;
+        case ELEMENT_TYPE_U4:
+            output.push_back(OpName);
+            output.push_back(GetElementNameId(elementType, SystemUInt32));
+            pbCur++;
+            break;
+        case ELEMENT_TYPE_I8:
+            output.push_back(OpName);
+            output.push_back(GetElementNameId(elementType, SystemInt64));
+            pbCur++;
+            break;
+        case ELEMENT_TYPE_U8:
+            output.push_back(OpName);
+            output.push_back(GetElementNameId(elementType, SystemUInt64));
+            pbCur++;
+            break;
+        case ELEMENT_TYPE_R4:
+            output.push_back(OpName);
+            output.push_back(GetElementNameId(elementType, SystemSingle));
+            pbCur++;
+            break;
+        case ELEMENT_TYPE_R8:
+            output.push_back(OpName);
+            output.push_back(GetElementNameId(elementType, SystemDouble));
+            pbCur++;
+            break;
+        case ELEMENT_TYPE_I:
+            output.push_back(OpName);
+            output.push_back(GetElementNameId(elementType, SystemIntPtr));
+            pbCur++;
+            break;
+        case ELEMENT_TYPE_U:
+            output.push_back(OpName);
+            output.push_back(GetElementNameId(elementType, SystemUIntPtr));
+            pbCur++;
+            break;
+        case ELEMENT_TYPE_STRING:
+            output.push_back(OpName);
+            output.push_back(GetElementNameId(elementType, SystemString));
+            pbCur++;
+            break;
+        case ELEMENT_TYPE_OBJECT:
+            output.push_back(OpName);
+            output.push_back(GetElementNameId(elementType, SystemObject));
+            pbCur++;
+            break;
+        case ELEMENT_TYPE_CLASS:
+        case ELEMENT_TYPE_VALUETYPE:
+        {
+            pbCur++;
+            mdToken token;
+            pbCur += CorSigUncompressToken(pbCur, &token);
+            output.push_back(OpName);
+            output.push_back(GetTokenNameId(token));
+            break;
+        }
+        case ELEMENT_TYPE_SZARRAY:
+        {
+            pbCur++;
+            output.push_back(OpSzArray);
+            return EncodeType(pbCur, output);
+        }
+        case ELEMENT_TYPE_GENERICINST:
+        {
+            pbCur++;
+            output.push_back(OpGenericInst);
+            if (!EncodeType(pbCur, output))
+            {
+                return false;
+            }
+
+            ULONG num = 0;
+            pbCur += CorSigUncompressData(pbCur, &num);
+            output.push_back(num);
+            for (ULONG i = 0; i < num; i++)
+            {
+                if (!EncodeType(pbCur, output))
+                {
+                    return false;
+                }
+            }
+            break;
+        }
+        case ELEMENT_TYPE_MVAR:
+        case ELEMENT_TYPE_VAR:
+        {
+            pbCur++;
+            ULONG num = 0;
+            pbCur += CorSigUncompressData(pbCur, &num);
+            output.push_back(elementType == ELEMENT_TYPE_MVAR ? OpMVar : OpVar);
+            output.push_back(num);
+            break;
+        }
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+const SignatureMatcher::CompiledSignature& SignatureMatcher::Compile(
+    const std::vector<shared::WSTRING>& signatureTypes)
+{
+    const auto found = m_signatures.find(&signatureTypes);
+    if (found != m_signatures.end())
+    {
+        return found->second;
+    }
+
+    CompiledSignature signature;
+    for (size_t i = 1; i < signatureTypes.size(); i++)
+    {
+        signature.arguments.emplace_back();
+        if (signatureTypes[i] != WildcardTypeName)
+        {
+            CompileType(signatureTypes[i], signature.arguments.back());
+        }
+    }
+
+    return m_signatures.emplace(&signatureTypes, std::move(signature)).first->second;
+}
+
+SignatureMatch SignatureMatcher::MatchArgument(const CompiledSignature& signature, size_t index,
+                                               PCCOR_SIGNATURE argument)
+{
+    if (index >= signature.arguments.size())
+    {
+        return SignatureMatch::Unknown;
+    }
+
+    const auto& expected = signature.arguments[index];
+    if (expected.empty())
+    {
+        return SignatureMatch::Match;
+    }
+
+    m_argument.clear();
+    PCCOR_SIGNATURE pbCur = argument;
+    if (!EncodeType(pbCur, m_argument))
+    {
+        return SignatureMatch::Unknown;
+    }
+
+    return m_argument == expected ? SignatureMatch::Match : SignatureMatch::Mismatch;
+}
+
+size_t SignatureMatcher::GetResolvedTokensCount() const
+{
+    return m_tokens.size();
+}
+
+} // namespace trace
@@ -0,0 +1,70 @@
+#ifndef DD_CLR_PROFILER_SIGNATURE_MATCHER_H_
+#define DD_CLR_PROFILER_SIGNATURE_MATCHER_H_
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "cor.h"
+#include "integration.h"
+
+namespace trace
+{
+
+enum class SignatureMatch
+{
+    Match,
+    Mismatch,
+    // The argument uses an element type that is not compiled: the type names must be compared instead
+    Unknown,
+};
+
+/// <summary>
+/// Matches the arguments of the methods of a module with the argument type names of the exact signature
+/// integrations, without building the type name of each argument.
+/// The expected type names of an integration are compiled once per module into a canonical form where every
+/// named type (primitive, TypeDef or TypeRef) is replaced by an id; the argument blobs are converted to the same
+/// form, resolving each TypeDef/TypeRef token name only once per module. Matching is then a comparison of the two
+/// forms, with the "_" arguments as wildcards. This gives the same result as comparing the names returned by
+/// TypeSignature::GetTypeTokName.
+/// </summary>
+class SignatureMatcher
+{
+public:
+    using TypeNameResolver = std::function<shared::WSTRING(mdToken)>;
+
+    struct CompiledSignature
+    {
+        // one entry per argument (the return type is not compared), empty for the wildcards
+        std::vector<std::vector<ULONG>> arguments;
+    };
+
+private:
+    TypeNameResolver m_resolver;
+    std::unordered_map<shared::WSTRING, ULONG> m_names;
+    std::unordered_map<mdToken, ULONG> m_tokens;
+    std::unordered_map<const std::vector<shared::WSTRING>*, CompiledSignature> m_signatures;
+    ULONG m_elementNames[ELEMENT_TYPE_OBJECT + 1] = {};
+    std::vector<ULONG> m_argument;
+
+    ULONG GetNameId(const shared::WSTRING& name);
+    ULONG GetElementNameId(CorElementType elementType, const shared::WSTRING& name);
+    ULONG GetTokenNameId(mdToken token);
+    void CompileType(const shared::WSTRING& name, std::vector<ULONG>& output);
+    bool EncodeType(PCCOR_SIGNATURE& pbCur, std::vector<ULONG>& output);
+
+public:
+    explicit SignatureMatcher(TypeNameResolver resolver);
+
+    // signatureTypes must outlive the matcher: the compiled signatures are cached by its address
+    const CompiledSignature& Compile(const std::vector<shared::WSTRING>& signatureTypes);
+
+    SignatureMatch MatchArgument(const CompiledSignature& signature, size_t index, PCCOR_SIGNATURE argument);
+
+    // Number of TypeDef/TypeRef names resolved through the metadata
+    size_t GetResolvedTokensCount() const;
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_SIGNATURE_MATCHER_H_
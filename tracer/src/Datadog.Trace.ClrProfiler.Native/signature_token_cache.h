@@ -0,0 +1,102 @@
+#ifndef DD_CLR_PROFILER_SIGNATURE_TOKEN_CACHE_H_
+#define DD_CLR_PROFILER_SIGNATURE_TOKEN_CACHE_H_
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "cor.h"
+#include "stats.h"
+
+namespace trace
+{
+
+/// <summary>
+/// Kind of the metadata tokens stored in the SignatureTokenCache.
+/// </summary>
+enum class SignatureTokenKind : char
+{
+    TypeSpec = 'T',
+    MemberRef = 'R',
+    MethodSpec = 'S',
+};
+
+/// <summary>
+/// Tokens defined in the metadata of a module by the calltarget rewriting, keyed by the kind of token, its parent
+/// token, its name and its signature blob (which holds the generic arity).
+/// IMetaDataEmit returns the same token when the same typespec, member ref or method spec is defined twice, so the
+/// tokens can be reused by every method rewritten in the module without calling it again.
+/// </summary>
+class SignatureTokenCache
+{
+private:
+    std::mutex m_lock;
+    std::unordered_map<std::string, mdToken> m_tokens;
+
+    static std::string GetKey(SignatureTokenKind kind, mdToken parent, const WCHAR* name, PCCOR_SIGNATURE signature,
+                              ULONG signatureLength)
+    {
+        size_t nameLength = 0;
+        if (name != nullptr)
+        {
+            while (name[nameLength] != 0)
+            {
+                nameLength++;
+            }
+        }
+
+        std::string key;
+        key.reserve(1 + sizeof(mdToken) + sizeof(size_t) + nameLength * sizeof(WCHAR) + signatureLength);
+        key.push_back(static_cast<char>(kind));
+        key.append(reinterpret_cast<const char*>(&parent), sizeof(mdToken));
+        key.append(reinterpret_cast<const char*>(&nameLength), sizeof(size_t));
+        key.append(reinterpret_cast<const char*>(name), nameLength * sizeof(WCHAR));
+        key.append(reinterpret_cast<const char*>(signature), signatureLength);
+        return key;
+    }
+
+public:
+    SignatureTokenCache() = default;
+    SignatureTokenCache(const SignatureTokenCache&) = delete;
+    SignatureTokenCache& operator=(const SignatureTokenCache&) = delete;
+
+    /// <summary>
+    /// Returns the token cached for the signature, or calls define (HRESULT(mdToken*)) and caches the token it
+    /// defines. Failures are not cached. The hits and misses are counted in the Stats.
+    /// </summary>
+    template <typename TDefine>
+    HRESULT GetOrDefine(SignatureTokenKind kind, mdToken parent, const WCHAR* name, PCCOR_SIGNATURE signature,
+                        ULONG signatureLength, mdToken* token, TDefine define)
+    {
+        const auto key = GetKey(kind, parent, name, signature, signatureLength);
+
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        const auto found = m_tokens.find(key);
+        if (found != m_tokens.end())
+        {
+            Stats::Instance()->SignatureTokenCacheHit();
+            *token = found->second;
+            return S_OK;
+        }
+
+        Stats::Instance()->SignatureTokenCacheMiss();
+        const HRESULT hr = define(token);
+        if (SUCCEEDED(hr))
+        {
+            m_tokens.emplace(key, *token);
+        }
+
+        return hr;
+    }
+
+    size_t Size()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        return m_tokens.size();
+    }
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_SIGNATURE_TOKEN_CACHE_H_
@@ -1,6 +1,7 @@
 #ifndef DD_CLR_PROFILER_STATS_H_
 #define DD_CLR_PROFILER_STATS_H_
 
+#include <atomic>
 #include <chrono>
 
 #include "../../../shared/src/native-src/util.h"
@@ -58,9 +59,14 @@ private:
     std::atomic_uint callTargetRewriterCount = {0};
     std::atomic_uint jitInliningCount = {0};
     std::atomic_uint jitCompilationStartedCount = {0};
+    std::atomic_uint jitCompilationStartedSkippedCount = {0};
     std::atomic_uint moduleUnloadStartedCount = {0};
     std::atomic_uint moduleLoadFinishedCount = {0};
     std::atomic_uint assemblyLoadFinishedCount = {0};
+    std::atomic_uint rejitBatchCount = {0};
+    std::atomic_uint rejitRuntimeSuspensionCount = {0};
+    std::atomic_uint signatureTokenCacheHitCount = {0};
+    std::atomic_uint signatureTokenCacheMissCount = {0};
 
 public:
     Stats()
@@ -83,9 +89,14 @@ public:
         callTargetRequestRejitCount = 0;
         jitInliningCount = 0;
         jitCompilationStartedCount = 0;
+        jitCompilationStartedSkippedCount = 0;
         moduleUnloadStartedCount = 0;
         moduleLoadFinishedCount = 0;
         assemblyLoadFinishedCount = 0;
+        rejitBatchCount = 0;
+        rejitRuntimeSuspensionCount = 0;
+        signatureTokenCacheHitCount = 0;
+        signatureTokenCacheMissCount = 0;
     }
     SWStat InitializeProfilerMeasure()
     {
@@ -117,6 +128,11 @@ public:
         jitCompilationStartedCount++;
         return SWStat(&jitCompilationStarted);
     }
+    void JITCompilationStartedSkipped()
+    {
+        // calls that returned without taking any lock
+        jitCompilationStartedSkippedCount++;
+    }
     SWStat ModuleUnloadStartedMeasure()
     {
         moduleUnloadStartedCount++;
@@ -132,6 +148,24 @@ public:
         assemblyLoadFinishedCount++;
         return SWStat(&assemblyLoadFinished);
     }
+    void RejitBatchRequested()
+    {
+        rejitBatchCount++;
+    }
+    void RejitRuntimeSuspension()
+    {
+        // one per call to RequestReJIT
+        rejitRuntimeSuspensionCount++;
+    }
+    void SignatureTokenCacheHit()
+    {
+        signatureTokenCacheHitCount++;
+    }
+    void SignatureTokenCacheMiss()
+    {
+        // one per token defined through IMetaDataEmit by the rewriter
+        signatureTokenCacheMissCount++;
+    }
     SWStat InitializeMeasure()
     {
         return SWStat(&initialize);
@@ -155,9 +189,14 @@ public:
         const auto count_assemblyLoadFinishedCount = assemblyLoadFinishedCount.load();
         const auto count_moduleUnloadStartedCount = moduleUnloadStartedCount.load();
         const auto count_jitCompilationStartedCount = jitCompilationStartedCount.load();
+        const auto count_jitCompilationStartedSkippedCount = jitCompilationStartedSkippedCount.load();
         const auto count_jitInliningCount = jitInliningCount.load();
         const auto count_jitCachedFunctionSearchStartedCount = jitCachedFunctionSearchStartedCount.load();
         const auto count_initializeProfilerCount = initializeProfilerCount.load();
+        const auto count_rejitBatchCount = rejitBatchCount.load();
+        const auto count_rejitRuntimeSuspensionCount = rejitRuntimeSuspensionCount.load();
+        const auto count_signatureTokenCacheHitCount = signatureTokenCacheHitCount.load();
+        const auto count_signatureTokenCacheMissCount = signatureTokenCacheMissCount.load();
 
         const auto ns_total = ns_initialize + ns_moduleLoadFinished + ns_callTargetRequestRejit +
                               ns_callTargetRewriter + ns_assemblyLoadFinished + ns_moduleUnloadStarted +
@@ -182,7 +221,10 @@ public:
            << "/" << count_callTargetRequestRejitCount;
         ss << ", CallTargetRewriter=";
         ss << ns_callTargetRewriter / 1000000 << "ms"
-           << "/" << count_callTargetRewriterCount;
+           << "/" << count_callTargetRewriterCount << " (avg="
+           << (count_callTargetRewriterCount > 0 ? ns_callTargetRewriter / count_callTargetRewriterCount / 1000 : 0)
+           << "us, token cache hits=" << count_signatureTokenCacheHitCount
+           << "/misses=" << count_signatureTokenCacheMissCount << ")";
         ss << ", AssemblyLoadFinished=";
         ss << ns_assemblyLoadFinished / 1000000 << "ms"
            << "/" << count_assemblyLoadFinishedCount;
@@ -191,7 +233,8 @@ public:
            << "/" << count_moduleUnloadStartedCount;
         ss << ", JitCompilationStarted=";
         ss << ns_jitCompilationStarted / 1000000 << "ms"
-           << "/" << count_jitCompilationStartedCount;
+           << "/" << count_jitCompilationStartedCount
+           << " (skipped=" << count_jitCompilationStartedSkippedCount << ")";
         ss << ", JitInlining=";
         ss << ns_jitInlining / 1000000 << "ms"
            << "/" << count_jitInliningCount;
@@ -201,6 +244,12 @@ public:
         ss << ", InitializeProfiler=";
         ss << ns_initializeProfiler / 1000000 << "ms"
            << "/" << count_initializeProfilerCount;
+        ss << ", RequestReJIT=";
+        ss << count_rejitRuntimeSuspensionCount << " (batches=" << count_rejitBatchCount << ", suspensions saved="
+           << (count_rejitBatchCount > count_rejitRuntimeSuspensionCount
+                   ? count_rejitBatchCount - count_rejitRuntimeSuspensionCount
+                   : 0)
+           << ")";
         ss << "]";
         return ss.str();
     }
@@ -108,8 +108,7 @@ HRESULT TracerTokens::WriteBeginMethodWithArgumentsArray(void* rewriterWrapperPt
     memcpy(&signature[offset], &currentTypeBuffer, currentTypeSize);
     offset += currentTypeSize;
 
-    hr = module_metadata->metadata_emit->DefineMethodSpec(beginArrayMemberRef, signature, signatureLength,
-                                                          &beginArrayMethodSpec);
+    hr = DefineMethodSpec(beginArrayMemberRef, signature, signatureLength, &beginArrayMethodSpec);
     if (FAILED(hr))
     {
         Logger::Warn("Error creating begin method spec.");
@@ -172,7 +171,6 @@ HRESULT TracerTokens::WriteBeginMethod(void* rewriterWrapperPtr, mdTypeRef integ
     }
 
     ILRewriterWrapper* rewriterWrapper = (ILRewriterWrapper*) rewriterWrapperPtr;
-    ModuleMetadata* module_metadata = GetMetadata();
 
     auto numArguments = (int) methodArguments.size();
     if (numArguments >= FASTPATH_COUNT)
@@ -224,9 +222,8 @@ HRESULT TracerTokens::WriteBeginMethod(void* rewriterWrapperPtr, mdTypeRef integ
             signature[offset++] = 0x01 + (i + 1);
         }
 
-        auto hr = module_metadata->metadata_emit->DefineMemberRef(
-            callTargetTypeRef, managed_profiler_calltarget_beginmethod_name.data(), signature, signatureLength,
-            &beginMethodFastPathRef);
+        auto hr = DefineMemberRef(callTargetTypeRef, managed_profiler_calltarget_beginmethod_name.data(), signature,
+                                  signatureLength, &beginMethodFastPathRef);
         if (FAILED(hr))
         {
             Logger::Warn("Wrapper beginMethod for ", numArguments, " arguments could not be defined.");
@@ -319,8 +316,7 @@ HRESULT TracerTokens::WriteBeginMethod(void* rewriterWrapperPtr, mdTypeRef integ
         offset += argumentsSignatureSize[i];
     }
 
-    hr = module_metadata->metadata_emit->DefineMethodSpec(beginMethodFastPathRef, signature,
-                                                          signatureLength, &beginMethodSpec);
+    hr = DefineMethodSpec(beginMethodFastPathRef, signature, signatureLength, &beginMethodSpec);
     if (FAILED(hr))
     {
         Logger::Warn("Error creating begin method spec.");
@@ -434,8 +430,7 @@ HRESULT TracerTokens::WriteEndVoidReturnMemberRef(void* rewriterWrapperPtr, mdTy
     memcpy(&signature[offset], &currentTypeBuffer, currentTypeSize);
     offset += currentTypeSize;
 
-    hr = module_metadata->metadata_emit->DefineMethodSpec(endVoidMemberRef, signature, signatureLength,
-                                                          &endVoidMethodSpec);
+    hr = DefineMethodSpec(endVoidMemberRef, signature, signatureLength, &endVoidMethodSpec);
     if (FAILED(hr))
     {
         Logger::Warn("Error creating end void method method spec.");
@@ -457,7 +452,6 @@ HRESULT TracerTokens::WriteEndReturnMemberRef(void* rewriterWrapperPtr, mdTypeRe
         return hr;
     }
     ILRewriterWrapper* rewriterWrapper = (ILRewriterWrapper*) rewriterWrapperPtr;
-    ModuleMetadata* module_metadata = GetMetadata();
     GetTargetReturnValueTypeRef(returnArgument);
 
     // *** Define base MethodMemberRef for the type
@@ -512,9 +506,8 @@ HRESULT TracerTokens::WriteEndReturnMemberRef(void* rewriterWrapperPtr, mdTypeRe
     memcpy(&signature[offset], &callTargetStateBuffer, callTargetStateSize);
     offset += callTargetStateSize;
 
-    hr = module_metadata->metadata_emit->DefineMemberRef(callTargetTypeRef,
-                                                         managed_profiler_calltarget_endmethod_name.data(), signature,
-                                                         signatureLength, &endMethodMemberRef);
+    hr = DefineMemberRef(callTargetTypeRef, managed_profiler_calltarget_endmethod_name.data(), signature,
+                         signatureLength, &endMethodMemberRef);
     if (FAILED(hr))
     {
         Logger::Warn("Wrapper endMethodMemberRef could not be defined.");
@@ -566,8 +559,7 @@ HRESULT TracerTokens::WriteEndReturnMemberRef(void* rewriterWrapperPtr, mdTypeRe
     memcpy(&signature[offset], returnSignatureBuffer, returnSignatureLength);
     offset += returnSignatureLength;
 
-    hr = module_metadata->metadata_emit->DefineMethodSpec(endMethodMemberRef, signature, signatureLength,
-                                                          &endMethodSpec);
+    hr = DefineMethodSpec(endMethodMemberRef, signature, signatureLength, &endMethodSpec);
     if (FAILED(hr))
     {
         Logger::Warn("Error creating end method member spec.");
@@ -655,8 +647,7 @@ HRESULT TracerTokens::WriteLogException(void* rewriterWrapperPtr, mdTypeRef inte
     memcpy(&signature[offset], &currentTypeBuffer, currentTypeSize);
     offset += currentTypeSize;
 
-    hr = module_metadata->metadata_emit->DefineMethodSpec(logExceptionRef, signature, signatureLength,
-                                                          &logExceptionMethodSpec);
+    hr = DefineMethodSpec(logExceptionRef, signature, signatureLength, &logExceptionMethodSpec);
     if (FAILED(hr))
     {
         Logger::Warn("Error creating log exception method spec.");
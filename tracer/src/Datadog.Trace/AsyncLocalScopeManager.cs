@@ -76,7 +76,18 @@ namespace Datadog.Trace
             }
             else
             {
-                Profiler.Instance.ContextTracker.Set(obj.CurrentValue.Span.RootSpanId, obj.CurrentValue.Span.SpanId);
+                var span = obj.CurrentValue.Span;
+
+                // the endpoint is the resource of the local root span (i.e. the HTTP route)
+                var rootSpan = span.Context.TraceContext?.RootSpan ?? span;
+                Profiler.Instance.ContextTracker.Set(span.RootSpanId, span.SpanId, rootSpan.ResourceName);
+
+                // a request that is already slow when one of its spans becomes active is sampled at a higher rate
+                if (Profiler.Instance.ContextTracker.IsBurstSamplingEnabled && span.Context.TraceContext != null)
+                {
+                    var rootSpanElapsed = span.Context.TraceContext.ElapsedSince(rootSpan.StartTime);
+                    Profiler.Instance.ContextTracker.StartBurstSamplingIfSlow(span.RootSpanId, span.SpanId, rootSpanElapsed);
+                }
             }
         }
     }
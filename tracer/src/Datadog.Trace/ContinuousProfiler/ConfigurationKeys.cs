@@ -9,5 +9,11 @@ namespace Datadog.Trace.ContinuousProfiler
     {
         public const string ProfilingEnabled = "DD_PROFILING_ENABLED";
         public const string CodeHotspotsEnabled = "DD_PROFILING_CODEHOTSPOTS_ENABLED";
+
+        // duration (in milliseconds) after which a request is considered slow and its thread is sampled at a higher rate
+        public const string BurstSamplingThreshold = "DD_PROFILING_BURST_SAMPLING_THRESHOLD";
+
+        // duration (in milliseconds) of the higher rate sampling of a slow request (500 by default)
+        public const string BurstSamplingDuration = "DD_PROFILING_BURST_SAMPLING_DURATION";
     }
 }
@@ -4,6 +4,7 @@
 // </copyright>
 
 using System;
+using System.Collections.Concurrent;
 using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 using System.Threading;
@@ -17,8 +18,20 @@ namespace Datadog.Trace.ContinuousProfiler
     {
         private static readonly IDatadogLogger Log = DatadogLogging.GetLoggerFor(typeof(ContextTracker));
 
+        // same limit as the native endpoint store: ids are not requested anymore once reached
+        private const int MaxEndpoints = 1024;
+
+        // how long the thread of a slow request is sampled at a higher rate, unless configured
+        private const int DefaultBurstSamplingDurationMs = 500;
+
+        // a burst is requested only once per local root span on a given thread
+        [ThreadStatic]
+        private static ulong _lastBurstLocalRootSpanId;
+
         private readonly IProfilerStatus _status;
         private readonly bool _isCodeHotspotsEnabled;
+        private readonly TimeSpan _burstSamplingThreshold;
+        private readonly int _burstSamplingDurationMs;
 
         /// <summary>
         /// _traceContextPtr points to a structure with this layout
@@ -31,17 +44,37 @@ namespace Datadog.Trace.ContinuousProfiler
         ///                    |--------------------|
         ///   16       8       |       Span Id      |
         ///                    |--------------------|
+        ///   24       8       |     Endpoint Id    |    // only if the profiler exports RegisterEndpoint
+        ///                    |--------------------|
         /// This allows us to inform the profiler sampling thread when we are writing or not the data
         /// and avoid torn read/write (Using memory barriers).
         /// We take advantage of this layout in SpanContext.Write
         /// </summary>
         private readonly ThreadLocal<IntPtr> _traceContextPtr;
 
+        // endpoint (resource name of the local root span) -> id interned by the profiler
+        private readonly ConcurrentDictionary<string, ulong> _endpointIds;
+
+        // older profilers do not know the Endpoint Id field: it is written only once RegisterEndpoint succeeded
+        private bool _isEndpointIdSupported;
+        private bool _isEndpointIdUnsupported;
+
+        // older profilers do not export SetThreadLabel/ClearThreadLabels
+        private bool _areThreadLabelsUnsupported;
+
+        // older profilers do not export StartBurstSampling
+        private bool _isBurstSamplingUnsupported;
+
         public ContextTracker(IProfilerStatus status)
         {
             _status = status;
             _isCodeHotspotsEnabled = EnvironmentHelpers.GetEnvironmentVariable(ConfigurationKeys.CodeHotspotsEnabled)?.ToBoolean() ?? true;
+            var burstSamplingThresholdMs = EnvironmentHelpers.GetEnvironmentVariable(ConfigurationKeys.BurstSamplingThreshold);
+            _burstSamplingThreshold = int.TryParse(burstSamplingThresholdMs, out var thresholdMs) && thresholdMs > 0 ? TimeSpan.FromMilliseconds(thresholdMs) : TimeSpan.Zero;
+            var burstSamplingDurationMs = EnvironmentHelpers.GetEnvironmentVariable(ConfigurationKeys.BurstSamplingDuration);
+            _burstSamplingDurationMs = int.TryParse(burstSamplingDurationMs, out var durationMs) && durationMs > 0 ? durationMs : DefaultBurstSamplingDurationMs;
             _traceContextPtr = new ThreadLocal<IntPtr>();
+            _endpointIds = new ConcurrentDictionary<string, ulong>();
         }
 
         public bool IsEnabled
@@ -52,9 +85,44 @@ namespace Datadog.Trace.ContinuousProfiler
             }
         }
 
-        public void Set(ulong localRootSpanId, ulong spanId)
+        public bool IsBurstSamplingEnabled
         {
-            WriteToNative(new SpanContext(localRootSpanId, spanId));
+            get
+            {
+                return _burstSamplingThreshold > TimeSpan.Zero && !_isBurstSamplingUnsupported && IsEnabled;
+            }
+        }
+
+        public void Set(ulong localRootSpanId, ulong spanId, string endpoint)
+        {
+            if (!IsEnabled)
+            {
+                return;
+            }
+
+            WriteToNative(new SpanContext(localRootSpanId, spanId, GetEndpointId(endpoint)));
+        }
+
+        /// <summary>
+        /// Updates the endpoint of the samples of the current thread when it is running the given local root span:
+        /// the resource name (i.e. the HTTP route) is usually known only after the span was activated.
+        /// </summary>
+        public void SetEndpoint(ulong localRootSpanId, string endpoint)
+        {
+            if (!IsEnabled || _isEndpointIdUnsupported || !_traceContextPtr.IsValueCreated)
+            {
+                return;
+            }
+
+            var ctxPtr = _traceContextPtr.Value;
+
+            if (ctxPtr == IntPtr.Zero || (ulong)Marshal.ReadInt64(ctxPtr + 8) != localRootSpanId)
+            {
+                return;
+            }
+
+            var spanId = (ulong)Marshal.ReadInt64(ctxPtr + 16);
+            WriteToNative(new SpanContext(localRootSpanId, spanId, GetEndpointId(endpoint)));
         }
 
         public void Reset()
@@ -62,6 +130,123 @@ namespace Datadog.Trace.ContinuousProfiler
             WriteToNative(SpanContext.Zero);
         }
 
+        /// <summary>
+        /// Attaches a low cardinality label (i.e. tenant tier, queue name) to the samples of the current thread
+        /// until it is changed or removed (null or empty value). Only a few labels can be set at the same time.
+        /// </summary>
+        public bool SetThreadLabel(string key, string value)
+        {
+            if (string.IsNullOrEmpty(key) || _areThreadLabelsUnsupported || !_status.IsProfilerReady)
+            {
+                return false;
+            }
+
+            try
+            {
+                return NativeInterop.SetThreadLabel(key, value);
+            }
+            catch (EntryPointNotFoundException)
+            {
+                Log.Information("The profiler does not support thread labels: the samples will not have custom labels");
+                _areThreadLabelsUnsupported = true;
+            }
+            catch (Exception e)
+            {
+                Log.Warning(e, "Unable to set the thread label {Key}", key);
+            }
+
+            return false;
+        }
+
+        public void ClearThreadLabels()
+        {
+            if (_areThreadLabelsUnsupported || !_status.IsProfilerReady)
+            {
+                return;
+            }
+
+            try
+            {
+                NativeInterop.ClearThreadLabels();
+            }
+            catch (EntryPointNotFoundException)
+            {
+                _areThreadLabelsUnsupported = true;
+            }
+            catch (Exception e)
+            {
+                Log.Warning(e, "Unable to clear the thread labels for {ThreadID}", Environment.CurrentManagedThreadId.ToString());
+            }
+        }
+
+        /// <summary>
+        /// Asks the profiler to sample the current thread at a higher rate for a short period of time
+        /// when the local root span (i.e. the request) is already running for longer than the threshold.
+        /// The profiler sampler also checks the threshold for the spans that stay active on a thread.
+        /// </summary>
+        public void StartBurstSamplingIfSlow(ulong localRootSpanId, ulong spanId, TimeSpan localRootSpanElapsed)
+        {
+            if (!IsBurstSamplingEnabled || localRootSpanElapsed < _burstSamplingThreshold || _lastBurstLocalRootSpanId == localRootSpanId)
+            {
+                return;
+            }
+
+            _lastBurstLocalRootSpanId = localRootSpanId;
+
+            try
+            {
+                NativeInterop.StartBurstSampling(_burstSamplingDurationMs, spanId);
+            }
+            catch (EntryPointNotFoundException)
+            {
+                Log.Information("The profiler does not support burst sampling");
+                _isBurstSamplingUnsupported = true;
+            }
+            catch (Exception e)
+            {
+                Log.Warning(e, "Unable to start burst sampling for the span {SpanId}", spanId);
+            }
+        }
+
+        private ulong GetEndpointId(string endpoint)
+        {
+            if (endpoint == null || _isEndpointIdUnsupported)
+            {
+                return 0;
+            }
+
+            if (_endpointIds.TryGetValue(endpoint, out var endpointId))
+            {
+                return endpointId;
+            }
+
+            if (_endpointIds.Count >= MaxEndpoints)
+            {
+                return 0;
+            }
+
+            try
+            {
+                endpointId = NativeInterop.RegisterEndpoint(endpoint);
+                _isEndpointIdSupported = true;
+            }
+            catch (EntryPointNotFoundException)
+            {
+                Log.Information("The profiler does not support endpoints: the samples will not have the endpoint label");
+                _isEndpointIdUnsupported = true;
+                return 0;
+            }
+            catch (Exception e)
+            {
+                Log.Warning(e, "Unable to register the endpoint {Endpoint}", endpoint);
+                return 0;
+            }
+
+            // 0 is also cached when the profiler store is full to avoid calling it again
+            _endpointIds.TryAdd(endpoint, endpointId);
+            return endpointId;
+        }
+
         private void EnsureIsInitialized()
         {
             if (_traceContextPtr.IsValueCreated)
@@ -98,7 +283,7 @@ namespace Datadog.Trace.ContinuousProfiler
 
             try
             {
-                ctx.Write(ctxPtr);
+                ctx.Write(ctxPtr, _isEndpointIdSupported);
             }
             catch (Exception e)
             {
@@ -109,19 +294,21 @@ namespace Datadog.Trace.ContinuousProfiler
         // See the description and the layout depicted above
         private readonly struct SpanContext
         {
-            public static readonly SpanContext Zero = new(0, 0);
+            public static readonly SpanContext Zero = new(0, 0, 0);
 
             public readonly ulong LocalRootSpanId;
             public readonly ulong SpanId;
+            public readonly ulong EndpointId;
 
-            public SpanContext(ulong localRootSpanId, ulong spanId)
+            public SpanContext(ulong localRootSpanId, ulong spanId, ulong endpointId)
             {
                 LocalRootSpanId = localRootSpanId;
                 SpanId = spanId;
+                EndpointId = endpointId;
             }
 
             [MethodImpl(MethodImplOptions.NoInlining)]
-            public void Write(IntPtr ptr)
+            public void Write(IntPtr ptr, bool writeEndpointId)
             {
                 // Set the WriteGuard
                 Marshal.WriteInt64(ptr, 1);
@@ -131,6 +318,10 @@ namespace Datadog.Trace.ContinuousProfiler
                 // For the offset, we follow the layout depicted above
                 Marshal.WriteInt64(ptr + 8, (long)LocalRootSpanId);
                 Marshal.WriteInt64(ptr + 16, (long)SpanId);
+                if (writeEndpointId)
+                {
+                    Marshal.WriteInt64(ptr + 24, (long)EndpointId);
+                }
 
                 // Reset the WriteGuard
                 Thread.MemoryBarrier();
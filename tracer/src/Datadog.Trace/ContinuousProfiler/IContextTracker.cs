@@ -3,14 +3,26 @@
 // This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2017 Datadog, Inc.
 // </copyright>
 
+using System;
+
 namespace Datadog.Trace.ContinuousProfiler
 {
     internal interface IContextTracker
     {
         bool IsEnabled { get; }
 
-        void Set(ulong localRootSpanId, ulong spanId);
+        bool IsBurstSamplingEnabled { get; }
+
+        void Set(ulong localRootSpanId, ulong spanId, string endpoint);
+
+        void SetEndpoint(ulong localRootSpanId, string endpoint);
 
         void Reset();
+
+        bool SetThreadLabel(string key, string value);
+
+        void ClearThreadLabels();
+
+        void StartBurstSamplingIfSlow(ulong localRootSpanId, ulong spanId, TimeSpan localRootSpanElapsed);
     }
 }
@@ -23,6 +23,30 @@ namespace Datadog.Trace.ContinuousProfiler
             return NativeMethods.GetTraceContextNativePointer();
         }
 
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        public static ulong RegisterEndpoint(string endpoint)
+        {
+            return NativeMethods.RegisterEndpoint(endpoint);
+        }
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        public static bool SetThreadLabel(string key, string value)
+        {
+            return NativeMethods.SetThreadLabel(key, value);
+        }
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        public static void ClearThreadLabels()
+        {
+            NativeMethods.ClearThreadLabels();
+        }
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        public static bool StartBurstSampling(int durationMs, ulong spanId)
+        {
+            return NativeMethods.StartBurstSampling(durationMs, spanId);
+        }
+
         [MethodImpl(MethodImplOptions.NoInlining)]
         public static void SetApplicationInfoForAppDomain(string runtimeId, string serviceName, string environment, string version)
         {
@@ -37,6 +61,19 @@ namespace Datadog.Trace.ContinuousProfiler
             [DllImport(dllName: "Datadog.Profiler.Native", EntryPoint = "GetPointerToNativeTraceContext")]
             public static extern IntPtr GetTraceContextNativePointer();
 
+            [DllImport(dllName: "Datadog.Profiler.Native", EntryPoint = "RegisterEndpoint")]
+            public static extern ulong RegisterEndpoint(string endpoint);
+
+            // the native side returns a C BOOL (4 bytes): this is the default marshalling of bool
+            [DllImport(dllName: "Datadog.Profiler.Native", EntryPoint = "SetThreadLabel")]
+            public static extern bool SetThreadLabel(string key, string value);
+
+            [DllImport(dllName: "Datadog.Profiler.Native", EntryPoint = "ClearThreadLabels")]
+            public static extern void ClearThreadLabels();
+
+            [DllImport(dllName: "Datadog.Profiler.Native", EntryPoint = "StartBurstSampling")]
+            public static extern bool StartBurstSampling(int durationMs, ulong spanId);
+
             [DllImport(dllName: "Datadog.Profiler.Native", EntryPoint = "SetApplicationInfoForAppDomain")]
             public static extern void SetApplicationInfoForAppDomain(string runtimeId, string serviceName, string environment, string version);
         }
@@ -26,6 +26,11 @@ namespace Datadog.Trace.ContinuousProfiler
 
         public IContextTracker ContextTracker { get; }
 
+        internal static void SetInstanceOnlyForTests(Profiler instance)
+        {
+            _instance = instance;
+        }
+
         private static Profiler Create()
         {
             var status = new ProfilerStatus();
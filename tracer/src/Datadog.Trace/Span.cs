@@ -5,6 +5,7 @@
 
 using System;
 using System.Globalization;
+using Datadog.Trace.ContinuousProfiler;
 using Datadog.Trace.ExtensionMethods;
 using Datadog.Trace.Logging;
 using Datadog.Trace.Tagging;
@@ -26,6 +27,8 @@ namespace Datadog.Trace
 
         private readonly object _lock = new object();
 
+        private string _resourceName;
+
         internal Span(SpanContext context, DateTimeOffset? start)
             : this(context, start, null)
         {
@@ -52,7 +55,21 @@ namespace Datadog.Trace
         /// <summary>
         /// Gets or sets the resource name
         /// </summary>
-        internal string ResourceName { get; set; }
+        internal string ResourceName
+        {
+            get => _resourceName;
+            set
+            {
+                _resourceName = value;
+
+                // the resource of the local root span is the endpoint of the profiler samples:
+                // it is usually set (i.e. once the route is resolved) after the span was activated
+                if (IsRootSpan && Profiler.Instance.ContextTracker.IsEnabled)
+                {
+                    Profiler.Instance.ContextTracker.SetEndpoint(SpanId, value);
+                }
+            }
+        }
 
         /// <summary>
         /// Gets or sets the type of request this span represents (ex: web, db).
@@ -0,0 +1,153 @@
+#include "pch.h"
+
+#include <vector>
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/il_rewriter.h"
+
+namespace
+{
+class FunctionControlStub : public ICorProfilerFunctionControl
+{
+public:
+    unsigned m_bodySize = 0;
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override
+    {
+        return E_NOINTERFACE;
+    }
+    ULONG STDMETHODCALLTYPE AddRef() override
+    {
+        return 1;
+    }
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        return 1;
+    }
+    HRESULT STDMETHODCALLTYPE SetCodegenFlags(DWORD flags) override
+    {
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE SetILFunctionBody(ULONG cbNewILMethodHeader, LPCBYTE pbNewILMethodHeader) override
+    {
+        m_bodySize = cbNewILMethodHeader;
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE SetILInstrumentedCodeMap(ULONG cILMapEntries, COR_IL_MAP rgILMapEntries[]) override
+    {
+        return S_OK;
+    }
+};
+
+ILInstr* Append(ILRewriter& rewriter, unsigned opcode)
+{
+    ILInstr* pInstr = rewriter.NewILInstr();
+    pInstr->m_opcode = opcode;
+    rewriter.InsertBefore(rewriter.GetILList(), pInstr);
+    return pInstr;
+}
+
+// Synthetic method body: `count` instructions pushing and popping constants, with a try/finally for the
+// bodies larger than 100 instructions
+void BuildMethodBody(ILRewriter& rewriter, unsigned count)
+{
+    // fat header: the tiny one is limited to 64 bytes of IL
+    rewriter.InitializeTiny();
+    rewriter.SetTkLocalVarSig(0);
+
+    ILInstr* pFirst = nullptr;
+    for (unsigned i = 0; i + 1 < count; i += 2)
+    {
+        ILInstr* pLoad = Append(rewriter, CEE_LDC_I4);
+        pLoad->m_Arg32 = static_cast<INT32>(i);
+        Append(rewriter, CEE_POP);
+
+        if (pFirst == nullptr)
+        {
+            pFirst = pLoad;
+        }
+    }
+
+    ILInstr* pRet = Append(rewriter, CEE_RET);
+
+    if (count > 100)
+    {
+        EHClause* pEH = rewriter.NewEHClauses(1);
+        pEH[0].m_Flags = COR_ILEXCEPTION_CLAUSE_FINALLY;
+        pEH[0].m_pTryBegin = pFirst;
+        pEH[0].m_pTryEnd = pRet->m_pPrev;
+        pEH[0].m_pHandlerBegin = pRet->m_pPrev;
+        pEH[0].m_pHandlerEnd = pRet->m_pPrev;
+        rewriter.SetEHClause(pEH, 1);
+    }
+}
+
+struct CorpusEntry
+{
+    unsigned instructions;
+    unsigned methods;
+};
+
+const std::vector<CorpusEntry> Corpus = {{10, 500}, {100, 200}, {1000, 50}, {10000, 5}};
+} // namespace
+
+TEST(ILRewriterTest, ArenaAllocationsAreAlignedAndOwned)
+{
+    ILRewriterArena arena;
+    ASSERT_EQ(0, arena.GetBlockCount());
+
+    std::vector<void*> allocations;
+    for (size_t size = 1; size < 3000; size += 7)
+    {
+        void* p = arena.Allocate(size);
+        ASSERT_EQ(0, reinterpret_cast<uintptr_t>(p) % 8);
+        ASSERT_TRUE(arena.Owns(p));
+        allocations.push_back(p);
+    }
+
+    // a few blocks, not one per allocation
+    ASSERT_LT(arena.GetBlockCount(), allocations.size() / 4);
+
+    int notInArena = 0;
+    ASSERT_FALSE(arena.Owns(&notInArena));
+    ASSERT_FALSE(arena.Owns(nullptr));
+}
+
+TEST(ILRewriterTest, ExportsBodiesBuiltInTheArena)
+{
+    FunctionControlStub functionControl;
+
+    for (const auto& entry : Corpus)
+    {
+        ILRewriter rewriter(nullptr, &functionControl, 0, 0x06000001);
+        BuildMethodBody(rewriter, entry.instructions);
+
+        functionControl.m_bodySize = 0;
+        ASSERT_EQ(S_OK, rewriter.Export());
+        ASSERT_GT(functionControl.m_bodySize, entry.instructions) << entry.instructions;
+    }
+
+    // EH clauses allocated outside of the arena are still owned and deleted by the rewriter
+    ILRewriter rewriter(nullptr, &functionControl, 0, 0x06000001);
+    BuildMethodBody(rewriter, 200);
+    auto pEH = new EHClause[1];
+    pEH[0] = rewriter.GetEHPointer()[0];
+    rewriter.SetEHClause(pEH, 1);
+    ASSERT_EQ(S_OK, rewriter.Export());
+}
+
+TEST(ILRewriterTest, InstructionsAreAllocatedInFewBlocks)
+{
+    FunctionControlStub functionControl;
+
+    for (const auto& entry : Corpus)
+    {
+        ILRewriter rewriter(nullptr, &functionControl, 0, 0x06000001);
+        BuildMethodBody(rewriter, entry.instructions);
+        ASSERT_EQ(S_OK, rewriter.Export());
+
+        // every instruction comes from the arena, which only allocates a few growing blocks on the heap
+        const auto& arena = rewriter.GetArena();
+        ASSERT_GE(arena.GetAllocationCount(), entry.instructions) << entry.instructions;
+        ASSERT_LE(arena.GetBlockCount(), 1 + entry.instructions / 100) << entry.instructions;
+    }
+}
@@ -0,0 +1,140 @@
+#include "pch.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/instrumented_method_set.h"
+
+using namespace trace;
+
+TEST(InstrumentedMethodSetTest, MethodsAreVisibleOncePublished)
+{
+    InstrumentedMethodSet set;
+
+    set.Add(0x1000, 0x06000001);
+    set.Add(0x1000, 0x06000002);
+    set.Add(0x2000, 0x06000001);
+    ASSERT_FALSE(set.Contains(0x1000, 0x06000001));
+
+    set.Publish();
+    ASSERT_TRUE(set.Contains(0x1000, 0x06000001));
+    ASSERT_TRUE(set.Contains(0x1000, 0x06000002));
+    ASSERT_TRUE(set.Contains(0x2000, 0x06000001));
+    ASSERT_FALSE(set.Contains(0x2000, 0x06000002));
+    ASSERT_FALSE(set.Contains(0x3000, 0x06000001));
+
+    // adding to a module keeps the methods already published
+    set.Add(0x2000, 0x06000003);
+    set.Publish();
+    ASSERT_TRUE(set.Contains(0x2000, 0x06000001));
+    ASSERT_TRUE(set.Contains(0x2000, 0x06000003));
+    ASSERT_TRUE(set.Contains(0x1000, 0x06000002));
+}
+
+TEST(InstrumentedMethodSetTest, RemoveModuleAndClear)
+{
+    InstrumentedMethodSet set;
+
+    set.Add(0x1000, 0x06000001);
+    set.Add(0x2000, 0x06000001);
+    set.Publish();
+
+    set.RemoveModule(0x1000);
+    ASSERT_FALSE(set.Contains(0x1000, 0x06000001));
+    ASSERT_TRUE(set.Contains(0x2000, 0x06000001));
+
+    set.Clear();
+    ASSERT_FALSE(set.Contains(0x2000, 0x06000001));
+}
+
+TEST(InstrumentedMethodSetTest, NoFalseNegativeWithManyMethods)
+{
+    InstrumentedMethodSet set;
+
+    for (mdMethodDef methodDef = 0x06000001; methodDef < 0x06000001 + 2000; methodDef += 2)
+    {
+        set.Add(0x1000, methodDef);
+    }
+    set.Publish();
+
+    for (mdMethodDef methodDef = 0x06000001; methodDef < 0x06000001 + 2000; methodDef++)
+    {
+        ASSERT_EQ((methodDef - 0x06000001) % 2 == 0, set.Contains(0x1000, methodDef)) << methodDef;
+    }
+}
+
+TEST(InstrumentedMethodSetTest, LookupsWhilePublishing)
+{
+    InstrumentedMethodSet set;
+    set.Add(0x1000, 0x06000001);
+    set.Publish();
+
+    std::atomic_bool done = {false};
+    std::atomic_uint missed = {0};
+
+    std::thread reader([&set, &done, &missed]() {
+        while (!done)
+        {
+            if (!set.Contains(0x1000, 0x06000001))
+            {
+                missed++;
+            }
+        }
+    });
+
+    for (ModuleID moduleId = 0x2000; moduleId < 0x2000 + 500 * 0x40; moduleId += 0x40)
+    {
+        set.Add(moduleId, 0x06000001);
+        set.Publish();
+    }
+
+    done = true;
+    reader.join();
+
+    ASSERT_EQ(0, missed.load());
+}
+
+TEST(InstrumentedMethodSetTest, LookupsWhileReplacingAndRemovingModules)
+{
+    InstrumentedMethodSet set;
+    set.Add(0x1000, 0x06000001);
+    set.Publish();
+
+    std::atomic_bool done = {false};
+    std::atomic_uint missed = {0};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; i++)
+    {
+        readers.emplace_back([&set, &done, &missed]() {
+            while (!done)
+            {
+                if (!set.Contains(0x1000, 0x06000001))
+                {
+                    missed++;
+                }
+                set.Contains(0x2000, 0x06000001);
+            }
+        });
+    }
+
+    // the replaced and removed entries are freed while the readers are running
+    for (mdMethodDef methodDef = 0x06000002; methodDef < 0x06000002 + 500; methodDef++)
+    {
+        set.Add(0x1000, methodDef);
+        set.Add(0x2000, 0x06000001);
+        set.Publish();
+        set.RemoveModule(0x2000);
+    }
+
+    done = true;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    ASSERT_EQ(0, missed.load());
+    ASSERT_TRUE(set.Contains(0x1000, 0x06000001 + 500));
+    ASSERT_FALSE(set.Contains(0x2000, 0x06000001));
+}
@@ -0,0 +1,145 @@
+#include "pch.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/module_id_set.h"
+
+using namespace trace;
+
+TEST(ModuleIdSetTest, AddContainsRemove)
+{
+    ModuleIdSet set;
+
+    ASSERT_FALSE(set.Contains(0x1000));
+    ASSERT_TRUE(set.Add(0x1000));
+    ASSERT_FALSE(set.Add(0x1000));
+    ASSERT_TRUE(set.Contains(0x1000));
+    ASSERT_FALSE(set.Contains(0x2000));
+    ASSERT_EQ(1, set.Size());
+
+    ASSERT_TRUE(set.Remove(0x1000));
+    ASSERT_FALSE(set.Remove(0x1000));
+    ASSERT_FALSE(set.Contains(0x1000));
+    ASSERT_EQ(0, set.Size());
+
+    // a removed id can be added again
+    ASSERT_TRUE(set.Add(0x1000));
+    ASSERT_TRUE(set.Contains(0x1000));
+
+    // reserved values are never stored
+    ASSERT_FALSE(set.Add(0));
+    ASSERT_FALSE(set.Contains(0));
+}
+
+TEST(ModuleIdSetTest, GrowsAndKeepsEntries)
+{
+    ModuleIdSet set;
+
+    for (ModuleID id = 1; id <= 5000; id++)
+    {
+        ASSERT_TRUE(set.Add(id * 0x40));
+    }
+
+    // remove every other id to leave removed slots in the probing chains
+    for (ModuleID id = 1; id <= 5000; id += 2)
+    {
+        ASSERT_TRUE(set.Remove(id * 0x40));
+    }
+
+    ASSERT_EQ(2500, set.Size());
+    for (ModuleID id = 1; id <= 5000; id++)
+    {
+        ASSERT_EQ(id % 2 == 0, set.Contains(id * 0x40)) << "id=" << id;
+    }
+
+    // reusing the removed slots
+    for (ModuleID id = 5001; id <= 8000; id++)
+    {
+        ASSERT_TRUE(set.Add(id * 0x40));
+    }
+
+    ASSERT_EQ(5500, set.Size());
+    for (ModuleID id = 5001; id <= 8000; id++)
+    {
+        ASSERT_TRUE(set.Contains(id * 0x40));
+    }
+}
+
+TEST(ModuleIdSetTest, LoadUnloadChurnDoesNotGrowTheTable)
+{
+    static constexpr ModuleID AlwaysThere = 0x10;
+
+    ModuleIdSet set;
+    set.Add(AlwaysThere);
+    const auto initialCapacity = set.Capacity();
+
+    std::atomic_bool done = {false};
+    std::atomic_uint missed = {0};
+
+    std::thread reader([&set, &done, &missed]() {
+        while (!done)
+        {
+            if (!set.Contains(AlwaysThere))
+            {
+                missed++;
+            }
+        }
+    });
+
+    // every load gets a new id, leaving a removed slot behind once unloaded
+    for (ModuleID id = 1; id <= 100000; id++)
+    {
+        ASSERT_TRUE(set.Add(AlwaysThere + id * 0x40));
+        ASSERT_TRUE(set.Remove(AlwaysThere + id * 0x40));
+    }
+
+    done = true;
+    reader.join();
+
+    ASSERT_EQ(0, missed.load());
+    ASSERT_EQ(1, set.Size());
+    ASSERT_EQ(initialCapacity, set.Capacity());
+}
+
+TEST(ModuleIdSetTest, LookupsWhileAdding)
+{
+    static constexpr ModuleID AlwaysThere = 0x10;
+    static constexpr ModuleID Count = 20000;
+
+    ModuleIdSet set;
+    set.Add(AlwaysThere);
+
+    std::atomic_bool done = {false};
+    std::atomic_uint missed = {0};
+
+    // resizes happen while the readers are probing the table
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; i++)
+    {
+        readers.emplace_back([&set, &done, &missed]() {
+            while (!done)
+            {
+                if (!set.Contains(AlwaysThere))
+                {
+                    missed++;
+                }
+            }
+        });
+    }
+
+    for (ModuleID id = 1; id <= Count; id++)
+    {
+        set.Add(AlwaysThere + id * 0x40);
+    }
+
+    done = true;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    ASSERT_EQ(0, missed.load());
+    ASSERT_EQ(Count + 1, set.Size());
+}
@@ -0,0 +1,312 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/rejit_definition_index.h"
+
+using namespace trace;
+
+namespace
+{
+struct TestDefinition
+{
+    shared::WSTRING assembly_name;
+    Version min_version;
+    Version max_version;
+    bool is_derived;
+};
+
+struct TestModule
+{
+    shared::WSTRING assembly_name;
+    Version version;
+    std::vector<std::pair<shared::WSTRING, Version>> references;
+};
+
+shared::WSTRING ToWString(const std::string& str)
+{
+    return shared::WSTRING(str.begin(), str.end());
+}
+
+// Same selection as the loop over every definition done before the index
+std::vector<size_t> LinearScan(const std::vector<TestDefinition>& definitions, const TestModule& module)
+{
+    std::vector<size_t> positions;
+    for (size_t i = 0; i < definitions.size(); i++)
+    {
+        const auto& definition = definitions[i];
+        if (definition.is_derived)
+        {
+            auto matches = [&definition](const shared::WSTRING& name, const Version& version) {
+                return name == definition.assembly_name && definition.min_version <= version &&
+                       definition.max_version >= version;
+            };
+
+            auto found = matches(module.assembly_name, module.version);
+            for (const auto& reference : module.references)
+            {
+                found = found || matches(reference.first, reference.second);
+            }
+
+            if (found)
+            {
+                positions.push_back(i);
+            }
+        }
+        else if ((definition.assembly_name == tracemethodintegration_assemblyname ||
+                  definition.assembly_name == module.assembly_name) &&
+                 definition.min_version <= module.version && definition.max_version >= module.version)
+        {
+            positions.push_back(i);
+        }
+    }
+
+    return positions;
+}
+
+std::vector<size_t> IndexLookup(const RejitDefinitionIndex& index, const TestModule& module)
+{
+    std::vector<size_t> positions;
+    if (!index.MayMatch(module.assembly_name))
+    {
+        return positions;
+    }
+
+    index.GetDefinitions(module.assembly_name, module.version, positions);
+    if (index.HasDerivedDefinitions())
+    {
+        index.GetDerivedDefinitions(module.assembly_name, module.version, positions);
+        for (const auto& reference : module.references)
+        {
+            index.GetDerivedDefinitions(reference.first, reference.second, positions);
+        }
+    }
+
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+    return positions;
+}
+
+// Reads the calltarget definitions generated for the tracer (root and derived types of every category)
+std::vector<TestDefinition> ReadGeneratedDefinitions(const std::string& path)
+{
+    // new ("AssemblyName", "TypeName", "MethodName", new[] { ... }, minMajor, minMinor, minPatch, maxMajor, ...
+    static const std::regex definitionRegex(
+        R"regex(^\s*new \("([^"]+)",.*\}, (\d+), (\d+), (\d+), (\d+), (\d+), (\d+), assemblyFullName)regex");
+
+    std::vector<TestDefinition> definitions;
+    std::ifstream file(path);
+    std::string line;
+    bool isDerived = false;
+    while (std::getline(file, line))
+    {
+        if (line.find("// root types") != std::string::npos)
+        {
+            isDerived = false;
+        }
+        else if (line.find("// derived types") != std::string::npos)
+        {
+            isDerived = true;
+        }
+
+        std::smatch match;
+        if (std::regex_search(line, match, definitionRegex))
+        {
+            auto number = [&match](size_t i) { return static_cast<unsigned short>(std::stoul(match[i].str())); };
+            definitions.push_back({ToWString(match[1].str()), Version(number(2), number(3), number(4), 0),
+                                   Version(number(5), number(6), number(7), 0), isDerived});
+        }
+    }
+
+    return definitions;
+}
+
+RejitDefinitionIndex BuildIndex(const std::vector<TestDefinition>& definitions)
+{
+    RejitDefinitionIndex index;
+    for (const auto& definition : definitions)
+    {
+        index.Add(definition.assembly_name, definition.min_version, definition.max_version, definition.is_derived);
+    }
+
+    return index;
+}
+} // namespace
+
+TEST(RejitDefinitionIndexTest, SelectsDefinitionsByAssemblyAndVersion)
+{
+    const std::vector<TestDefinition> definitions = {
+        {WStr("Npgsql"), Version(4, 0, 0, 0), Version(6, 65535, 65535, 0), false},
+        {WStr("System.Data"), Version(4, 0, 0, 0), Version(4, 65535, 65535, 0), false},
+        {WStr("Npgsql"), Version(1, 0, 0, 0), Version(3, 65535, 65535, 0), false},
+        {WStr("System.Data.Common"), Version(4, 0, 0, 0), Version(6, 65535, 65535, 0), true},
+        {WStr("Npgsql"), Version(4, 0, 0, 0), Version(4, 1, 0, 0), false},
+    };
+
+    const auto index = BuildIndex(definitions);
+    ASSERT_EQ(definitions.size(), index.Size());
+    ASSERT_TRUE(index.HasDerivedDefinitions());
+
+    std::vector<size_t> positions;
+    index.GetDefinitions(WStr("Npgsql"), Version(4, 0, 10, 0), positions);
+    ASSERT_EQ((std::vector<size_t>{0, 4}), positions);
+
+    positions.clear();
+    index.GetDefinitions(WStr("Npgsql"), Version(2, 0, 0, 0), positions);
+    ASSERT_EQ((std::vector<size_t>{2}), positions);
+
+    positions.clear();
+    index.GetDefinitions(WStr("Npgsql"), Version(7, 0, 0, 0), positions);
+    ASSERT_TRUE(positions.empty());
+
+    // derived definitions are only returned by GetDerivedDefinitions
+    positions.clear();
+    index.GetDefinitions(WStr("System.Data.Common"), Version(5, 0, 0, 0), positions);
+    ASSERT_TRUE(positions.empty());
+    index.GetDerivedDefinitions(WStr("System.Data.Common"), Version(5, 0, 0, 0), positions);
+    ASSERT_EQ((std::vector<size_t>{3}), positions);
+}
+
+TEST(RejitDefinitionIndexTest, RevisionIsIgnoredLikeVersionComparison)
+{
+    const auto index = BuildIndex({{WStr("Some.Assembly"), Version(1, 0, 0, 0), Version(1, 2, 3, 0), false}});
+
+    std::vector<size_t> positions;
+    index.GetDefinitions(WStr("Some.Assembly"), Version(1, 2, 3, 42), positions);
+    ASSERT_EQ((std::vector<size_t>{0}), positions);
+}
+
+TEST(RejitDefinitionIndexTest, TraceMethodsMatchAnyModule)
+{
+    const auto index = BuildIndex({
+        {WStr("Some.Assembly"), Version(1, 0, 0, 0), Version(1, 65535, 65535, 0), false},
+        {tracemethodintegration_assemblyname, Version(0, 0, 0, 0), Version(65535, 65535, 65535, 65535), false},
+    });
+
+    ASSERT_TRUE(index.MayMatch(WStr("Any.Assembly")));
+
+    std::vector<size_t> positions;
+    index.GetDefinitions(WStr("Any.Assembly"), Version(3, 0, 0, 0), positions);
+    ASSERT_EQ((std::vector<size_t>{1}), positions);
+}
+
+TEST(RejitDefinitionIndexTest, UnrelatedModulesAreSkipped)
+{
+    const auto index = BuildIndex({{WStr("Some.Assembly"), Version(1, 0, 0, 0), Version(1, 65535, 65535, 0), false}});
+
+    ASSERT_TRUE(index.MayMatch(WStr("Some.Assembly")));
+    ASSERT_FALSE(index.MayMatch(WStr("Other.Assembly")));
+    ASSERT_FALSE(index.HasDerivedDefinitions());
+}
+
+// Compares the index with the linear scan on a definitions list shaped like the generated one
+// (a few hundred definitions spread over ~100 assemblies) and thousands of synthetic modules.
+TEST(RejitDefinitionIndexTest, SelectsTheSameDefinitionsAsLinearScan)
+{
+    std::vector<TestDefinition> definitions;
+    for (int assembly = 0; assembly < 100; assembly++)
+    {
+        const auto name = ToWString("Integration.Target." + std::to_string(assembly));
+        for (unsigned short major = 1; major <= 4; major++)
+        {
+            definitions.push_back({name, Version(major, 0, 0, 0), Version(major, 65535, 65535, 0), false});
+        }
+
+        if (assembly % 10 == 0)
+        {
+            definitions.push_back({name, Version(1, 0, 0, 0), Version(9, 65535, 65535, 0), true});
+        }
+    }
+
+    std::vector<TestModule> modules;
+    for (int i = 0; i < 5000; i++)
+    {
+        // one module out of 20 is targeted by the integrations
+        const auto name = (i % 20 == 0) ? "Integration.Target." + std::to_string(i % 100)
+                                        : "Application.Module." + std::to_string(i);
+        const std::vector<std::pair<shared::WSTRING, Version>> references = {
+            {WStr("System.Runtime"), Version(6, 0, 0, 0)},
+            {ToWString("Integration.Target." + std::to_string(i % 30)), Version(2, 0, 0, 0)},
+        };
+
+        modules.push_back({ToWString(name), Version(static_cast<unsigned short>(i % 6), 1, 0, 0), references});
+    }
+
+    const auto index = BuildIndex(definitions);
+    for (const auto& module : modules)
+    {
+        // same definitions, in the same order
+        ASSERT_EQ(LinearScan(definitions, module), IndexLookup(index, module))
+            << shared::ToString(module.assembly_name);
+    }
+}
+
+// Opt-in benchmark (--gtest_also_run_disabled_tests): the generated integration list against thousands of
+// synthetic module names, with the index and with the linear scan done before it.
+TEST(RejitDefinitionIndexTest, DISABLED_BenchmarkGeneratedDefinitions)
+{
+    const std::string testDirectory = std::string(__FILE__).substr(0, std::string(__FILE__).find_last_of("/\\") + 1);
+    const auto definitions = ReadGeneratedDefinitions(
+        testDirectory +
+        "../../src/Datadog.Trace/Generated/net6.0/Datadog.Trace.SourceGenerators/"
+        "Datadog.Trace.SourceGenerators.InstrumentationDefinitions.InstrumentationDefinitionsGenerator/"
+        "InstrumentationDefinitions.g.cs");
+    ASSERT_FALSE(definitions.empty());
+
+    std::vector<shared::WSTRING> targets;
+    for (const auto& definition : definitions)
+    {
+        if (std::find(targets.begin(), targets.end(), definition.assembly_name) == targets.end())
+        {
+            targets.push_back(definition.assembly_name);
+        }
+    }
+
+    std::vector<TestModule> modules;
+    for (size_t i = 0; i < 10000; i++)
+    {
+        // one module out of 20 is targeted by the integrations, every module references another target
+        const auto name = (i % 20 == 0) ? targets[i % targets.size()]
+                                        : ToWString("Application.Module." + std::to_string(i));
+        const std::vector<std::pair<shared::WSTRING, Version>> references = {
+            {WStr("System.Runtime"), Version(6, 0, 0, 0)},
+            {targets[(i * 7) % targets.size()], Version(static_cast<unsigned short>(i % 8), 0, 0, 0)},
+        };
+
+        modules.push_back({name, Version(static_cast<unsigned short>(i % 8), 1, 0, 0), references});
+    }
+
+    const auto linearStart = std::chrono::steady_clock::now();
+    size_t linearCount = 0;
+    for (const auto& module : modules)
+    {
+        linearCount += LinearScan(definitions, module).size();
+    }
+    const auto linearDuration = std::chrono::steady_clock::now() - linearStart;
+
+    const auto indexStart = std::chrono::steady_clock::now();
+    const auto index = BuildIndex(definitions);
+    size_t indexCount = 0;
+    for (const auto& module : modules)
+    {
+        indexCount += IndexLookup(index, module).size();
+    }
+    const auto indexDuration = std::chrono::steady_clock::now() - indexStart;
+
+    ASSERT_EQ(linearCount, indexCount);
+
+    const auto linearUs = std::chrono::duration_cast<std::chrono::microseconds>(linearDuration).count();
+    const auto indexUs = std::chrono::duration_cast<std::chrono::microseconds>(indexDuration).count();
+    RecordProperty("LinearScanMicroseconds", std::to_string(linearUs));
+    RecordProperty("IndexMicroseconds", std::to_string(indexUs));
+    std::cout << "[ BENCHMARK] " << definitions.size() << " generated definitions (" << targets.size()
+              << " assemblies) x " << modules.size() << " modules, " << indexCount
+              << " matches: linear scan=" << linearUs << "us, index (build included)=" << indexUs << "us"
+              << std::endl;
+}
@@ -0,0 +1,342 @@
+#include "pch.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/rejit_work_offloader.h"
+
+using namespace trace;
+
+namespace
+{
+void Terminate(RejitWorkOffloader& offloader)
+{
+    offloader.Enqueue(RejitWorkItem::CreateTerminatingWorkItem());
+    offloader.WaitForTermination();
+}
+
+// Stands for the metadata scan of a module: one module out of 10 has methods to instrument
+void ScanModule(ModuleID module, std::vector<ModuleID>& modules, std::vector<mdMethodDef>& methodDefs)
+{
+    if (module % 10 == 0)
+    {
+        modules.push_back(module);
+        methodDefs.push_back(static_cast<mdMethodDef>(0x06000000 + module));
+        modules.push_back(module);
+        methodDefs.push_back(static_cast<mdMethodDef>(0x06000001 + module));
+    }
+}
+
+// Stands for the time spent reading the metadata of a module
+void SimulateMetadataScan(std::chrono::microseconds duration)
+{
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end)
+    {
+    }
+}
+
+// Startup burst: modules are loaded in bursts, each burst is scanned by one item of the offloader thread (as
+// RequestRejitForLoadedModules) and its methods reach the batching stage when ScanModules returns.
+// Returns the time (in microseconds) between the load of a targeted module and the request of its ReJIT,
+// for the first targetedCount targeted modules.
+std::vector<long long> MeasureTimeToInstrumented(size_t scanningThreads, size_t targetedCount)
+{
+    const size_t burstsCount = 8;
+    const size_t modulesPerBurst = 100;
+    const auto burstInterval = std::chrono::milliseconds(5);
+    const auto scanDuration = std::chrono::microseconds(100);
+
+    RejitWorkOffloader offloader(nullptr, scanningThreads);
+
+    std::mutex lock;
+    std::vector<long long> timesToInstrumented;
+
+    for (size_t burst = 0; burst < burstsCount; burst++)
+    {
+        std::vector<ModuleID> modules;
+        for (size_t i = 0; i < modulesPerBurst; i++)
+        {
+            modules.push_back(burst * modulesPerBurst + i);
+        }
+
+        const auto loadedAt = std::chrono::steady_clock::now();
+        offloader.Enqueue(std::make_unique<RejitWorkItem>([&offloader, &lock, &timesToInstrumented, modules, loadedAt,
+                                                           scanDuration]() {
+            std::vector<ModuleID> vtModules;
+            std::vector<mdMethodDef> vtMethodDefs;
+            offloader.ScanModules(
+                modules,
+                [scanDuration](ModuleID module, std::vector<ModuleID>& moduleIds,
+                               std::vector<mdMethodDef>& methodDefs) {
+                    SimulateMetadataScan(scanDuration);
+                    ScanModule(module, moduleIds, methodDefs);
+                },
+                vtModules, vtMethodDefs);
+
+            const auto requestedAt = std::chrono::steady_clock::now();
+            const auto elapsed =
+                std::chrono::duration_cast<std::chrono::microseconds>(requestedAt - loadedAt).count();
+
+            std::lock_guard<std::mutex> guard(lock);
+            for (size_t i = 0; i < vtModules.size(); i++)
+            {
+                // two methods per targeted module
+                if (i == 0 || vtModules[i] != vtModules[i - 1])
+                {
+                    timesToInstrumented.push_back(elapsed);
+                }
+            }
+        }));
+
+        std::this_thread::sleep_for(burstInterval);
+    }
+
+    Terminate(offloader);
+
+    if (timesToInstrumented.size() > targetedCount)
+    {
+        timesToInstrumented.resize(targetedCount);
+    }
+
+    return timesToInstrumented;
+}
+} // namespace
+
+TEST(RejitWorkOffloaderTest, RunOnScanningThreadsRunsEveryFunction)
+{
+    RejitWorkOffloader offloader(nullptr, 3);
+    ASSERT_EQ(3, offloader.GetScanningThreadsCount());
+
+    std::vector<int> results(100, 0);
+    std::vector<std::function<void()>> funcs;
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        funcs.push_back([&results, i]() { results[i] = static_cast<int>(i) * 2; });
+    }
+
+    // twice to check the threads are reused
+    for (int run = 0; run < 2; run++)
+    {
+        offloader.RunOnScanningThreads(funcs);
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            ASSERT_EQ(static_cast<int>(i) * 2, results[i]);
+            results[i] = 0;
+        }
+    }
+
+    Terminate(offloader);
+}
+
+TEST(RejitWorkOffloaderTest, RunsOnCallingThreadWithoutScanningThreads)
+{
+    RejitWorkOffloader offloader(nullptr, 0);
+    ASSERT_EQ(0, offloader.GetScanningThreadsCount());
+
+    const auto callingThread = std::this_thread::get_id();
+    std::atomic_uint otherThreads = {0};
+    std::vector<std::function<void()>> funcs(10, [callingThread, &otherThreads]() {
+        if (std::this_thread::get_id() != callingThread)
+        {
+            otherThreads++;
+        }
+    });
+
+    offloader.RunOnScanningThreads(funcs);
+    ASSERT_EQ(0, otherThreads.load());
+
+    Terminate(offloader);
+}
+
+TEST(RejitWorkOffloaderTest, RunsOnCallingThreadAfterTermination)
+{
+    RejitWorkOffloader offloader(nullptr, 2);
+    Terminate(offloader);
+
+    int count = 0;
+    std::vector<std::function<void()>> funcs(5, [&count]() { count++; });
+    offloader.RunOnScanningThreads(funcs);
+    ASSERT_EQ(5, count);
+}
+
+TEST(RejitWorkOffloaderTest, ScanModulesKeepsTheOrderOfTheSequentialScan)
+{
+    std::vector<ModuleID> modules;
+    for (ModuleID module = 0; module < 103; module++)
+    {
+        modules.push_back(module);
+    }
+
+    std::vector<ModuleID> sequentialModules;
+    std::vector<mdMethodDef> sequentialMethodDefs;
+    for (const auto module : modules)
+    {
+        ScanModule(module, sequentialModules, sequentialMethodDefs);
+    }
+
+    RejitWorkOffloader offloader(nullptr, RejitWorkOffloader::MaxScanningThreads);
+
+    std::vector<ModuleID> vtModules;
+    std::vector<mdMethodDef> vtMethodDefs;
+    std::atomic_uint otherThreads = {0};
+    const auto callingThread = std::this_thread::get_id();
+    offloader.ScanModules(
+        modules,
+        [callingThread, &otherThreads](ModuleID module, std::vector<ModuleID>& moduleIds,
+                                       std::vector<mdMethodDef>& methodDefs) {
+            if (std::this_thread::get_id() != callingThread)
+            {
+                otherThreads++;
+            }
+            ScanModule(module, moduleIds, methodDefs);
+        },
+        vtModules, vtMethodDefs);
+
+    Terminate(offloader);
+
+    ASSERT_EQ(modules.size(), otherThreads.load());
+    ASSERT_EQ(sequentialModules, vtModules);
+    ASSERT_EQ(sequentialMethodDefs, vtMethodDefs);
+}
+
+TEST(RejitWorkOffloaderTest, ScanModulesRunsOnCallingThreadForFewModules)
+{
+    RejitWorkOffloader offloader(nullptr, RejitWorkOffloader::MaxScanningThreads);
+
+    const auto callingThread = std::this_thread::get_id();
+    std::vector<ModuleID> modules(RejitWorkOffloader::MinModulesForParallelScan - 1, 10);
+    std::vector<ModuleID> vtModules;
+    std::vector<mdMethodDef> vtMethodDefs;
+    std::atomic_uint otherThreads = {0};
+    offloader.ScanModules(
+        modules,
+        [callingThread, &otherThreads](ModuleID module, std::vector<ModuleID>& moduleIds,
+                                       std::vector<mdMethodDef>& methodDefs) {
+            if (std::this_thread::get_id() != callingThread)
+            {
+                otherThreads++;
+            }
+            ScanModule(module, moduleIds, methodDefs);
+        },
+        vtModules, vtMethodDefs);
+
+    Terminate(offloader);
+
+    ASSERT_EQ(0, otherThreads.load());
+    ASSERT_EQ(modules.size() * 2, vtMethodDefs.size());
+}
+
+TEST(RejitWorkOffloaderTest, RunOnScanningThreadsCompletesWhileTerminating)
+{
+    for (int run = 0; run < 50; run++)
+    {
+        RejitWorkOffloader offloader(nullptr, 2);
+
+        std::atomic_uint count = {0};
+        std::thread scanning([&offloader, &count]() {
+            std::vector<std::function<void()>> funcs(20, [&count]() { count++; });
+            for (int i = 0; i < 10; i++)
+            {
+                offloader.RunOnScanningThreads(funcs);
+            }
+        });
+
+        Terminate(offloader);
+        scanning.join();
+
+        // every function ran, either on the scanning threads or on the calling thread after the termination
+        ASSERT_EQ(200, count.load());
+    }
+}
+
+TEST(RejitWorkOffloaderTest, ItemsWithADeadlineDoNotBlockTheOtherItems)
+{
+    RejitWorkOffloader offloader(nullptr, 0);
+
+    std::mutex lock;
+    std::condition_variable recorded;
+    std::vector<int> order;
+    auto record = [&lock, &recorded, &order](int value) {
+        return [&lock, &recorded, &order, value]() {
+            std::lock_guard<std::mutex> guard(lock);
+            order.push_back(value);
+            recorded.notify_all();
+        };
+    };
+    auto waitForCount = [&lock, &recorded, &order](size_t count) {
+        std::unique_lock<std::mutex> guard(lock);
+        return recorded.wait_for(guard, std::chrono::seconds(30), [&order, count]() { return order.size() >= count; });
+    };
+
+    // the deadlines are never reached during the test: these items only run when terminating
+    const auto now = std::chrono::steady_clock::now();
+    offloader.Enqueue(std::make_unique<RejitWorkItem>(record(5), now + std::chrono::hours(2)));
+    offloader.Enqueue(std::make_unique<RejitWorkItem>(record(4), now + std::chrono::hours(1)));
+
+    // due items run in deadline order, whatever the enqueuing order and the time the thread wakes up
+    offloader.Enqueue(std::make_unique<RejitWorkItem>(record(3), now + std::chrono::milliseconds(2)));
+    offloader.Enqueue(std::make_unique<RejitWorkItem>(record(2), now + std::chrono::milliseconds(1)));
+    ASSERT_TRUE(waitForCount(2));
+
+    // an item without deadline is not blocked by the waiting ones
+    offloader.Enqueue(std::make_unique<RejitWorkItem>(record(1)));
+    ASSERT_TRUE(waitForCount(3));
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        ASSERT_EQ(std::vector<int>({2, 3, 1}), order);
+    }
+
+    Terminate(offloader);
+
+    ASSERT_EQ(std::vector<int>({2, 3, 1, 4, 5}), order);
+}
+
+TEST(RejitWorkOffloaderTest, ItemsWithADeadlineRunBeforeTerminating)
+{
+    RejitWorkOffloader offloader(nullptr, 0);
+
+    std::atomic_uint count = {0};
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::hours(1);
+    offloader.Enqueue(std::make_unique<RejitWorkItem>([&count]() { count++; }, deadline));
+
+    Terminate(offloader);
+
+    ASSERT_EQ(1, count.load());
+}
+
+// Opt-in startup benchmark (--gtest_also_run_disabled_tests): time-to-instrumented of the first targeted modules
+// with the sequential scan and with the scanning threads.
+TEST(RejitWorkOffloaderTest, DISABLED_BenchmarkStartupTimeToInstrumented)
+{
+    const size_t targetedCount = 50;
+    auto report = [](const char* name, const std::vector<long long>& times) {
+        long long total = 0;
+        for (const auto time : times)
+        {
+            total += time;
+        }
+
+        const auto average = total / static_cast<long long>(times.size());
+        const auto last = times.back();
+        RecordProperty(std::string(name) + "AverageMicroseconds", std::to_string(average));
+        RecordProperty(std::string(name) + "LastMicroseconds", std::to_string(last));
+        std::cout << "[ BENCHMARK] " << name << ": first " << times.size()
+                  << " targeted modules instrumented after " << average << "us on average, " << last
+                  << "us for the last one" << std::endl;
+    };
+
+    const auto sequential = MeasureTimeToInstrumented(0, targetedCount);
+    const auto parallel = MeasureTimeToInstrumented(RejitWorkOffloader::MaxScanningThreads, targetedCount);
+
+    ASSERT_EQ(targetedCount, sequential.size());
+    ASSERT_EQ(targetedCount, parallel.size());
+
+    report("Sequential", sequential);
+    report("Parallel", parallel);
+}
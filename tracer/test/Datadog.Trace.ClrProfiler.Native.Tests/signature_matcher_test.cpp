@@ -0,0 +1,244 @@
+#include "pch.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/clr_helpers.h"
+#include "../../src/Datadog.Trace.ClrProfiler.Native/signature_matcher.h"
+
+using namespace trace;
+
+namespace
+{
+// Stands for the TypeRef/TypeDef tables of a module
+class TypeNamesStub
+{
+public:
+    std::unordered_map<mdToken, shared::WSTRING> m_names = {
+        {0x01000001, WStr("System.Uri")},
+        {0x01000002, WStr("System.Threading.CancellationToken")},
+        {0x01000003, WStr("System.Collections.Generic.List`1")},
+        {0x01000004, WStr("System.Collections.Generic.Dictionary`2")},
+        {0x02000002, WStr("System.Int32")},
+    };
+    size_t m_calls = 0;
+
+    shared::WSTRING Resolve(mdToken token)
+    {
+        m_calls++;
+        return m_names[token];
+    }
+};
+
+class Blob
+{
+public:
+    std::vector<COR_SIGNATURE> m_bytes;
+
+    Blob& Element(CorElementType elementType)
+    {
+        m_bytes.push_back(static_cast<COR_SIGNATURE>(elementType));
+        return *this;
+    }
+
+    Blob& Number(ULONG number)
+    {
+        m_bytes.push_back(static_cast<COR_SIGNATURE>(number));
+        return *this;
+    }
+
+    Blob& Token(CorElementType elementType, mdToken token)
+    {
+        Element(elementType);
+        COR_SIGNATURE buffer[4];
+        const auto size = CorSigCompressToken(token, buffer);
+        m_bytes.insert(m_bytes.end(), buffer, buffer + size);
+        return *this;
+    }
+};
+
+// Same names as GetSigTypeTokName, the type names being resolved by the stub
+shared::WSTRING GetTypeName(PCCOR_SIGNATURE& pbCur, TypeNamesStub& typeNames)
+{
+    static const std::unordered_map<COR_SIGNATURE, shared::WSTRING> elementNames = {
+        {ELEMENT_TYPE_BOOLEAN, SystemBoolean}, {ELEMENT_TYPE_U1, SystemByte},     {ELEMENT_TYPE_I4, SystemInt32},
+        {ELEMENT_TYPE_I8, SystemInt64},        {ELEMENT_TYPE_STRING, SystemString}, {ELEMENT_TYPE_OBJECT, SystemObject},
+    };
+
+    shared::WSTRING tokenName = shared::EmptyWStr;
+    bool ref_flag = false;
+    if (*pbCur == ELEMENT_TYPE_BYREF)
+    {
+        pbCur++;
+        ref_flag = true;
+    }
+
+    const auto elementName = elementNames.find(*pbCur);
+    if (elementName != elementNames.end())
+    {
+        tokenName = elementName->second;
+        pbCur++;
+    }
+    else if (*pbCur == ELEMENT_TYPE_CLASS || *pbCur == ELEMENT_TYPE_VALUETYPE)
+    {
+        pbCur++;
+        mdToken token;
+        pbCur += CorSigUncompressToken(pbCur, &token);
+        tokenName = typeNames.Resolve(token);
+    }
+    else if (*pbCur == ELEMENT_TYPE_SZARRAY)
+    {
+        pbCur++;
+        tokenName = GetTypeName(pbCur, typeNames) + WStr("[]");
+    }
+    else if (*pbCur == ELEMENT_TYPE_GENERICINST)
+    {
+        pbCur++;
+        tokenName = GetTypeName(pbCur, typeNames) + WStr("[");
+        ULONG num = 0;
+        pbCur += CorSigUncompressData(pbCur, &num);
+        for (ULONG i = 0; i < num; i++)
+        {
+            tokenName += GetTypeName(pbCur, typeNames);
+            if (i != num - 1)
+            {
+                tokenName += WStr(",");
+            }
+        }
+        tokenName += WStr("]");
+    }
+    else if (*pbCur == ELEMENT_TYPE_MVAR || *pbCur == ELEMENT_TYPE_VAR)
+    {
+        tokenName = *pbCur == ELEMENT_TYPE_MVAR ? WStr("!!") : WStr("!");
+        pbCur++;
+        ULONG num = 0;
+        pbCur += CorSigUncompressData(pbCur, &num);
+        tokenName += shared::ToWSTRING(std::to_string(num));
+    }
+
+    if (ref_flag)
+    {
+        tokenName += WStr("&");
+    }
+    return tokenName;
+}
+
+std::vector<Blob> ArgumentBlobs()
+{
+    return {
+        Blob().Element(ELEMENT_TYPE_I4),
+        Blob().Element(ELEMENT_TYPE_STRING),
+        Blob().Element(ELEMENT_TYPE_OBJECT),
+        Blob().Token(ELEMENT_TYPE_CLASS, 0x01000001),
+        Blob().Token(ELEMENT_TYPE_VALUETYPE, 0x01000002),
+        Blob().Token(ELEMENT_TYPE_VALUETYPE, 0x02000002),
+        Blob().Element(ELEMENT_TYPE_BYREF).Element(ELEMENT_TYPE_I4),
+        Blob().Element(ELEMENT_TYPE_BYREF).Token(ELEMENT_TYPE_CLASS, 0x01000001),
+        Blob().Element(ELEMENT_TYPE_SZARRAY).Element(ELEMENT_TYPE_U1),
+        Blob().Element(ELEMENT_TYPE_SZARRAY).Element(ELEMENT_TYPE_SZARRAY).Element(ELEMENT_TYPE_STRING),
+        Blob().Element(ELEMENT_TYPE_GENERICINST).Token(ELEMENT_TYPE_CLASS, 0x01000003).Number(1).Element(
+            ELEMENT_TYPE_STRING),
+        Blob()
+            .Element(ELEMENT_TYPE_GENERICINST)
+            .Token(ELEMENT_TYPE_CLASS, 0x01000004)
+            .Number(2)
+            .Element(ELEMENT_TYPE_STRING)
+            .Element(ELEMENT_TYPE_GENERICINST)
+            .Token(ELEMENT_TYPE_CLASS, 0x01000003)
+            .Number(1)
+            .Element(ELEMENT_TYPE_I4),
+        Blob().Element(ELEMENT_TYPE_SZARRAY).Element(ELEMENT_TYPE_GENERICINST).Token(ELEMENT_TYPE_CLASS, 0x01000003)
+            .Number(1).Element(ELEMENT_TYPE_OBJECT),
+        Blob().Element(ELEMENT_TYPE_MVAR).Number(0),
+        Blob().Element(ELEMENT_TYPE_VAR).Number(1),
+        Blob().Element(ELEMENT_TYPE_BYREF).Element(ELEMENT_TYPE_MVAR).Number(2),
+    };
+}
+
+shared::WSTRING GetTypeName(const Blob& blob, TypeNamesStub& typeNames)
+{
+    PCCOR_SIGNATURE pbCur = blob.m_bytes.data();
+    return GetTypeName(pbCur, typeNames);
+}
+} // namespace
+
+TEST(SignatureMatcherTest, MatchesLikeTheTypeNames)
+{
+    TypeNamesStub typeNames;
+    SignatureMatcher matcher([&typeNames](mdToken token) { return typeNames.Resolve(token); });
+
+    const auto blobs = ArgumentBlobs();
+
+    // every name of the blobs, and names close to them
+    std::vector<shared::WSTRING> names = {WStr("System.Int32&&"), WStr("System.Collections.Generic.List`1"),
+                                          WStr("System.Collections.Generic.List`1[]"), WStr("!!00"), WStr("!!"),
+                                          WStr("System.Collections.Generic.Dictionary`2[System.String]"),
+                                          WStr("System.Byte[][]"), WStr("[System.String]"), WStr("&")};
+    for (const auto& blob : blobs)
+    {
+        names.push_back(GetTypeName(blob, typeNames));
+    }
+
+    // return type and expected argument, they must outlive the matcher
+    std::vector<std::vector<shared::WSTRING>> signatures;
+    for (const auto& name : names)
+    {
+        signatures.push_back({WStr("System.Void"), name});
+    }
+
+    for (const auto& signatureTypes : signatures)
+    {
+        const auto& name = signatureTypes[1];
+        const auto& compiled = matcher.Compile(signatureTypes);
+
+        for (const auto& blob : blobs)
+        {
+            const auto expected =
+                GetTypeName(blob, typeNames) == name ? SignatureMatch::Match : SignatureMatch::Mismatch;
+            ASSERT_EQ(expected, matcher.MatchArgument(compiled, 0, blob.m_bytes.data()))
+                << shared::ToString(name) << " / " << shared::ToString(GetTypeName(blob, typeNames));
+        }
+    }
+}
+
+TEST(SignatureMatcherTest, WildcardsAndUnknownElementTypes)
+{
+    TypeNamesStub typeNames;
+    SignatureMatcher matcher([&typeNames](mdToken token) { return typeNames.Resolve(token); });
+
+    const std::vector<shared::WSTRING> signatureTypes = {WStr("System.Void"), WStr("_"), WStr("System.Int32")};
+    const auto& compiled = matcher.Compile(signatureTypes);
+
+    // compiled once
+    ASSERT_EQ(&compiled, &matcher.Compile(signatureTypes));
+
+    const auto uri = Blob().Token(ELEMENT_TYPE_CLASS, 0x01000001);
+    ASSERT_EQ(SignatureMatch::Match, matcher.MatchArgument(compiled, 0, uri.m_bytes.data()));
+    ASSERT_EQ(SignatureMatch::Mismatch, matcher.MatchArgument(compiled, 1, uri.m_bytes.data()));
+
+    // pointers are not compiled: the type names are compared instead
+    const auto pointer = Blob().Element(ELEMENT_TYPE_PTR).Element(ELEMENT_TYPE_I4);
+    ASSERT_EQ(SignatureMatch::Unknown, matcher.MatchArgument(compiled, 1, pointer.m_bytes.data()));
+    ASSERT_EQ(SignatureMatch::Unknown, matcher.MatchArgument(compiled, 2, uri.m_bytes.data()));
+}
+
+TEST(SignatureMatcherTest, TokensAreResolvedOncePerModule)
+{
+    TypeNamesStub typeNames;
+    SignatureMatcher matcher([&typeNames](mdToken token) { return typeNames.Resolve(token); });
+
+    const std::vector<shared::WSTRING> signatureTypes = {WStr("System.Void"), WStr("System.Uri")};
+    const auto& compiled = matcher.Compile(signatureTypes);
+
+    const auto uri = Blob().Token(ELEMENT_TYPE_CLASS, 0x01000001);
+    const auto token = Blob().Token(ELEMENT_TYPE_VALUETYPE, 0x01000002);
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(SignatureMatch::Match, matcher.MatchArgument(compiled, 0, uri.m_bytes.data()));
+        ASSERT_EQ(SignatureMatch::Mismatch, matcher.MatchArgument(compiled, 0, token.m_bytes.data()));
+    }
+
+    ASSERT_EQ(2, typeNames.m_calls);
+    ASSERT_EQ(2, matcher.GetResolvedTokensCount());
+}
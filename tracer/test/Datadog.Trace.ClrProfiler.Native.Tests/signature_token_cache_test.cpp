@@ -0,0 +1,105 @@
+#include "pch.h"
+
+#include <vector>
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/signature_token_cache.h"
+#include "../../../shared/src/native-src/string.h"
+
+using namespace trace;
+
+namespace
+{
+// Stands for IMetaDataEmit: defines a new token on each call
+class EmitStub
+{
+public:
+    unsigned m_calls = 0;
+    HRESULT m_result = S_OK;
+
+    HRESULT Define(mdToken* token)
+    {
+        m_calls++;
+        *token = 0x2B000001 + m_calls;
+        return m_result;
+    }
+};
+
+std::vector<COR_SIGNATURE> MethodSpecSignature(mdToken integrationType, unsigned arity)
+{
+    std::vector<COR_SIGNATURE> signature = {IMAGE_CEE_CS_CALLCONV_GENERICINST, static_cast<COR_SIGNATURE>(arity)};
+    for (unsigned i = 0; i < arity; i++)
+    {
+        signature.push_back(ELEMENT_TYPE_CLASS);
+        signature.push_back(static_cast<COR_SIGNATURE>(integrationType & 0x7F));
+    }
+    return signature;
+}
+} // namespace
+
+TEST(SignatureTokenCacheTest, ReusesTokensOfTheSameSignature)
+{
+    SignatureTokenCache cache;
+    EmitStub emit;
+    auto define = [&emit](mdToken* token) { return emit.Define(token); };
+
+    const auto signature = MethodSpecSignature(0x01000002, 2);
+
+    mdToken first = mdTokenNil;
+    ASSERT_EQ(S_OK, cache.GetOrDefine(SignatureTokenKind::MethodSpec, 0x0A000001, nullptr, signature.data(),
+                                      static_cast<ULONG>(signature.size()), &first, define));
+    mdToken second = mdTokenNil;
+    ASSERT_EQ(S_OK, cache.GetOrDefine(SignatureTokenKind::MethodSpec, 0x0A000001, nullptr, signature.data(),
+                                      static_cast<ULONG>(signature.size()), &second, define));
+
+    ASSERT_EQ(1, emit.m_calls);
+    ASSERT_EQ(first, second);
+    ASSERT_EQ(1, cache.Size());
+}
+
+TEST(SignatureTokenCacheTest, KeyIncludesKindParentNameAndArity)
+{
+    SignatureTokenCache cache;
+    EmitStub emit;
+    auto define = [&emit](mdToken* token) { return emit.Define(token); };
+
+    const auto signature = MethodSpecSignature(0x01000002, 2);
+    const auto otherArity = MethodSpecSignature(0x01000002, 3);
+    const auto length = static_cast<ULONG>(signature.size());
+
+    mdToken token;
+    cache.GetOrDefine(SignatureTokenKind::MethodSpec, 0x0A000001, nullptr, signature.data(), length, &token, define);
+    cache.GetOrDefine(SignatureTokenKind::MethodSpec, 0x0A000002, nullptr, signature.data(), length, &token, define);
+    cache.GetOrDefine(SignatureTokenKind::MemberRef, 0x0A000001, nullptr, signature.data(), length, &token, define);
+    cache.GetOrDefine(SignatureTokenKind::MemberRef, 0x0A000001, WStr("BeginMethod"), signature.data(), length,
+                      &token, define);
+    cache.GetOrDefine(SignatureTokenKind::MemberRef, 0x0A000001, WStr("EndMethod"), signature.data(), length, &token,
+                      define);
+    cache.GetOrDefine(SignatureTokenKind::MethodSpec, 0x0A000001, nullptr, otherArity.data(),
+                      static_cast<ULONG>(otherArity.size()), &token, define);
+
+    ASSERT_EQ(6, emit.m_calls);
+    ASSERT_EQ(6, cache.Size());
+}
+
+TEST(SignatureTokenCacheTest, FailuresAreNotCached)
+{
+    SignatureTokenCache cache;
+    EmitStub emit;
+    auto define = [&emit](mdToken* token) { return emit.Define(token); };
+
+    const auto signature = MethodSpecSignature(0x01000002, 1);
+    const auto length = static_cast<ULONG>(signature.size());
+
+    mdToken token;
+    emit.m_result = E_FAIL;
+    ASSERT_EQ(E_FAIL,
+              cache.GetOrDefine(SignatureTokenKind::TypeSpec, mdTokenNil, nullptr, signature.data(), length, &token,
+                                define));
+    ASSERT_EQ(0, cache.Size());
+
+    emit.m_result = S_OK;
+    ASSERT_EQ(S_OK, cache.GetOrDefine(SignatureTokenKind::TypeSpec, mdTokenNil, nullptr, signature.data(), length,
+                                      &token, define));
+    ASSERT_EQ(2, emit.m_calls);
+    ASSERT_EQ(1, cache.Size());
+}
@@ -0,0 +1,82 @@
+// <copyright file="ProfilerEndpointTests.cs" company="Datadog">
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2017 Datadog, Inc.
+// </copyright>
+
+using System;
+using Datadog.Trace.Agent;
+using Datadog.Trace.Configuration;
+using Datadog.Trace.ContinuousProfiler;
+using Datadog.Trace.Sampling;
+using Moq;
+using Xunit;
+
+namespace Datadog.Trace.Tests.ContinuousProfiler
+{
+    [Collection(nameof(TracerInstanceTestCollection))]
+    public class ProfilerEndpointTests : IDisposable
+    {
+        private readonly Profiler _previousProfiler;
+        private readonly Mock<IContextTracker> _contextTracker;
+        private readonly Tracer _tracer;
+
+        public ProfilerEndpointTests()
+        {
+            _previousProfiler = Profiler.Instance;
+
+            var status = new Mock<IProfilerStatus>();
+            status.Setup(s => s.IsProfilerReady).Returns(true);
+            _contextTracker = new Mock<IContextTracker>();
+            _contextTracker.Setup(c => c.IsEnabled).Returns(true);
+            Profiler.SetInstanceOnlyForTests(new Profiler(_contextTracker.Object, status.Object));
+
+            // the scope manager listens to the scope changes only when the profiler is enabled at creation time
+            _tracer = new Tracer(new TracerSettings(), Mock.Of<IAgentWriter>(), Mock.Of<ISampler>(), scopeManager: null, statsd: null);
+        }
+
+        public void Dispose()
+        {
+            Profiler.SetInstanceOnlyForTests(_previousProfiler);
+        }
+
+        [Fact]
+        public void EndpointIsUpdatedWhenTheRootSpanResourceIsSetAfterActivation()
+        {
+            using var scope = _tracer.StartActiveInternal("aspnet_core.request");
+            var rootSpan = scope.Span;
+
+            _contextTracker.Verify(c => c.Set(rootSpan.SpanId, rootSpan.SpanId, null), Times.Once);
+
+            // the route is resolved once the request span is already active
+            rootSpan.ResourceName = "GET /api/values/{id}";
+
+            _contextTracker.Verify(c => c.SetEndpoint(rootSpan.SpanId, "GET /api/values/{id}"), Times.Once);
+        }
+
+        [Fact]
+        public void ChildSpansUseTheResourceOfTheRootSpan()
+        {
+            using var rootScope = _tracer.StartActiveInternal("aspnet_core.request");
+            var rootSpan = rootScope.Span;
+            rootSpan.ResourceName = "GET /api/orders";
+
+            using var childScope = _tracer.StartActiveInternal("http.request");
+            var childSpan = childScope.Span;
+            childSpan.ResourceName = "GET /downstream";
+
+            _contextTracker.Verify(c => c.Set(rootSpan.SpanId, childSpan.SpanId, "GET /api/orders"), Times.Once);
+            _contextTracker.Verify(c => c.SetEndpoint(It.IsAny<ulong>(), "GET /downstream"), Times.Never);
+        }
+
+        [Fact]
+        public void EndpointIsUpdatedWhenTheRootSpanFinishesWithoutResource()
+        {
+            var rootSpan = _tracer.StartSpan("custom.operation");
+
+            rootSpan.Finish();
+
+            // the operation name is the default resource name
+            _contextTracker.Verify(c => c.SetEndpoint(rootSpan.SpanId, "custom.operation"), Times.Once);
+        }
+    }
+}